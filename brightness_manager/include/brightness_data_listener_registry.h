@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRIGHTNESS_DATA_LISTENER_REGISTRY_H
+#define BRIGHTNESS_DATA_LISTENER_REGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <iremote_object.h>
+
+#include "display_power_info.h"
+#include "ffrt_utils.h"
+#include "idisplay_brightness_listener.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Data change listeners of the open build, keyed by listener type and caller id. A caller may ask for a minimum
+// interval between two deliveries in params, e.g. {"minIntervalMs":200}. Changes published meanwhile are coalesced
+// to the latest value of each display and field, and delivered together as one JSON batch:
+// {"type":3,"events":[{"displayId":0,"name":"brightness","value":120,"timeMs":12345}]}
+class BrightnessDataListenerRegistry {
+public:
+    static constexpr const char* FIELD_BRIGHTNESS = "brightness";
+    static constexpr const char* FIELD_LUX = "lux";
+
+    static BrightnessDataListenerRegistry& Get();
+
+    // Replaces the listener registered before with the same type and caller id
+    int32_t Register(const sptr<IDisplayBrightnessListener>& listener, DisplayDataChangeListenerType type,
+        const std::string& callerId, const std::string& params);
+    int32_t Unregister(DisplayDataChangeListenerType type, const std::string& callerId);
+    void RemoveAll(const sptr<IRemoteObject>& remote);
+    // Cheap when no listener of type is registered, which is the common case
+    void Publish(DisplayDataChangeListenerType type, uint32_t displayId, const char* name, double value);
+    void Dump(std::string& result) const;
+
+private:
+    static constexpr uint32_t DEFAULT_MIN_INTERVAL_MS = 16;
+    static constexpr uint32_t MAX_MIN_INTERVAL_MS = 10000;
+    static constexpr size_t MAX_LISTENERS = 64;
+
+    struct Event {
+        double value {0.0};
+        int64_t timeMs {0};
+    };
+
+    struct Listener {
+        sptr<IDisplayBrightnessListener> listener;
+        sptr<IRemoteObject::DeathRecipient> deathRecipient;
+        DisplayDataChangeListenerType type {DisplayDataChangeListenerType::DEFAULT};
+        std::string callerId;
+        uint32_t minIntervalMs {DEFAULT_MIN_INTERVAL_MS};
+        // Serializes the deliveries of this listener only, so that a slow one does not delay the others
+        std::shared_ptr<PowerMgr::FFRTQueue> queue;
+        std::mutex mutex;  // Protects the members below
+        std::map<std::pair<uint32_t, std::string>, Event> pending;  // Keyed by display id and field
+        bool isScheduled {false};
+        bool isRemoved {false};
+        int64_t lastDeliveryMs {0};
+        uint64_t published {0};
+        uint64_t batches {0};
+    };
+    using ListenerKey = std::pair<DisplayDataChangeListenerType, std::string>;
+
+    class ListenerDeathRecipient : public IRemoteObject::DeathRecipient {
+    public:
+        void OnRemoteDied(const wptr<IRemoteObject>& remote) override;
+    };
+
+    BrightnessDataListenerRegistry() = default;
+    static uint32_t ParseMinInterval(const std::string& params);
+    static std::string MakeBatch(DisplayDataChangeListenerType type,
+        const std::map<std::pair<uint32_t, std::string>, Event>& events);
+    static int64_t GetNowMs();
+    static void Post(const std::shared_ptr<Listener>& listener, uint32_t displayId, const char* name, double value);
+    static void Deliver(const std::shared_ptr<Listener>& listener);
+    void DetachLocked(std::map<ListenerKey, std::shared_ptr<Listener>>::iterator iter);
+    void UpdateActiveTypesLocked();
+
+    mutable std::mutex mMutex;
+    std::map<ListenerKey, std::shared_ptr<Listener>> mListeners;
+    // Bit per listener type that has at least one listener, read by Publish without the lock
+    std::atomic<uint32_t> mActiveTypes {0};
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // BRIGHTNESS_DATA_LISTENER_REGISTRY_H
@@ -61,6 +61,8 @@ private:
     std::atomic_uint32_t mCurrentBrightness{};
     std::atomic_uint32_t mCurrentStep{};
     std::shared_ptr<PowerMgr::FFRTQueue> mQueue;
+    // Per instance, so that the animators of different displays do not cancel each other
+    PowerMgr::FFRTHandle mAnimatorTaskHandle{};
     std::mutex mAnimatorHandleLock{};
     mutable ffrt::mutex mLock;
     mutable ffrt::condition_variable mCondDimmingDone;
@@ -66,6 +66,40 @@ public:
     bool SetMaxBrightnessNit(uint32_t nit);
     int NotifyScreenPowerStatus(uint32_t displayId, uint32_t status);
     bool SetSceneMode(SceneModeType type, bool enable);
+    // Observes changes of the published state of every display, see GetDisplayPublishedState. Returns false
+    // when the brightness wrapper is in use, whose writes cannot be observed.
+    bool SetChangeObserver(std::function<void()> observer);
+    // Never blocks on a brightness pipeline or an IPC. With the brightness wrapper the levels are not valid.
+    BrightnessService::PublishedState GetDisplayPublishedState(uint32_t displayId);
+    // Reports a setting brightness written outside the brightness service, e.g. by the settings app
+    void SetObservedSettingBrightness(uint32_t value);
+    // Observes the lux estimates of the built-in brightness service: isValid, lux, filtered lux and smoothed lux.
+    // Returns false when the brightness wrapper is in use.
+    bool SetLuxObserver(std::function<void(bool, float, float, float)> luxObserver);
+    // Device brightness writes between these calls are collapsed into one write at EndBrightnessBatch.
+    // With the brightness wrapper every write is applied immediately.
+    void BeginBrightnessBatch();
+    bool EndBrightnessBatch();
+    // Gives displayId a brightness pipeline of its own instead of the default one. Not supported with
+    // the brightness wrapper, which drives all displays itself.
+    bool AddDisplayPipeline(uint32_t displayId);
+    void RemoveDisplayPipeline(uint32_t displayId);
+    // Brightness of displayId, on its own pipeline if it has one and on the default pipeline otherwise
+    bool SetDisplayBrightness(uint32_t displayId, uint32_t value, uint32_t gradualDuration = 0,
+        bool continuous = false);
+    bool DiscountDisplayBrightness(uint32_t displayId, double discount);
+    uint32_t GetDisplayBrightness(uint32_t displayId);
+    uint32_t GetDisplayDeviceBrightness(uint32_t displayId, bool useHbm = false);
+    bool OverrideDisplayBrightness(uint32_t displayId, uint32_t value, uint32_t gradualDuration = 0);
+    bool RestoreDisplayBrightness(uint32_t displayId, uint32_t gradualDuration = 0);
+    bool BoostDisplayBrightness(uint32_t displayId, uint32_t timeoutMs, uint32_t gradualDuration = 0);
+    bool CancelBoostDisplayBrightness(uint32_t displayId, uint32_t gradualDuration = 0);
+    void SetDisplayScreenOnBrightness(uint32_t displayId);
+    uint32_t GetDisplayScreenOnBrightness(uint32_t displayId);
+    DisplayState GetDisplayState(uint32_t displayId);
+    double GetDisplayDiscount(uint32_t displayId);
+    bool IsDisplayBrightnessOverridden(uint32_t displayId);
+    bool IsDisplayBrightnessBoosted(uint32_t displayId);
 
 private:
     BrightnessManager() = default;
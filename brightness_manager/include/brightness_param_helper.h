@@ -16,6 +16,7 @@
 #ifndef BRIGHTNESS_PARAM_HELPER_H
 #define BRIGHTNESS_PARAM_HELPER_H
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
@@ -32,10 +33,14 @@ public:
     static uint32_t GetSleepBrightness();
     static uint32_t GetSleepMinumumReductionBrightness();
     static uint32_t GetSleepDarkenTime();
+    // Drop the cached values so that the next Get reads the parameters again
+    static void InvalidateCache();
     typedef void (* BootCompletedCallback)();
     static void RegisterBootCompletedCallback(BootCompletedCallback&);
 
 private:
+    static uint32_t GetCachedIntValue(std::atomic<int64_t>& cache, const char* key, int32_t def);
+
     static constexpr const char* KEY_DEFAULT_BRIGHTNESS {"const.display.brightness.default"};
     static constexpr const char* KEY_MAX_BRIGHTNESS {"const.display.brightness.max"};
     static constexpr const char* KEY_MIN_BRIGHTNESS {"const.display.brightness.min"};
@@ -48,6 +53,13 @@ private:
     static constexpr uint32_t BRIGHTNESS_SLEEP = 10;
     static constexpr uint32_t BRIGHTNESS_SLEEP_MINUMUM_REDUCTION = 10;
     static constexpr uint32_t BRIGHTNESS_SLEEP_DARKEN_TIME = 1000;
+    static constexpr int64_t PARAM_NOT_CACHED = -1;
+    static inline std::atomic<int64_t> mDefaultBrightness{PARAM_NOT_CACHED};
+    static inline std::atomic<int64_t> mMaxBrightness{PARAM_NOT_CACHED};
+    static inline std::atomic<int64_t> mMinBrightness{PARAM_NOT_CACHED};
+    static inline std::atomic<int64_t> mSleepBrightness{PARAM_NOT_CACHED};
+    static inline std::atomic<int64_t> mSleepMinumumReductionBrightness{PARAM_NOT_CACHED};
+    static inline std::atomic<int64_t> mSleepDarkenTime{PARAM_NOT_CACHED};
 };
 } // namespace DisplayPowerMgr
 } // namespace OHOS
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRIGHTNESS_PIPELINE_REGISTRY_H
+#define BRIGHTNESS_PIPELINE_REGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "brightness_service.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Brightness pipelines of the displays that are not driven by the default pipeline, keyed by display id.
+// Secondary pipelines are manual only: they have no ambient light sensor and do not persist their level.
+class BrightnessPipelineRegistry {
+public:
+    static BrightnessPipelineRegistry& Get();
+
+    // Creates and initializes the pipeline of displayId, or reattaches the one created before
+    std::shared_ptr<BrightnessService> Add(uint32_t displayId);
+    // Turns the pipeline off and detaches it, so that displayId falls back to the default pipeline
+    bool Remove(uint32_t displayId);
+    // Returns nullptr if displayId has no pipeline of its own
+    std::shared_ptr<BrightnessService> Find(uint32_t displayId) const;
+    // Own pipeline of displayId, or the default pipeline
+    BrightnessService& Resolve(uint32_t displayId, std::shared_ptr<BrightnessService>& holder) const;
+    std::vector<uint32_t> GetDisplayIds() const;
+
+private:
+    struct Slot {
+        std::shared_ptr<BrightnessService> pipeline;
+        bool attached {false};
+    };
+
+    BrightnessPipelineRegistry() = default;
+    // Both panels of a foldable belong to the default pipeline, whichever of them is on at the moment
+    static bool IsDefaultPipelineDisplay(uint32_t displayId);
+
+    mutable std::mutex mMutex;
+    // Pipelines are kept once created, tasks already queued by a detached pipeline may still reference it
+    std::map<uint32_t, Slot> mSlots;
+    // Lets lookups skip the lock while no display has its own pipeline, which is the common case
+    std::atomic<uint32_t> mAttachedCount {0};
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // BRIGHTNESS_PIPELINE_REGISTRY_H
@@ -29,6 +29,7 @@
 #include "brightness_dimming.h"
 #include "brightness_base.h"
 #include "brightness_param_helper.h"
+#include "brightness_strand.h"
 #include "calculation_manager.h"
 #include "display_common.h"
 #include "display_power_info.h"
@@ -48,11 +49,19 @@
 
 namespace OHOS {
 namespace DisplayPowerMgr {
+class BrightnessPipelineRegistry;
+
+// Brightness pipeline of a display: state, lux filter, curve and animator. Get() returns the default
+// pipeline, which owns the ambient light sensors and the persisted brightness setting. Displays with
+// their own pipeline are created through BrightnessPipelineRegistry.
+// The pipeline state is only changed on its strand. Binder calls, sensor reports, fold events and
+// dimming steps are all funneled through it, and getters called off the strand read the snapshot
+// published after each change instead of waiting for it.
 class BrightnessService {
 public:
     class DimmingCallbackImpl : public BrightnessDimmingCallback {
     public:
-        DimmingCallbackImpl(const std::shared_ptr<BrightnessAction>& action,
+        DimmingCallbackImpl(BrightnessService& owner, const std::shared_ptr<BrightnessAction>& action,
             std::function<void(uint32_t)> callback);
         ~DimmingCallbackImpl() override = default;
         DimmingCallbackImpl(const DimmingCallbackImpl&) = delete;
@@ -66,6 +75,7 @@ public:
         void DiscountBrightness(double discount) override;
 
     private:
+        BrightnessService& mOwner;
         const std::shared_ptr<BrightnessAction> mAction{};
         std::function<void(uint32_t)> mCallback{};
         double mDiscount{1.0};
@@ -87,12 +97,58 @@ public:
         void OnFoldStatusChanged(Rosen::FoldStatus foldStatus) override;
 
     private:
+        void HandleFoldStatusChanged(Rosen::FoldStatus foldStatus);
         Rosen::FoldStatus mLastFoldStatus = Rosen::FoldStatus::UNKNOWN;
     };
 
+    class DisplayModeListener : public Rosen::DisplayManagerLite::IDisplayModeListener {
+    public:
+        DisplayModeListener() = default;
+        virtual ~DisplayModeListener() = default;
+
+        DisplayModeListener(const DisplayModeListener&) = delete;
+        DisplayModeListener& operator=(const DisplayModeListener&) = delete;
+        DisplayModeListener(DisplayModeListener&&) = delete;
+        DisplayModeListener& operator=(DisplayModeListener&&) = delete;
+
+        void OnDisplayModeChanged(Rosen::FoldDisplayMode displayMode) override;
+    };
+
     static constexpr const char* SETTING_AUTO_ADJUST_BRIGHTNESS_KEY {"settings.display.auto_screen_brightness"};
     static const int LUX_LEVEL_LENGTH = 23;
 
+    // Copy of the strand-owned state, as of the end of the last strand task
+    struct StateSnapshot {
+        DisplayState state{DisplayState::DISPLAY_UNKNOWN};
+        uint32_t displayId{0};
+        uint32_t currentSensorId{0};
+        uint32_t brightnessLevel{0};
+        uint32_t brightnessTarget{0};
+        uint32_t cachedSettingBrightness{0};
+        uint32_t overriddenBrightness{0};
+        int luxLevel{-1};
+        double discount{1.0};
+        bool isSupportLightSensor{false};
+        bool isAutoBrightnessEnabled{false};
+        bool isBrightnessOverridden{false};
+        bool isBrightnessBoosted{false};
+        bool isSleepStatus{false};
+        bool isUserMode{false};
+    };
+
+    // What clients see of a pipeline through the power snapshot, read without blocking on the strand or an IPC
+    struct PublishedState {
+        uint32_t settingBrightness{0};
+        uint32_t deviceBrightness{0};
+        uint32_t deviceBrightnessHbm{0};
+        double discount{1.0};
+        bool isSettingBrightnessValid{false};
+        bool isDeviceBrightnessValid{false};
+        bool isAutoBrightnessEnabled{false};
+        bool isBrightnessOverridden{false};
+        bool isBrightnessBoosted{false};
+    };
+
     BrightnessService(const BrightnessService&) = delete;
     BrightnessService& operator=(const BrightnessService&) = delete;
     BrightnessService(BrightnessService&&) = delete;
@@ -143,6 +199,7 @@ public:
     void UpdateBrightnessSceneMode(BrightnessSceneMode mode);
     uint32_t GetDisplayId();
     void SetDisplayId(uint32_t displayId);
+    bool IsDefaultPipeline() const;
     uint32_t SetLightBrightnessThreshold(std::vector<int32_t> threshold, sptr<IDisplayBrightnessCallback> callback);
     uint32_t GetCurrentDisplayId(uint32_t defaultId);
     bool IsDimming();
@@ -157,6 +214,16 @@ public:
     void SetCurrentSensorId(uint32_t sensorId);
     int NotifyScreenPowerStatus(uint32_t displayId, uint32_t status);
     bool SetSceneMode(SceneModeType type, bool enable);
+    // Called after each device or setting brightness write of any pipeline, dimming steps included, and
+    // after each task that changes the discount, auto brightness, override or boost of a pipeline
+    static void SetChangeObserver(std::function<void()> observer);
+    PublishedState GetPublishedState() const;
+    // The setting brightness was written by someone else, e.g. the settings app
+    void SetObservedSettingBrightness(uint32_t value);
+    void SetLuxObserver(std::function<void(bool, float, float, float)> luxObserver);
+    void BeginBrightnessBatch();
+    bool EndBrightnessBatch();
+    StateSnapshot GetStateSnapshot() const;
 
     static uint32_t GetSafeBrightness(uint32_t value);
     bool SetMaxBrightness(double value);
@@ -172,13 +239,42 @@ private:
     static const uint32_t AMBIENT_LUX_LEVELS[LUX_LEVEL_LENGTH];
     static const uint32_t WAIT_FOR_FIRST_LUX_MAX_TIME = 200;
     static const uint32_t WAIT_FOR_FIRST_LUX_STEP = 10;
-    static uint32_t brightnessValueMin;
-    static uint32_t brightnessValueMax;
+    // Written on the default pipeline strand, read by GetSafeBrightness on every pipeline
+    static std::atomic<uint32_t> brightnessValueMin;
+    static std::atomic<uint32_t> brightnessValueMax;
 
-    BrightnessService();
+    friend class BrightnessPipelineRegistry;
+
+    explicit BrightnessService(uint32_t displayId = DEFAULT_DISPLAY_ID, bool isDefaultPipeline = true);
     virtual ~BrightnessService() = default;
 
-    static uint32_t GetSettingBrightness(const std::string& key = SETTING_BRIGHTNESS_KEY);
+    void InitOnce(uint32_t defaultMax, uint32_t defaultMin);
+    uint32_t GetSettingBrightness(const std::string& key = SETTING_BRIGHTNESS_KEY);
+    // Runs func on the strand. The outermost call publishes the state snapshot once func has returned,
+    // nested calls run inline and leave it to the outermost one, so readers never see a task half done.
+    template<typename Func>
+    auto RunOnStrand(Func&& func) -> decltype(func())
+    {
+        if (mStrand.IsCurrent()) {
+            return func();
+        }
+        return mStrand.Run([this, &func]() -> decltype(func()) {
+            SnapshotPublisher publisher(*this);
+            return func();
+        });
+    }
+    // Live field on the strand, snapshot field elsewhere
+    template<typename T>
+    T ReadState(const T& field, T StateSnapshot::* member) const
+    {
+        return mStrand.IsCurrent() ? field : mSnapshot.Load().*member;
+    }
+    StateSnapshot MakeSnapshot() const;
+    void PublishSnapshot();
+    void PostLightLux(float lux);
+    void NotifyDeviceBrightnessObserver(uint32_t level);
+    static void NotifyChangeObserver();
+    void NotifyLuxObserver(bool isValid);
     bool mIsLuxActiveWithLog{true};
 #ifdef ENABLE_SENSOR_PART
     static void AmbientLightCallback(SensorEvent* event);
@@ -190,13 +286,27 @@ private:
     void ActivateValidAmbientSensor();
     void DeactivateValidAmbientSensor();
     void DeactivateAllAmbientSensor();
-    bool mIsSupportLightSensor{false};
     SensorUser mSensorUser{};
     SensorUser mSensorUser1{};
 #endif
+    bool mIsSupportLightSensor{false};
     bool mIsLightSensorEnabled{false};
     bool mIsLightSensor1Enabled{false};
 
+    class SnapshotPublisher {
+    public:
+        explicit SnapshotPublisher(BrightnessService& service) : mService(service) {}
+        ~SnapshotPublisher()
+        {
+            mService.PublishSnapshot();
+        }
+        SnapshotPublisher(const SnapshotPublisher&) = delete;
+        SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    private:
+        BrightnessService& mService;
+    };
+
     void UpdateCurrentBrightnessLevel(float lux, bool isFastDuration);
     void SetBrightnessLevel(uint32_t value, uint32_t duration);
     bool IsScreenOn();
@@ -209,38 +319,73 @@ private:
     void UpdateBrightnessSettingFunc(const std::string& key);
     void RegisterFoldStatusListener();
     void UnRegisterFoldStatusListener();
+    void RegisterDisplayModeListener();
+    void UnRegisterDisplayModeListener();
+    void SetFoldDisplayMode(Rosen::FoldDisplayMode displayMode);
+    Rosen::FoldDisplayMode GetFoldDisplayMode();
+    bool IsFoldDevice();
     std::string GetReason();
     bool GetIsSupportLightSensor();
     bool IsCurrentSensorEnable();
 
-    bool mIsFoldDevice{false};
+    // Only the default pipeline drives the ambient light sensors and the persisted setting brightness
+    const bool mIsDefaultPipeline{true};
+    // Foldability is fixed per device and seeded by Init, the display mode is fed by mDisplayModeListener
+    std::atomic<bool> mIsFoldDevice{false};
+    std::atomic<bool> mIsFoldDeviceSeeded{false};
+    std::atomic<Rosen::FoldDisplayMode> mFoldDisplayMode{Rosen::FoldDisplayMode::UNKNOWN};
+    std::atomic<bool> mIsFoldDisplayModeCached{false};
     bool mIsAutoBrightnessEnabled{false};
     DisplayState mState{DisplayState::DISPLAY_UNKNOWN};
     uint32_t mBrightnessLevel{0};
-    std::atomic<uint32_t> mBrightnessTarget{0};
+    uint32_t mBrightnessTarget{0};
     uint32_t mDisplayId{0};
     uint32_t mCurrentSensorId{5};
     int mLuxLevel{-1};
     double mDiscount{1.0f};
-    std::atomic<bool> mIsBrightnessOverridden{false};
-    std::atomic<bool> mIsBrightnessBoosted{false};
+    bool mIsBrightnessOverridden{false};
+    bool mIsBrightnessBoosted{false};
     uint32_t mCachedSettingBrightness{DEFAULT_BRIGHTNESS};
     uint32_t mOverriddenBrightness{DEFAULT_BRIGHTNESS};
     uint32_t mBeforeOverriddenBrightness{DEFAULT_BRIGHTNESS};
     std::shared_ptr<BrightnessAction> mAction{nullptr};
     std::shared_ptr<BrightnessDimmingCallback> mDimmingCallback{nullptr};
     std::shared_ptr<BrightnessDimming> mDimming;
+    // Shared by all pipelines, replaced as a whole and loaded atomically as the dimming steps notify off the strand
+    static std::shared_ptr<const std::function<void()>> changeObserver;
+    // Levels of the last setting and device writes, as GetBrightness and GetDeviceBrightness(false) and (true)
+    std::atomic<uint32_t> mPublishedSettingBrightness{0};
+    std::atomic<uint32_t> mPublishedDeviceBrightness{0};
+    std::atomic<uint32_t> mPublishedDeviceBrightnessHbm{0};
+    std::atomic<bool> mIsPublishedSettingValid{false};
+    std::atomic<bool> mIsPublishedDeviceValid{false};
+    // Receives isValid, lux, filtered lux and smoothed lux after each processed light sensor sample,
+    // and isValid=false once the samples stop being processed
+    std::function<void(bool, float, float, float)> mLuxObserver{};
+    // Between BeginBrightnessBatch and EndBrightnessBatch only the last UpdateBrightness is applied
+    struct PendingBrightness {
+        uint32_t value{0};
+        uint32_t gradualDuration{0};
+        bool updateSetting{false};
+    };
+    bool mIsBatching{false};
+    bool mHasPendingBrightness{false};
+    PendingBrightness mPendingBrightness{};
     LightLuxManager mLightLuxManager{};
     BrightnessCalculationManager mBrightnessCalculationManager{};
     sptr<Rosen::DisplayManagerLite::IFoldStatusListener> mFoldStatusistener;
+    sptr<Rosen::DisplayManagerLite::IDisplayModeListener> mDisplayModeListener;
     std::shared_ptr<PowerMgr::FFRTQueue> queue_;
+    PowerMgr::FFRTHandle mCancelBoostTaskHandle{};
+    PowerMgr::FFRTHandle mWaitForFirstLuxTaskHandle{};
     bool mIsUserMode{false};
-    std::atomic<bool> mIsSleepStatus{false};
-    std::atomic<bool> mIsDisplayOnWhenFirstLuxReport{false};
-    std::atomic<bool> mWaitForFirstLux{false};
-    std::atomic<uint32_t> mCurrentBrightness{DEFAULT_BRIGHTNESS};
+    bool mIsSleepStatus{false};
+    bool mIsDisplayOnWhenFirstLuxReport{false};
+    bool mWaitForFirstLux{false};
+    uint32_t mCurrentBrightness{DEFAULT_BRIGHTNESS};
     std::once_flag mInitCallFlag;
-    std::mutex mFirstLuxHandleLock{};
+    BrightnessStrand mStrand;
+    BrightnessSnapshotCell<StateSnapshot> mSnapshot;
 };
 } // namespace DisplayPowerMgr
 } // namespace OHOS
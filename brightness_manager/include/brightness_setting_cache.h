@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRIGHTNESS_SETTING_CACHE_H
+#define BRIGHTNESS_SETTING_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "setting_observer.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// In-process copy of the setting keys read on hot paths. A key is read from the setting store on its first
+// access and afterwards only refreshed by an observer registered for it, so later reads are memory loads.
+class BrightnessSettingCache {
+public:
+    static BrightnessSettingCache& Get();
+
+    ErrCode GetIntValue(const std::string& key, int32_t& value);
+    // Applies a value this process has written, without waiting for the observer to report it
+    void UpdateIntValue(const std::string& key, int32_t value);
+    // Incremented whenever any cached value changes or is dropped
+    uint32_t GetGeneration() const;
+    // Whether changes of key made by other writers are reported, and so move the generation
+    bool IsObserved(const std::string& key) const;
+    // Unregisters the observers and drops every cached value
+    void DeInit();
+
+private:
+    // A failed observer registration is retried after this delay, doubled after each further failure
+    static constexpr int64_t WATCH_RETRY_MIN_MS = 1000;
+    static constexpr int64_t WATCH_RETRY_MAX_MS = 60000;
+
+    struct Entry {
+        sptr<PowerMgr::SettingObserver> observer;
+        // Only an observed key is served from memory, an unobserved one is read from the store
+        std::atomic<bool> observed {false};
+        std::atomic<int64_t> nextWatchTimeMs {0};
+        int64_t watchRetryMs {0};
+        std::atomic<bool> valid {false};
+        std::atomic<int32_t> value {0};
+        std::atomic<uint32_t> generation {0};
+    };
+
+    BrightnessSettingCache() = default;
+    std::shared_ptr<Entry> FindEntry(const std::string& key) const;
+    std::shared_ptr<Entry> WatchKey(const std::string& key);
+    void OnSettingChanged(const std::string& key);
+    void StoreLocked(Entry& entry, int32_t value);
+
+    mutable std::mutex mMutex;
+    std::mutex mWatchMutex;
+    std::map<std::string, std::shared_ptr<Entry>> mEntries;
+    std::atomic<uint32_t> mGeneration {0};
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // BRIGHTNESS_SETTING_CACHE_H
@@ -17,6 +17,7 @@
 #define BRIGHTNESS_SETTING_HELPER_H
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 
 #include "setting_observer.h"
@@ -28,9 +29,16 @@ using namespace OHOS::PowerMgr;
 
 class BrightnessSettingHelper {
 public:
+    // Creates the queue of the write-behind, setting brightness is written synchronously without it
+    static void Init();
+    // Persists the pending setting brightness and releases the queue
+    static void DeInit();
     static void RegisterSettingBrightnessObserver(SettingObserver::UpdateFunc func);
     static void UnregisterSettingBrightnessObserver();
+    // Records the value and persists it after the write-behind delay, consecutive values are coalesced
     static void SetSettingBrightness(uint32_t value);
+    // Persists the pending setting brightness now, used before the screen goes off and on shutdown
+    static void FlushSettingBrightness();
     static ErrCode GetSettingBrightness(uint32_t& brightness, const std::string& key = SETTING_BRIGHTNESS_KEY);
 
     static void RegisterSettingAutoBrightnessObserver(SettingObserver::UpdateFunc func);
@@ -41,8 +49,25 @@ private:
     static const constexpr char* SETTING_BRIGHTNESS_KEY {"settings.display.screen_brightness_status"};
     static const constexpr char* SETTING_AUTO_ADJUST_BRIGHTNESS_KEY {"settings.display.auto_screen_brightness"};
 
+    static bool ScheduleSettingBrightnessWrite(int64_t nowMs);
+    static void WriteSettingBrightness();
+    static bool IsSettingBrightnessWrittenLocked(uint32_t value);
+    static void SetWrittenSettingBrightnessLocked(uint32_t value, uint32_t generation);
+
     static sptr<SettingObserver> mAutoBrightnessObserver;
     static sptr<SettingObserver> mBrightnessObserver;
+
+    static std::mutex mSettingBrightnessMutex;
+    static std::mutex mSettingBrightnessWriteMutex;
+    static bool mHasPendingSettingBrightness;
+    static uint32_t mPendingSettingBrightness;
+    static int64_t mFirstPendingTimeMs;
+    static bool mHasWrittenSettingBrightness;
+    static uint32_t mWrittenSettingBrightness;
+    // Generation of the cached setting at the time mWrittenSettingBrightness was known to be stored.
+    // Once the setting observer reports a change the stored value is unknown again.
+    static uint32_t mWrittenSettingGeneration;
+    static uint32_t mSettingBrightnessWriteCount;
 };
 } // namespace PowerMgr
 } // namespace OHOS
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRIGHTNESS_STRAND_H
+#define BRIGHTNESS_STRAND_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "ffrt_utils.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Serial executor: tasks run one at a time, in arrival order, and never concurrently with each other.
+// There is no thread of its own. Every caller runs its own task on its own thread once the tasks that
+// arrived before it are done, it never runs the tasks of others. A task may run further tasks on the
+// same strand, they run inline.
+// The running caller is recorded as an owner token rather than a thread: inside an FFRT task it is the
+// task id, which stays the same when the task is moved to another worker while it waits.
+class BrightnessStrand {
+public:
+    BrightnessStrand() = default;
+    BrightnessStrand(const BrightnessStrand&) = delete;
+    BrightnessStrand& operator=(const BrightnessStrand&) = delete;
+
+    template<typename Func>
+    auto Run(Func&& func) -> decltype(func())
+    {
+        if (IsCurrent()) {
+            return func();
+        }
+        Turn turn(*this);
+        return func();
+    }
+
+    // True while the caller is running a task of this strand
+    bool IsCurrent() const;
+
+private:
+    // Waits until the tasks that arrived before are done, then owns the strand until destruction
+    class Turn {
+    public:
+        explicit Turn(BrightnessStrand& strand);
+        ~Turn();
+        Turn(const Turn&) = delete;
+        Turn& operator=(const Turn&) = delete;
+
+    private:
+        BrightnessStrand& mStrand;
+    };
+
+    ffrt::mutex mMutex;
+    ffrt::condition_variable mTurnChanged;
+    uint64_t mNextTicket{0};  // Guarded by mMutex
+    uint64_t mServingTicket{0};  // Guarded by mMutex
+    std::atomic<uint64_t> mOwner{0};
+};
+
+// Latest value of a trivially copyable state, published by one writer at a time and read without a lock.
+// Readers retry while a write is in progress, the value is copied through relaxed atomic words.
+template<typename T>
+class BrightnessSnapshotCell {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot must be trivially copyable");
+
+public:
+    BrightnessSnapshotCell() : BrightnessSnapshotCell(T{}) {}
+    explicit BrightnessSnapshotCell(const T& value)
+    {
+        Store(value);
+    }
+
+    T Load() const
+    {
+        uint64_t words[WORD_COUNT];
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        do {
+            begin = mSequence.load(std::memory_order_acquire);
+            while ((begin & 1U) != 0) {
+                std::this_thread::yield();
+                begin = mSequence.load(std::memory_order_acquire);
+            }
+            for (size_t i = 0; i < WORD_COUNT; i++) {
+                words[i] = mWords[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            end = mSequence.load(std::memory_order_relaxed);
+        } while (begin != end);
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // Writers must be serialized by the caller
+    void Store(const T& value)
+    {
+        uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        uint32_t sequence = mSequence.load(std::memory_order_relaxed);
+        mSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORD_COUNT; i++) {
+            mWords[i].store(words[i], std::memory_order_relaxed);
+        }
+        mSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> mSequence{0};
+    std::atomic<uint64_t> mWords[WORD_COUNT] = {};
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // BRIGHTNESS_STRAND_H
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRIGHTNESS_THRESHOLD_MONITOR_H
+#define BRIGHTNESS_THRESHOLD_MONITOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <iremote_object.h>
+
+#include "ffrt_utils.h"
+#include "idisplay_brightness_callback.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Ambient light and brightness thresholds of SetLightBrightnessThreshold. A client passes
+// {luxThreshold, brightnessThreshold, hysteresis}, a negative threshold is not monitored. The client is told
+// ABOVE once a sample reaches threshold + hysteresis and BELOW once a sample drops under threshold - hysteresis,
+// through OnNotifyApsLightBrightnessChange(type, state). Nothing is sent while the sample stays on one side.
+// Samples are fed by the default display pipeline only, as the thresholds are not bound to a display.
+class BrightnessThresholdMonitor {
+public:
+    enum ThresholdType : uint32_t {
+        TYPE_LIGHT = 1,
+        TYPE_BRIGHTNESS = 2,
+    };
+    enum ThresholdState : int32_t {
+        STATE_BELOW = 0,
+        STATE_ABOVE = 1,
+    };
+
+    static BrightnessThresholdMonitor& Get();
+
+    // Replaces the thresholds registered before with the same callback. Returns false if nothing is monitored.
+    bool Register(const std::vector<int32_t>& threshold, const sptr<IDisplayBrightnessCallback>& callback);
+    void Remove(const sptr<IRemoteObject>& remote);
+    // Cheap when no client monitors the type, which is the common case
+    void OnSample(ThresholdType type, double value);
+    void Dump(std::string& result) const;
+
+private:
+    static constexpr size_t MAX_CLIENTS = 64;
+    static constexpr size_t TYPE_COUNT = 2;
+    static constexpr int8_t STATE_UNKNOWN = -1;
+
+    struct Client {
+        sptr<IDisplayBrightnessCallback> callback;
+        sptr<IRemoteObject::DeathRecipient> deathRecipient;
+        std::array<int32_t, TYPE_COUNT> thresholds {-1, -1};
+        int32_t hysteresis {0};
+        std::array<int8_t, TYPE_COUNT> states {STATE_UNKNOWN, STATE_UNKNOWN};  // Guarded by mMutex
+        uint64_t notified {0};  // Guarded by mMutex
+    };
+
+    struct Edge {
+        double value {0.0};
+        Client* client {nullptr};
+    };
+
+    // Sorted crossing points of one type, rebuilt whenever a registration changes
+    struct Channel {
+        std::vector<Edge> upEdges;  // threshold + hysteresis, reaching one turns the client ABOVE
+        std::vector<Edge> downEdges;  // threshold - hysteresis, dropping under one turns the client BELOW
+        double lastValue {0.0};
+        bool hasValue {false};
+    };
+
+    struct Notification {
+        sptr<IDisplayBrightnessCallback> callback;
+        ThresholdType type {TYPE_LIGHT};
+        ThresholdState state {STATE_BELOW};
+    };
+
+    class ClientDeathRecipient : public IRemoteObject::DeathRecipient {
+    public:
+        void OnRemoteDied(const wptr<IRemoteObject>& remote) override;
+    };
+
+    BrightnessThresholdMonitor() = default;
+    static size_t GetIndex(ThresholdType type);
+    void RebuildLocked();
+    void InitStateLocked(Client& client, size_t index);
+    void Deliver(const std::vector<Notification>& notifications);
+
+    mutable std::mutex mMutex;
+    std::map<sptr<IRemoteObject>, std::unique_ptr<Client>> mClients;
+    std::array<Channel, TYPE_COUNT> mChannels;
+    // Bit per type that has at least one client, read by OnSample without the lock
+    std::atomic<uint32_t> mActiveTypes {0};
+    // Keeps the notifications of successive samples in order
+    std::shared_ptr<PowerMgr::FFRTQueue> mQueue {
+        std::make_shared<PowerMgr::FFRTQueue>("brightness_threshold_monitor")};
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // BRIGHTNESS_THRESHOLD_MONITOR_H
@@ -24,6 +24,7 @@ namespace DisplayPowerMgr {
 struct PointXy {
     float x{-1.0f};
     float y{-1.0f};
+    float slope{0.0f}; // slope of the segment to the next point, filled by ConfigParserBase::NormalizePointXy
 };
 struct PointXyz {
     float x{-1.0f};
@@ -53,6 +54,7 @@ public:
     static bool ParseConfig(int displayId, CalculationConfig::Data& data);
     static bool ParseConfigJsonRoot(int displayId, const std::string& fileContent, CalculationConfig::Data& data);
     static void PrintConfig(int displayId, const CalculationConfig::Data& data);
+    static bool ValidateConfig(int displayId, CalculationConfig::Data& data);
 };
 } // namespace DisplayPowerMgr
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef BRIGHTNESS_CALCULATION_CURVE_H
 #define BRIGHTNESS_CALCULATION_CURVE_H
 
+#include <array>
 #include <cstdint>
 #include <mutex>
 #include <unordered_map>
@@ -28,7 +29,7 @@ namespace OHOS {
 namespace DisplayPowerMgr {
 class BrightnessCalculationCurve {
 public:
-    BrightnessCalculationCurve() = default;
+    BrightnessCalculationCurve();
     BrightnessCalculationCurve(const BrightnessCalculationCurve&) = delete;
     BrightnessCalculationCurve& operator=(const BrightnessCalculationCurve&) = delete;
     BrightnessCalculationCurve(BrightnessCalculationCurve&&) = delete;
@@ -45,14 +46,23 @@ public:
 private:
     static const uint32_t DEFAULT_DISPLAY_ID = 0;
     static const uint32_t DEFAULT_SENSOR_ID = 5;
+    // Dense lookup for display mode and fold status keys, larger keys fall back to the config map
+    static constexpr int SCREEN_DATA_TABLE_SIZE = 16;
+    using ScreenDataTable = std::array<ScreenData, SCREEN_DATA_TABLE_SIZE>;
 
-    float GetBrightnessCurveLevel(std::vector<PointXy>& linePointsList, float lux);
+    static void BuildScreenDataTable(const std::unordered_map<int, ScreenData>& data, ScreenDataTable& table);
+    static ScreenData LookupScreenData(const ScreenDataTable& table,
+        const std::unordered_map<int, ScreenData>& data, int key);
+    void BuildScreenDataTables();
+    float GetBrightnessCurveLevel(const std::vector<PointXy>& linePointsList, float lux);
 
     Config mCurveConfig{};
     float mDefaultBrightness {100.0f};
     float mCurveAmbientLux {0.0f};
     int mCurrentUserId {0};
     ScreenConfig mScreenConfig{};
+    ScreenDataTable mDisplayModeTable{};
+    ScreenDataTable mFoldStatusTable{};
 };
 
 } // namespace DisplayPowerMgr
@@ -50,7 +50,9 @@ private:
     ConfigParse() = default;
     virtual ~ConfigParse() = default;
 
+    // Returns false if a curve of the display is malformed
     bool ParseConfig(int displayId, Config& data) const;
+    Config GetDefaultConfig(int displayId) const;
     void PrintConfig(int displayId, const Config& data) const;
 
     mutable std::mutex mLock{};
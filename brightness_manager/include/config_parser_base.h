@@ -40,7 +40,8 @@ public:
     void Initialize();
     const std::string LoadConfigPath(int displayId, const std::string& configName) const;
     const std::string LoadConfigRoot(int displayId, const std::string& configName) const;
-    void ParsePointXy(const cJSON* root, const std::string& name, std::vector<PointXy>& data) const;
+    bool ParsePointXy(const cJSON* root, const std::string& name, std::vector<PointXy>& data) const;
+    bool NormalizePointXy(const std::string& name, std::vector<PointXy>& data) const;
     const std::string PointXyToString(const std::string& name, const std::vector<PointXy>& data) const;
     void ParseScreenData(const cJSON* root, const std::string& name, std::unordered_map<int, ScreenData>& data,
        const std::string paramName) const;
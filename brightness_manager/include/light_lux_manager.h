@@ -58,8 +58,6 @@ private:
     int GetDarkenResponseTime() const;
     int GetBrightenResponseTime() const;
     const LuxThresholdConfig::Mode& GetCurrentModeData() const;
-    std::vector<PointXy> GetBrightenLuxList();
-    std::vector<PointXy> GetDarkenLuxList();
     int GetFilterNum();
     int GetNoFilterNum();
     void PrintCurrentLuxLog(int64_t timestamp);
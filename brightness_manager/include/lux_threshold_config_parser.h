@@ -52,6 +52,7 @@ public:
     static bool ParseConfig(int displayId, LuxThresholdConfig::Data& data);
     static bool ParseConfigJsonRoot(const std::string& fileContent, LuxThresholdConfig::Data& data);
     static void PrintConfig(int displayId, const LuxThresholdConfig::Data& data);
+    static bool ValidateConfig(int displayId, LuxThresholdConfig::Data& data);
 };
 } // namespace DisplayPowerMgr
 } // namespace OHOS
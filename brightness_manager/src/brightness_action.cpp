@@ -20,6 +20,7 @@
 #include <ipc_skeleton.h>
 
 #include "display_log.h"
+#include "display_trace_recorder.h"
 #include "display_manager_lite.h"
 #include "dm_common.h"
 #include "screen_manager_lite.h"
@@ -88,6 +89,7 @@ bool BrightnessAction::SetBrightness(uint32_t displayId, uint32_t value)
     Rosen::DmsScreenBrightnessData brightnessData(displayId, value);
     bool isSucc = Rosen::DisplayManagerLite::GetInstance().SetScreenBrightness(brightnessData);
     IPCSkeleton::SetCallingIdentity(identity);
+    DisplayTraceRecorder::Get().RecordOnce(displayId, DisplayTraceEvent::SET_SCREEN_BRIGHTNESS, value, isSucc);
     std::lock_guard lock(mMutexBrightness);
     mBrightness = isSucc ? value : mBrightness;
     return isSucc;
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "brightness_data_listener_registry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
+#include <cJSON.h>
+
+#include "display_log.h"
+#include "display_mgr_errors.h"
+
+using namespace OHOS::PowerMgr;
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+namespace {
+constexpr const char* PARAM_MIN_INTERVAL_MS = "minIntervalMs";
+}
+
+BrightnessDataListenerRegistry& BrightnessDataListenerRegistry::Get()
+{
+    static BrightnessDataListenerRegistry instance;
+    return instance;
+}
+
+int32_t BrightnessDataListenerRegistry::Register(const sptr<IDisplayBrightnessListener>& listener,
+    DisplayDataChangeListenerType type, const std::string& callerId, const std::string& params)
+{
+    if (listener == nullptr || listener->AsObject() == nullptr) {
+        DISPLAY_HILOGE(FEAT_BRIGHTNESS, "RegisterDataChangeListener listener is nullptr");
+        return static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+    }
+    auto entry = std::make_shared<Listener>();
+    entry->listener = listener;
+    entry->type = type;
+    entry->callerId = callerId;
+    entry->minIntervalMs = ParseMinInterval(params);
+    entry->queue = std::make_shared<FFRTQueue>("brightness_data_listener");
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto key = std::make_pair(type, callerId);
+    auto iter = mListeners.find(key);
+    if (iter != mListeners.end()) {
+        DetachLocked(iter);
+    } else if (mListeners.size() >= MAX_LISTENERS) {
+        DISPLAY_HILOGE(FEAT_BRIGHTNESS, "Too many data change listeners, reject %{public}s", callerId.c_str());
+        return static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+    }
+    entry->deathRecipient = new ListenerDeathRecipient();
+    listener->AsObject()->AddDeathRecipient(entry->deathRecipient);
+    mListeners[key] = entry;
+    UpdateActiveTypesLocked();
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "RegisterDataChangeListener type=%{public}u, callerId=%{public}s,"
+        " minIntervalMs=%{public}u, total=%{public}zu", static_cast<uint32_t>(type), callerId.c_str(),
+        entry->minIntervalMs, mListeners.size());
+    return 0;
+}
+
+int32_t BrightnessDataListenerRegistry::Unregister(DisplayDataChangeListenerType type, const std::string& callerId)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mListeners.find(std::make_pair(type, callerId));
+    if (iter == mListeners.end()) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "UnregisterDataChangeListener not found, type=%{public}u,"
+            " callerId=%{public}s", static_cast<uint32_t>(type), callerId.c_str());
+        return 0;
+    }
+    DetachLocked(iter);
+    mListeners.erase(iter);
+    UpdateActiveTypesLocked();
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UnregisterDataChangeListener type=%{public}u, callerId=%{public}s",
+        static_cast<uint32_t>(type), callerId.c_str());
+    return 0;
+}
+
+void BrightnessDataListenerRegistry::RemoveAll(const sptr<IRemoteObject>& remote)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto iter = mListeners.begin(); iter != mListeners.end();) {
+        if (iter->second->listener->AsObject() != remote) {
+            ++iter;
+            continue;
+        }
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "remove dead data change listener, callerId=%{public}s",
+            iter->second->callerId.c_str());
+        DetachLocked(iter);
+        iter = mListeners.erase(iter);
+    }
+    UpdateActiveTypesLocked();
+}
+
+void BrightnessDataListenerRegistry::DetachLocked(std::map<ListenerKey, std::shared_ptr<Listener>>::iterator iter)
+{
+    auto& entry = iter->second;
+    entry->listener->AsObject()->RemoveDeathRecipient(entry->deathRecipient);
+    // A delivery already running completes, the pending changes are discarded
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    entry->isRemoved = true;
+    entry->pending.clear();
+}
+
+void BrightnessDataListenerRegistry::UpdateActiveTypesLocked()
+{
+    uint32_t activeTypes = 0;
+    for (const auto& [key, entry] : mListeners) {
+        activeTypes |= 1U << static_cast<uint32_t>(key.first);
+    }
+    mActiveTypes.store(activeTypes, std::memory_order_release);
+}
+
+void BrightnessDataListenerRegistry::Publish(DisplayDataChangeListenerType type, uint32_t displayId,
+    const char* name, double value)
+{
+    uint32_t bit = 1U << static_cast<uint32_t>(type);
+    if ((mActiveTypes.load(std::memory_order_acquire) & bit) == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto iter = mListeners.lower_bound(std::make_pair(type, std::string()));
+        iter != mListeners.end() && iter->first.first == type; ++iter) {
+        Post(iter->second, displayId, name, value);
+    }
+}
+
+void BrightnessDataListenerRegistry::Post(const std::shared_ptr<Listener>& listener, uint32_t displayId,
+    const char* name, double value)
+{
+    int64_t now = GetNowMs();
+    uint32_t delayMs = 0;
+    {
+        std::lock_guard<std::mutex> lock(listener->mutex);
+        if (listener->isRemoved) {
+            return;
+        }
+        listener->pending[std::make_pair(displayId, std::string(name))] = {value, now};
+        listener->published++;
+        if (listener->isScheduled) {
+            return;
+        }
+        listener->isScheduled = true;
+        int64_t due = listener->lastDeliveryMs + listener->minIntervalMs;
+        delayMs = due > now ? static_cast<uint32_t>(due - now) : 0;
+    }
+    FFRTTask task = [listener] { Deliver(listener); };
+    FFRTUtils::SubmitDelayTask(task, delayMs, listener->queue);
+}
+
+void BrightnessDataListenerRegistry::Deliver(const std::shared_ptr<Listener>& listener)
+{
+    std::map<std::pair<uint32_t, std::string>, Event> events;
+    {
+        std::lock_guard<std::mutex> lock(listener->mutex);
+        listener->isScheduled = false;
+        if (listener->isRemoved || listener->pending.empty()) {
+            return;
+        }
+        events.swap(listener->pending);
+        listener->lastDeliveryMs = GetNowMs();
+        listener->batches++;
+    }
+    listener->listener->OnDataChanged(MakeBatch(listener->type, events));
+}
+
+uint32_t BrightnessDataListenerRegistry::ParseMinInterval(const std::string& params)
+{
+    if (params.empty()) {
+        return DEFAULT_MIN_INTERVAL_MS;
+    }
+    cJSON* root = cJSON_Parse(params.c_str());
+    if (root == nullptr || !cJSON_IsObject(root)) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "data change listener params is not a json object, use default");
+        cJSON_Delete(root);
+        return DEFAULT_MIN_INTERVAL_MS;
+    }
+    uint32_t minIntervalMs = DEFAULT_MIN_INTERVAL_MS;
+    const cJSON* node = cJSON_GetObjectItemCaseSensitive(root, PARAM_MIN_INTERVAL_MS);
+    if (node != nullptr && cJSON_IsNumber(node)) {
+        double value = std::clamp(node->valuedouble, 0.0, static_cast<double>(MAX_MIN_INTERVAL_MS));
+        minIntervalMs = static_cast<uint32_t>(value);
+    }
+    cJSON_Delete(root);
+    return minIntervalMs;
+}
+
+std::string BrightnessDataListenerRegistry::MakeBatch(DisplayDataChangeListenerType type,
+    const std::map<std::pair<uint32_t, std::string>, Event>& events)
+{
+    cJSON* root = cJSON_CreateObject();
+    if (root == nullptr) {
+        return "";
+    }
+    cJSON_AddNumberToObject(root, "type", static_cast<double>(type));
+    cJSON* array = cJSON_CreateArray();
+    for (const auto& [key, event] : events) {
+        cJSON* item = cJSON_CreateObject();
+        if (item == nullptr) {
+            continue;
+        }
+        cJSON_AddNumberToObject(item, "displayId", key.first);
+        cJSON_AddStringToObject(item, "name", key.second.c_str());
+        cJSON_AddNumberToObject(item, "value", event.value);
+        cJSON_AddNumberToObject(item, "timeMs", static_cast<double>(event.timeMs));
+        cJSON_AddItemToArray(array, item);
+    }
+    cJSON_AddItemToObject(root, "events", array);
+    char* json = cJSON_PrintUnformatted(root);
+    std::string batch = (json != nullptr) ? json : "";
+    cJSON_free(json);
+    cJSON_Delete(root);
+    return batch;
+}
+
+int64_t BrightnessDataListenerRegistry::GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void BrightnessDataListenerRegistry::Dump(std::string& result) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    result.append("Data Change Listeners: ").append(std::to_string(mListeners.size())).append("\n");
+    for (const auto& [key, entry] : mListeners) {
+        std::lock_guard<std::mutex> entryLock(entry->mutex);
+        result.append("  Type=").append(std::to_string(static_cast<uint32_t>(key.first)));
+        result.append(" CallerId=").append(key.second);
+        result.append(" MinIntervalMs=").append(std::to_string(entry->minIntervalMs));
+        result.append(" Published=").append(std::to_string(entry->published));
+        result.append(" Batches=").append(std::to_string(entry->batches)).append("\n");
+    }
+}
+
+void BrightnessDataListenerRegistry::ListenerDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& remote)
+{
+    auto object = remote.promote();
+    if (object != nullptr) {
+        BrightnessDataListenerRegistry::Get().RemoveAll(object);
+    }
+}
+} // namespace DisplayPowerMgr
+} // namespace OHOS
@@ -24,9 +24,6 @@ namespace OHOS {
 namespace DisplayPowerMgr {
 using namespace std::chrono_literals;
 using namespace PowerMgr;
-namespace {
-FFRTHandle g_animatorTaskHandle;
-}
 
 BrightnessDimming::BrightnessDimming(const std::string& name, std::shared_ptr<BrightnessDimmingCallback>& callback)
     : mName(name), mCallback(callback)
@@ -55,7 +52,7 @@ void BrightnessDimming::Reset()
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "reset dimming queue");
     if (mQueue) {
         mQueue.reset();
-        g_animatorTaskHandle = nullptr;
+        mAnimatorTaskHandle = nullptr;
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "destruct dimming_queue");
     }
 }
@@ -99,7 +96,7 @@ void BrightnessDimming::StartDimming(uint32_t from, uint32_t to, uint32_t durati
     mDimming = true;
     FFRTTask task = [this] { this->NextStep(); };
     std::lock_guard<std::mutex> lock(mAnimatorHandleLock);
-    g_animatorTaskHandle = FFRTUtils::SubmitDelayTask(task, mUpdateTime, mQueue);
+    mAnimatorTaskHandle = FFRTUtils::SubmitDelayTask(task, mUpdateTime, mQueue);
 }
 
 void BrightnessDimming::StopDimming()
@@ -107,7 +104,7 @@ void BrightnessDimming::StopDimming()
     mDimming = false;
     mCondDimmingDone.notify_all();
     mAnimatorHandleLock.lock();
-    FFRT_CANCEL(g_animatorTaskHandle, mQueue);
+    FFRT_CANCEL(mAnimatorTaskHandle, mQueue);
     mAnimatorHandleLock.unlock();
     if (mCallback == nullptr) {
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Callback is nullptr");
@@ -168,7 +165,7 @@ void BrightnessDimming::NextStep()
             mCurrentBrightness = nextBrightness;
             mCallback->OnChanged(mCurrentBrightness);
             FFRTTask task = [this] { this->NextStep(); };
-            g_animatorTaskHandle = FFRTUtils::SubmitDelayTask(task, mUpdateTime, mQueue);
+            mAnimatorTaskHandle = FFRTUtils::SubmitDelayTask(task, mUpdateTime, mQueue);
         }
     } else {
         DISPLAY_HILOGD(FEAT_BRIGHTNESS, "next step last mCurrentBrightness=%{public}u, mToBrightness=%{public}u",
@@ -15,6 +15,10 @@
 
 #include "brightness_manager.h"
 
+#include "brightness_data_listener_registry.h"
+#include "brightness_pipeline_registry.h"
+#include "display_trace_recorder.h"
+
 namespace OHOS {
 namespace DisplayPowerMgr {
 BrightnessManager& BrightnessManager::Get()
@@ -52,10 +56,13 @@ bool BrightnessManager::GetFeatureSupport(BrightnessFeatureType feature)
 
 void BrightnessManager::SetDisplayState(uint32_t id, DisplayState state, uint32_t reason)
 {
+    DisplayTraceRecorder::Get().Record(id, DisplayTraceEvent::BRIGHTNESS_SET_DISPLAY_STATE,
+        static_cast<uint32_t>(state), reason);
 #ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
     mBrightnessManagerExt.SetDisplayState(id, state, reason);
 #else
-    BrightnessService::Get().SetDisplayState(id, state);
+    std::shared_ptr<BrightnessService> pipeline;
+    BrightnessPipelineRegistry::Get().Resolve(id, pipeline).SetDisplayState(id, state);
 #endif
 }
 
@@ -137,6 +144,7 @@ double BrightnessManager::GetDiscount() const
 
 void BrightnessManager::SetScreenOnBrightness()
 {
+    DisplayTraceRecorder::Get().Record(GetCurrentDisplayId(0), DisplayTraceEvent::SET_SCREEN_ON_BRIGHTNESS);
 #ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
     mBrightnessManagerExt.SetScreenOnBrightness();
 #else
@@ -241,9 +249,7 @@ int32_t BrightnessManager::RegisterDataChangeListener(const sptr<IDisplayBrightn
 #ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
     return mBrightnessManagerExt.RegisterDataChangeListener(listener, listenerType, callerId, params);
 #else
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "RegisterDataChangeListener: %{public}u, %{public}s",
-        listenerType, callerId.c_str());
-    return 0;
+    return BrightnessDataListenerRegistry::Get().Register(listener, listenerType, callerId, params);
 #endif
 }
 
@@ -253,9 +259,7 @@ int32_t BrightnessManager::UnregisterDataChangeListener(
 #ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
     return mBrightnessManagerExt.UnregisterDataChangeListener(listenerType, callerId);
 #else
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UnregisterDataChangeListener: %{public}u, %{public}s",
-        listenerType, callerId.c_str());
-    return 0;
+    return BrightnessDataListenerRegistry::Get().Unregister(listenerType, callerId);
 #endif
 }
 
@@ -343,5 +347,222 @@ bool BrightnessManager::SetSceneMode(SceneModeType type, bool enable)
     return BrightnessService::Get().SetSceneMode(type, enable);
 #endif
 }
+
+bool BrightnessManager::SetChangeObserver(std::function<void()> observer)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return false;
+#else
+    BrightnessService::SetChangeObserver(std::move(observer));
+    return true;
+#endif
+}
+
+BrightnessService::PublishedState BrightnessManager::GetDisplayPublishedState(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    BrightnessService::PublishedState state;
+    state.discount = mBrightnessManagerExt.GetDiscount();
+    state.isAutoBrightnessEnabled = mBrightnessManagerExt.IsAutoAdjustBrightness();
+    state.isBrightnessOverridden = mBrightnessManagerExt.IsBrightnessOverridden();
+    state.isBrightnessBoosted = mBrightnessManagerExt.IsBrightnessBoosted();
+    return state;
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).GetPublishedState();
+#endif
+}
+
+void BrightnessManager::SetObservedSettingBrightness(uint32_t value)
+{
+#ifndef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    BrightnessService::Get().SetObservedSettingBrightness(value);
+#endif
+}
+
+bool BrightnessManager::SetLuxObserver(std::function<void(bool, float, float, float)> luxObserver)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return false;
+#else
+    BrightnessService::Get().SetLuxObserver(std::move(luxObserver));
+    return true;
+#endif
+}
+
+void BrightnessManager::BeginBrightnessBatch()
+{
+#ifndef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    BrightnessService::Get().BeginBrightnessBatch();
+#endif
+}
+
+bool BrightnessManager::EndBrightnessBatch()
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return true;
+#else
+    return BrightnessService::Get().EndBrightnessBatch();
+#endif
+}
+
+bool BrightnessManager::AddDisplayPipeline(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return false;
+#else
+    return BrightnessPipelineRegistry::Get().Add(displayId) != nullptr;
+#endif
+}
+
+void BrightnessManager::RemoveDisplayPipeline(uint32_t displayId)
+{
+#ifndef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    BrightnessPipelineRegistry::Get().Remove(displayId);
+#endif
+}
+
+bool BrightnessManager::SetDisplayBrightness(uint32_t displayId, uint32_t value, uint32_t gradualDuration,
+    bool continuous)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.SetBrightness(value, gradualDuration, continuous);
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).SetBrightness(value, gradualDuration,
+        continuous);
+#endif
+}
+
+bool BrightnessManager::DiscountDisplayBrightness(uint32_t displayId, double discount)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.DiscountBrightness(discount);
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).DiscountBrightness(discount);
+#endif
+}
+
+uint32_t BrightnessManager::GetDisplayBrightness(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.GetBrightness();
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).GetBrightness();
+#endif
+}
+
+uint32_t BrightnessManager::GetDisplayDeviceBrightness(uint32_t displayId, bool useHbm)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.GetDeviceBrightness(useHbm);
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).GetDeviceBrightness(useHbm);
+#endif
+}
+
+bool BrightnessManager::OverrideDisplayBrightness(uint32_t displayId, uint32_t value, uint32_t gradualDuration)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.OverrideBrightness(value, gradualDuration);
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).OverrideBrightness(value, gradualDuration);
+#endif
+}
+
+bool BrightnessManager::RestoreDisplayBrightness(uint32_t displayId, uint32_t gradualDuration)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.RestoreBrightness(gradualDuration);
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).RestoreBrightness(gradualDuration);
+#endif
+}
+
+bool BrightnessManager::BoostDisplayBrightness(uint32_t displayId, uint32_t timeoutMs, uint32_t gradualDuration)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.BoostBrightness(timeoutMs, gradualDuration);
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).BoostBrightness(timeoutMs,
+        gradualDuration);
+#endif
+}
+
+bool BrightnessManager::CancelBoostDisplayBrightness(uint32_t displayId, uint32_t gradualDuration)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.CancelBoostBrightness(gradualDuration);
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).CancelBoostBrightness(gradualDuration);
+#endif
+}
+
+void BrightnessManager::SetDisplayScreenOnBrightness(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    mBrightnessManagerExt.SetScreenOnBrightness();
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).SetScreenOnBrightness();
+#endif
+}
+
+uint32_t BrightnessManager::GetDisplayScreenOnBrightness(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.GetScreenOnBrightness();
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).GetScreenOnBrightness(false);
+#endif
+}
+
+DisplayState BrightnessManager::GetDisplayState(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.GetState();
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).GetDisplayState();
+#endif
+}
+
+double BrightnessManager::GetDisplayDiscount(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.GetDiscount();
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).GetDiscount();
+#endif
+}
+
+bool BrightnessManager::IsDisplayBrightnessOverridden(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.IsBrightnessOverridden();
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).IsBrightnessOverridden();
+#endif
+}
+
+bool BrightnessManager::IsDisplayBrightnessBoosted(uint32_t displayId)
+{
+#ifdef OHOS_BUILD_ENABLE_BRIGHTNESS_WRAPPER
+    return mBrightnessManagerExt.IsBrightnessBoosted();
+#else
+    std::shared_ptr<BrightnessService> pipeline;
+    return BrightnessPipelineRegistry::Get().Resolve(displayId, pipeline).IsBrightnessBoosted();
+#endif
+}
 } // namespace DisplayPowerMgr
 } // namespace OHOS
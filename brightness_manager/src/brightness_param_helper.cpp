@@ -20,40 +20,55 @@
 namespace OHOS {
 namespace DisplayPowerMgr {
 using namespace OHOS::PowerMgr;
-uint32_t BrightnessParamHelper::GetDefaultBrightness()
+uint32_t BrightnessParamHelper::GetCachedIntValue(std::atomic<int64_t>& cache, const char* key, int32_t def)
 {
-    int32_t value = SysParam::GetIntValue(KEY_DEFAULT_BRIGHTNESS, BRIGHTNESS_DEFAULT);
+    int64_t value = cache.load(std::memory_order_acquire);
+    if (value == PARAM_NOT_CACHED) {
+        value = SysParam::GetIntValue(key, def);
+        cache.store(value, std::memory_order_release);
+    }
     return static_cast<uint32_t>(value);
 }
 
+uint32_t BrightnessParamHelper::GetDefaultBrightness()
+{
+    return GetCachedIntValue(mDefaultBrightness, KEY_DEFAULT_BRIGHTNESS, BRIGHTNESS_DEFAULT);
+}
+
 uint32_t BrightnessParamHelper::GetMaxBrightness()
 {
-    int32_t value = SysParam::GetIntValue(KEY_MAX_BRIGHTNESS, BRIGHTNESS_MAX);
-    return static_cast<uint32_t>(value);
+    return GetCachedIntValue(mMaxBrightness, KEY_MAX_BRIGHTNESS, BRIGHTNESS_MAX);
 }
 
 uint32_t BrightnessParamHelper::GetMinBrightness()
 {
-    int32_t value = SysParam::GetIntValue(KEY_MIN_BRIGHTNESS, BRIGHTNESS_MIN);
-    return static_cast<uint32_t>(value);
+    return GetCachedIntValue(mMinBrightness, KEY_MIN_BRIGHTNESS, BRIGHTNESS_MIN);
 }
 
 uint32_t BrightnessParamHelper::GetSleepBrightness()
 {
-    int32_t value = SysParam::GetIntValue(KEY_SLEEP_BRIGHTNESS, BRIGHTNESS_SLEEP);
-    return static_cast<uint32_t>(value);
+    return GetCachedIntValue(mSleepBrightness, KEY_SLEEP_BRIGHTNESS, BRIGHTNESS_SLEEP);
 }
 
 uint32_t BrightnessParamHelper::GetSleepMinumumReductionBrightness()
 {
-    int32_t value = SysParam::GetIntValue(KEY_SLEEP_MINUMUM_REDUCTION_BRIGHTNESS, BRIGHTNESS_SLEEP_MINUMUM_REDUCTION);
-    return static_cast<uint32_t>(value);
+    return GetCachedIntValue(mSleepMinumumReductionBrightness, KEY_SLEEP_MINUMUM_REDUCTION_BRIGHTNESS,
+        BRIGHTNESS_SLEEP_MINUMUM_REDUCTION);
 }
 
 uint32_t BrightnessParamHelper::GetSleepDarkenTime()
 {
-    int32_t value = SysParam::GetIntValue(KEY_SLEEP_DARKEN_TIME, BRIGHTNESS_SLEEP_DARKEN_TIME);
-    return static_cast<uint32_t>(value);
+    return GetCachedIntValue(mSleepDarkenTime, KEY_SLEEP_DARKEN_TIME, BRIGHTNESS_SLEEP_DARKEN_TIME);
+}
+
+void BrightnessParamHelper::InvalidateCache()
+{
+    mDefaultBrightness.store(PARAM_NOT_CACHED, std::memory_order_release);
+    mMaxBrightness.store(PARAM_NOT_CACHED, std::memory_order_release);
+    mMinBrightness.store(PARAM_NOT_CACHED, std::memory_order_release);
+    mSleepBrightness.store(PARAM_NOT_CACHED, std::memory_order_release);
+    mSleepMinumumReductionBrightness.store(PARAM_NOT_CACHED, std::memory_order_release);
+    mSleepDarkenTime.store(PARAM_NOT_CACHED, std::memory_order_release);
 }
 
 void BrightnessParamHelper::RegisterBootCompletedCallback(BootCompletedCallback& callback)
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "brightness_pipeline_registry.h"
+
+#include "display_log.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+BrightnessPipelineRegistry& BrightnessPipelineRegistry::Get()
+{
+    static BrightnessPipelineRegistry instance;
+    return instance;
+}
+
+bool BrightnessPipelineRegistry::IsDefaultPipelineDisplay(uint32_t displayId)
+{
+    BrightnessService& defaultPipeline = BrightnessService::Get();
+    if (displayId == defaultPipeline.GetDisplayId()) {
+        return true;
+    }
+    if (!defaultPipeline.mIsFoldDevice) {
+        return false;
+    }
+    for (auto mode : {Rosen::FoldDisplayMode::FULL, Rosen::FoldDisplayMode::MAIN}) {
+        if (defaultPipeline.GetDisplayIdWithDisplayMode(mode) == static_cast<int>(displayId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<BrightnessService> BrightnessPipelineRegistry::Add(uint32_t displayId)
+{
+    if (IsDefaultPipelineDisplay(displayId)) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "displayId=%{public}u is driven by the default pipeline", displayId);
+        return nullptr;
+    }
+    std::shared_ptr<BrightnessService> created;
+    bool isCreated = false;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto iter = mSlots.find(displayId);
+        isCreated = iter != mSlots.end() && iter->second.pipeline != nullptr;
+    }
+    if (!isCreated) {
+        // Init runs tasks on the new strand, which may look pipelines up, so it must not hold the lock
+        created = std::shared_ptr<BrightnessService>(new BrightnessService(displayId, false),
+            [](BrightnessService* pipeline) { delete pipeline; });
+        created->Init(BrightnessService::brightnessValueMax, BrightnessService::brightnessValueMin);
+    }
+    std::shared_ptr<BrightnessService> pipeline;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Slot& slot = mSlots[displayId];
+        if (slot.pipeline == nullptr) {
+            slot.pipeline = created;
+            created = nullptr;
+        }
+        if (!slot.attached) {
+            slot.attached = true;
+            mAttachedCount.fetch_add(1, std::memory_order_release);
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "brightness pipeline attached, displayId=%{public}u", displayId);
+        }
+        pipeline = slot.pipeline;
+    }
+    if (created != nullptr) {
+        // Another caller created the pipeline in the meantime, this one was never attached
+        created->DeInit();
+    }
+    return pipeline;
+}
+
+bool BrightnessPipelineRegistry::Remove(uint32_t displayId)
+{
+    std::shared_ptr<BrightnessService> pipeline;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto iter = mSlots.find(displayId);
+        if (iter == mSlots.end() || !iter->second.attached) {
+            return false;
+        }
+        iter->second.attached = false;
+        mAttachedCount.fetch_sub(1, std::memory_order_release);
+        pipeline = iter->second.pipeline;
+    }
+    // Stops a running animation, the display is gone or handed back to the default pipeline
+    pipeline->SetDisplayState(displayId, DisplayState::DISPLAY_OFF);
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "brightness pipeline detached, displayId=%{public}u", displayId);
+    return true;
+}
+
+std::shared_ptr<BrightnessService> BrightnessPipelineRegistry::Find(uint32_t displayId) const
+{
+    if (mAttachedCount.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mSlots.find(displayId);
+    return (iter != mSlots.end() && iter->second.attached) ? iter->second.pipeline : nullptr;
+}
+
+BrightnessService& BrightnessPipelineRegistry::Resolve(uint32_t displayId,
+    std::shared_ptr<BrightnessService>& holder) const
+{
+    holder = Find(displayId);
+    return (holder != nullptr) ? *holder : BrightnessService::Get();
+}
+
+std::vector<uint32_t> BrightnessPipelineRegistry::GetDisplayIds() const
+{
+    std::vector<uint32_t> displayIds;
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& [displayId, slot] : mSlots) {
+        if (slot.attached) {
+            displayIds.push_back(displayId);
+        }
+    }
+    return displayIds;
+}
+} // namespace DisplayPowerMgr
+} // namespace OHOS
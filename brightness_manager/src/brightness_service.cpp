@@ -23,12 +23,15 @@
 #include <securec.h>
 
 #include "brightness_action.h"
+#include "brightness_data_listener_registry.h"
 #include "brightness_setting_helper.h"
+#include "brightness_threshold_monitor.h"
 #include "config_parser.h"
 #include "delayed_sp_singleton.h"
 #include "display_common.h"
 #include "display_log.h"
 #include "display_manager_lite.h"
+#include "display_trace_recorder.h"
 #include "dm_common.h"
 #include "errors.h"
 #include "ffrt_utils.h"
@@ -59,9 +62,6 @@ constexpr uint32_t DEFAULT_ANIMATING_DURATION = 500;
 constexpr uint32_t DEFAULT_BRIGHTEN_DURATION = 2000;
 constexpr uint32_t DEFAULT_DARKEN_DURATION = 5000;
 constexpr uint32_t DEFAULT_MAX_BRIGHTNESS_DURATION = 3000;
-
-FFRTHandle g_cancelBoostTaskHandle{};
-FFRTHandle g_waitForFirstLuxTaskHandle{};
 }
 
 const uint32_t BrightnessService::AMBIENT_LUX_LEVELS[BrightnessService::LUX_LEVEL_LENGTH] = { 1, 3, 5, 10, 20, 50, 200,
@@ -69,19 +69,23 @@ const uint32_t BrightnessService::AMBIENT_LUX_LEVELS[BrightnessService::LUX_LEVE
 
 using namespace OHOS::PowerMgr;
 
-uint32_t BrightnessService::brightnessValueMax = MAX_DEFAULT_BRGIHTNESS_LEVEL;
-uint32_t BrightnessService::brightnessValueMin = MIN_DEFAULT_BRGIHTNESS_LEVEL;
+std::atomic<uint32_t> BrightnessService::brightnessValueMax{MAX_DEFAULT_BRGIHTNESS_LEVEL};
+std::atomic<uint32_t> BrightnessService::brightnessValueMin{MIN_DEFAULT_BRGIHTNESS_LEVEL};
+std::shared_ptr<const std::function<void()>> BrightnessService::changeObserver{};
 
-BrightnessService::BrightnessService()
+BrightnessService::BrightnessService(uint32_t displayId, bool isDefaultPipeline)
+    : mIsDefaultPipeline(isDefaultPipeline), mDisplayId(displayId)
 {
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService created for displayId=%{public}d", mDisplayId);
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService created for displayId=%{public}d, default=%{public}d",
+        mDisplayId, mIsDefaultPipeline);
     mAction = std::make_shared<BrightnessAction>(mDisplayId);
     if (mAction == nullptr) {
         DISPLAY_HILOGE(FEAT_BRIGHTNESS, "mAction is null");
+        PublishSnapshot();
         return;
     }
     mState = mAction->GetDisplayState();
-    mDimmingCallback = std::make_shared<DimmingCallbackImpl>(mAction, [this](uint32_t brightness) {
+    mDimmingCallback = std::make_shared<DimmingCallbackImpl>(*this, mAction, [this](uint32_t brightness) {
         SetSettingBrightness(brightness);
     });
     if (mDimmingCallback == nullptr) {
@@ -89,6 +93,7 @@ BrightnessService::BrightnessService()
     }
     std::string name = "BrightnessService" + std::to_string(mDisplayId);
     mDimming = std::make_shared<BrightnessDimming>(name, mDimmingCallback);
+    PublishSnapshot();
 }
 
 BrightnessService& BrightnessService::Get()
@@ -98,9 +103,24 @@ BrightnessService& BrightnessService::Get()
 }
 
 void BrightnessService::Init(uint32_t defaultMax, uint32_t defaultMin)
+{
+    if (mIsDefaultPipeline) {
+        BrightnessSettingHelper::Init();
+    }
+    // Seeded before the strand task, callers off the strand read it while the rest of the init is still running
+    if (!mIsFoldDeviceSeeded) {
+        mIsFoldDevice = mIsDefaultPipeline && Rosen::DisplayManagerLite::GetInstance().IsFoldable();
+        mIsFoldDeviceSeeded = true;
+    }
+    RunOnStrand([defaultMax, defaultMin, this] { InitOnce(defaultMax, defaultMin); });
+}
+
+void BrightnessService::InitOnce(uint32_t defaultMax, uint32_t defaultMin)
 {
     std::call_once(mInitCallFlag, [defaultMax, defaultMin, this] {
-        queue_ = std::make_shared<FFRTQueue> ("brightness_manager");
+        std::string queueName = mIsDefaultPipeline ? "brightness_manager" :
+            "brightness_manager_" + std::to_string(mDisplayId);
+        queue_ = std::make_shared<FFRTQueue> (queueName.c_str());
         if (queue_ == nullptr) {
             return;
         }
@@ -108,43 +128,58 @@ void BrightnessService::Init(uint32_t defaultMax, uint32_t defaultMin)
             return;
         }
 #ifdef ENABLE_SENSOR_PART
-        InitSensors();
-        mIsFoldDevice = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Init mIsFoldDevice=%{public}d", mIsFoldDevice);
+        if (mIsDefaultPipeline) {
+            InitSensors();
+        }
 #endif
         ConfigParse::Get().Initialize();
         mLightLuxManager.InitParameters();
         mBrightnessCalculationManager.InitParameters();
 
-        bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
+        // Fold status moves the default pipeline between the inner and outer panel
+        bool isFoldable = mIsFoldDevice;
         brightnessValueMax = defaultMax;
         brightnessValueMin = defaultMin;
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::init isFoldable=%{public}d, max=%{public}u, min=%{public}u",
-            isFoldable, brightnessValueMax, brightnessValueMin);
+            isFoldable, brightnessValueMax.load(), brightnessValueMin.load());
         if (isFoldable) {
             RegisterFoldStatusListener();
+            RegisterDisplayModeListener();
         }
     });
 }
 
 void BrightnessService::DeInit()
 {
-    bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::deinit isFoldable=%{public}d", isFoldable);
-    if (isFoldable) {
-        UnRegisterFoldStatusListener();
-    }
-    if (queue_) {
-        queue_.reset();
-        g_cancelBoostTaskHandle = nullptr;
-        g_waitForFirstLuxTaskHandle = nullptr;
+    std::shared_ptr<FFRTQueue> queue;
+    RunOnStrand([&queue, this] {
+        bool isFoldable = mIsFoldDevice;
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::deinit isFoldable=%{public}d", isFoldable);
+        if (isFoldable) {
+            UnRegisterFoldStatusListener();
+            UnRegisterDisplayModeListener();
+        }
+        queue.swap(queue_);
+        mCancelBoostTaskHandle = nullptr;
+        mWaitForFirstLuxTaskHandle = nullptr;
+        mDimming->Reset();
+        if (mIsDefaultPipeline) {
+            BrightnessSettingHelper::DeInit();
+        }
+    });
+    // Destroyed off the strand, a task of this queue may be waiting to run on it
+    if (queue) {
+        queue.reset();
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "destruct brightness ffrt queue");
     }
-
-    mDimming->Reset();
 }
 
 void BrightnessService::FoldStatusLisener::OnFoldStatusChanged(Rosen::FoldStatus foldStatus)
+{
+    BrightnessService::Get().RunOnStrand([this, foldStatus] { HandleFoldStatusChanged(foldStatus); });
+}
+
+void BrightnessService::FoldStatusLisener::HandleFoldStatusChanged(Rosen::FoldStatus foldStatus)
 {
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "OnFoldStatusChanged currenFoldStatus=%{public}d", foldStatus);
     if (mLastFoldStatus == foldStatus) {
@@ -216,50 +251,126 @@ void BrightnessService::UnRegisterFoldStatusListener()
     }
 }
 
+void BrightnessService::DisplayModeListener::OnDisplayModeChanged(Rosen::FoldDisplayMode displayMode)
+{
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "OnDisplayModeChanged displayMode=%{public}u", displayMode);
+    BrightnessService::Get().SetFoldDisplayMode(displayMode);
+}
+
+void BrightnessService::RegisterDisplayModeListener()
+{
+    mDisplayModeListener = new DisplayModeListener();
+    if (mDisplayModeListener == nullptr) {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::RegisterDisplayModeListener newListener failed");
+        return;
+    }
+    auto ret = Rosen::DisplayManagerLite::GetInstance().RegisterDisplayModeListener(mDisplayModeListener);
+    if (ret != Rosen::DMError::DM_OK) {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Rosen::DisplayManagerLite::RegisterDisplayModeListener failed");
+        mDisplayModeListener = nullptr;
+        return;
+    }
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::RegisterDisplayModeListener success");
+    // Seed the cache once, a mode already delivered by the listener takes precedence
+    std::string identity = IPCSkeleton::ResetCallingIdentity();
+    auto foldMode = Rosen::DisplayManagerLite::GetInstance().GetFoldDisplayMode();
+    IPCSkeleton::SetCallingIdentity(identity);
+    Rosen::FoldDisplayMode expected = Rosen::FoldDisplayMode::UNKNOWN;
+    mFoldDisplayMode.compare_exchange_strong(expected, foldMode);
+    mIsFoldDisplayModeCached = true;
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "RegisterDisplayModeListener foldMode=%{public}u", GetFoldDisplayMode());
+}
+
+void BrightnessService::UnRegisterDisplayModeListener()
+{
+    if (mDisplayModeListener == nullptr) {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::UnRegisterDisplayModeListener listener is null");
+        return;
+    }
+    auto ret = Rosen::DisplayManagerLite::GetInstance().UnregisterDisplayModeListener(mDisplayModeListener);
+    if (ret != Rosen::DMError::DM_OK) {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::UnRegisterDisplayModeListener failed");
+    }
+    mIsFoldDisplayModeCached = false;
+    mDisplayModeListener = nullptr;
+}
+
+void BrightnessService::SetFoldDisplayMode(Rosen::FoldDisplayMode displayMode)
+{
+    mFoldDisplayMode.store(displayMode);
+}
+
+Rosen::FoldDisplayMode BrightnessService::GetFoldDisplayMode()
+{
+    if (mIsFoldDisplayModeCached) {
+        return mFoldDisplayMode.load();
+    }
+    // Without a registered listener the cache cannot be trusted, ask the display manager directly
+    std::string identity = IPCSkeleton::ResetCallingIdentity();
+    auto foldMode = Rosen::DisplayManagerLite::GetInstance().GetFoldDisplayMode();
+    IPCSkeleton::SetCallingIdentity(identity);
+    return foldMode;
+}
+
 uint32_t BrightnessService::GetDisplayId()
 {
-    return mDisplayId;
+    return ReadState(mDisplayId, &StateSnapshot::displayId);
+}
+
+bool BrightnessService::IsDefaultPipeline() const
+{
+    return mIsDefaultPipeline;
+}
+
+bool BrightnessService::IsFoldDevice()
+{
+    if (mIsFoldDeviceSeeded) {
+        return mIsFoldDevice;
+    }
+    // Not seeded by Init yet, ask the display manager directly instead of treating the device as flat
+    return mIsDefaultPipeline && Rosen::DisplayManagerLite::GetInstance().IsFoldable();
 }
 
 uint32_t BrightnessService::GetCurrentDisplayId(uint32_t defaultId)
 {
     uint32_t currentId = defaultId;
-    bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
-    if (!isFoldable) {
+    if (!IsFoldDevice()) {
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "GetCurrentDisplayId not fold phone return default id=%{public}d", defaultId);
         return currentId;
     }
-    std::string identity = IPCSkeleton::ResetCallingIdentity();
-    auto foldMode = Rosen::DisplayManagerLite::GetInstance().GetFoldDisplayMode();
+    auto foldMode = GetFoldDisplayMode();
     currentId = static_cast<uint32_t>(GetDisplayIdWithDisplayMode(foldMode));
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "GetCurrentDisplayId foldMode=%{public}u", foldMode);
-    IPCSkeleton::SetCallingIdentity(identity);
     return static_cast<uint32_t>(currentId);
 }
 
 void BrightnessService::SetDisplayId(uint32_t displayId)
 {
-    mDisplayId = displayId;
-    if (mAction == nullptr) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::SetDisplayId mAction == nullptr");
-        return;
-    }
-    mAction->SetDisplayId(displayId);
+    RunOnStrand([&] {
+        mDisplayId = displayId;
+        if (mAction == nullptr) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BrightnessService::SetDisplayId mAction == nullptr");
+            return;
+        }
+        mAction->SetDisplayId(displayId);
+    });
 }
 
 uint32_t BrightnessService::GetCurrentSensorId()
 {
-    return mCurrentSensorId;
+    return ReadState(mCurrentSensorId, &StateSnapshot::currentSensorId);
 }
 
 void BrightnessService::SetCurrentSensorId(uint32_t sensorId)
 {
-    mCurrentSensorId = sensorId;
+    RunOnStrand([&] {
+        mCurrentSensorId = sensorId;
+    });
 }
 
-BrightnessService::DimmingCallbackImpl::DimmingCallbackImpl(
+BrightnessService::DimmingCallbackImpl::DimmingCallbackImpl(BrightnessService& owner,
     const std::shared_ptr<BrightnessAction>& action, std::function<void(uint32_t)> callback)
-    : mAction(action), mCallback(callback)
+    : mOwner(owner), mAction(action), mCallback(callback)
 {
 }
 
@@ -270,22 +381,23 @@ void BrightnessService::DimmingCallbackImpl::OnStart()
 
 void BrightnessService::DimmingCallbackImpl::OnChanged(uint32_t currentValue)
 {
-    if (!BrightnessService::Get().IsDimming()) {
+    if (!mOwner.IsDimming()) {
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "OnChanged currentValue=%{public}d already stopDimming, return", currentValue);
         return;
     }
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "OnChanged brightness,mapBrightness=%{public}d", currentValue);
     bool isSuccess = mAction->SetBrightness(currentValue);
     if (isSuccess) {
-        BrightnessService::Get().ReportBrightnessBigData(currentValue);
+        mOwner.ReportBrightnessBigData(currentValue);
+        mOwner.NotifyDeviceBrightnessObserver(currentValue);
     }
-    if (isSuccess && !BrightnessService::Get().IsSleepStatus()) {
-        if (!BrightnessService::Get().IsDimming()) {
+    if (isSuccess && !mOwner.IsSleepStatus()) {
+        if (!mOwner.IsDimming()) {
             DISPLAY_HILOGI(FEAT_BRIGHTNESS, "OnChanged already stopDimming , not update setting brightness");
             return;
         }
         FFRTTask task = [this, currentValue] {
-            auto tmpVal = BrightnessService::Get().GetOrigBrightnessLevel(currentValue);
+            auto tmpVal = BrightnessService::GetOrigBrightnessLevel(currentValue);
             this->mCallback(tmpVal);
         };
         FFRTUtils::SubmitTask(task);
@@ -316,45 +428,53 @@ bool BrightnessService::GetFeatureSupport(BrightnessFeatureType feature)
 
 void BrightnessService::SetDisplayState(uint32_t id, DisplayState state)
 {
-    mState = state;
-    bool isAutoMode = false;
-    bool isScreenOn = IsScreenOnState(state); // depend on state on
-    bool isSettingOn = false;
-    if (isScreenOn) {
-        isSettingOn = IsAutoAdjustBrightness();
-    }
-    isAutoMode = isScreenOn && isSettingOn;
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetDisplayState id=%{public}d, isAutoMode=%{public}d, isScreenOn=%{public}d, "\
-        "isSettingOn=%{public}d, state=%{public}d", id, isAutoMode, isScreenOn, isSettingOn, state);
-#ifdef ENABLE_SENSOR_PART
-    bool isModeChange = StateChangedSetAutoBrightness(isAutoMode);
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetDisplayState id=%{public}d, isAutoMode=%{public}d, isModeChange=%{public}d",
-        id, isAutoMode, isModeChange);
-#endif
-    if (state == DisplayState::DISPLAY_OFF) {
-        if (mIsSleepStatus) {
-            mIsBrightnessOverridden = false;
-            mIsSleepStatus = false;
+    RunOnStrand([&] {
+        mState = state;
+        bool isAutoMode = false;
+        bool isScreenOn = IsScreenOnState(state); // depend on state on
+        bool isSettingOn = false;
+        if (isScreenOn) {
+            isSettingOn = IsAutoAdjustBrightness();
         }
-        mBrightnessTarget.store(0);
-        if (mDimming->IsDimming()) {
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "DISPLAY_OFF StopDimming");
-            mDimming->StopDimming();
+        isAutoMode = isScreenOn && isSettingOn;
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetDisplayState id=%{public}d, isAutoMode=%{public}d, isScreenOn=%{public}d, "\
+            "isSettingOn=%{public}d, state=%{public}d", id, isAutoMode, isScreenOn, isSettingOn, state);
+#ifdef ENABLE_SENSOR_PART
+        if (mIsDefaultPipeline) {
+            bool isModeChange = StateChangedSetAutoBrightness(isAutoMode);
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetDisplayState id=%{public}d, isAutoMode=%{public}d, "\
+                "isModeChange=%{public}d", id, isAutoMode, isModeChange);
         }
-    } else if (state == DisplayState::DISPLAY_DIM) {
-        SetSleepBrightness();
-    } else if (state == DisplayState::DISPLAY_ON) {
-        mIsDisplayOnWhenFirstLuxReport.store(true);
-        if (mIsSleepStatus) {
-            RestoreBrightness(0);
-            mIsSleepStatus = false;
+#endif
+        if (state == DisplayState::DISPLAY_OFF) {
+            if (mIsSleepStatus) {
+                mIsBrightnessOverridden = false;
+                mIsSleepStatus = false;
+            }
+            mBrightnessTarget = 0;
+            if (mDimming->IsDimming()) {
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "DISPLAY_OFF StopDimming");
+                mDimming->StopDimming();
+            }
+            // Persist the last brightness before the device may suspend, without waiting for the write-behind delay
+            if (mIsDefaultPipeline) {
+                FFRTUtils::SubmitTask([] { BrightnessSettingHelper::FlushSettingBrightness(); });
+            }
+        } else if (state == DisplayState::DISPLAY_DIM) {
+            SetSleepBrightness();
+        } else if (state == DisplayState::DISPLAY_ON) {
+            mIsDisplayOnWhenFirstLuxReport = true;
+            if (mIsSleepStatus) {
+                RestoreBrightness(0);
+                mIsSleepStatus = false;
+            }
         }
-    }
+    });
 }
 
 DisplayState BrightnessService::GetDisplayState()
 {
-    return mState;
+    return ReadState(mState, &StateSnapshot::state);
 }
 
 bool BrightnessService::IsScreenOnState(DisplayState state)
@@ -376,7 +496,7 @@ uint32_t BrightnessService::SetLightBrightnessThreshold(
     std::vector<int32_t> threshold, sptr<IDisplayBrightnessCallback> callback)
 {
     uint32_t result = 0;
-    if (threshold.empty() || !callback) {
+    if (!BrightnessThresholdMonitor::Get().Register(threshold, callback)) {
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "BrightnessService::SetLightBrightnessThreshold params verify faild.");
         return result;
     }
@@ -387,73 +507,73 @@ uint32_t BrightnessService::SetLightBrightnessThreshold(
 
 bool BrightnessService::IsSupportLightSensor(void)
 {
-#ifdef ENABLE_SENSOR_PART
-    return mIsSupportLightSensor;
-#else
-    return false;
-#endif
+    return ReadState(mIsSupportLightSensor, &StateSnapshot::isSupportLightSensor);
 }
 
 bool BrightnessService::IsAutoAdjustBrightness(void)
 {
-    return mIsAutoBrightnessEnabled;
+    return ReadState(mIsAutoBrightnessEnabled, &StateSnapshot::isAutoBrightnessEnabled);
 }
 
 #ifdef ENABLE_SENSOR_PART
 bool BrightnessService::AutoAdjustBrightness(bool enable)
 {
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable start, enable=%{public}d, isEnabled=%{public}d, "\
-        "isSupport=%{public}d", enable, mIsAutoBrightnessEnabled, mIsSupportLightSensor);
-    if (!mIsSupportLightSensor) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable not support");
-        SetSettingAutoBrightness(false);
-        return false;
-    }
-    if (enable) {
-        if (mIsAutoBrightnessEnabled) {
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable is already enabled");
-            return true;
+    return RunOnStrand([&] {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable start, enable=%{public}d, isEnabled=%{public}d, "\
+            "isSupport=%{public}d", enable, mIsAutoBrightnessEnabled, mIsSupportLightSensor);
+        if (!mIsSupportLightSensor) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable not support");
+            SetSettingAutoBrightness(false);
+            return false;
         }
-        mIsAutoBrightnessEnabled = true;
-        ActivateValidAmbientSensor();
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable enable");
-    } else {
-        if (!mIsAutoBrightnessEnabled) {
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable is already disabled");
-            return true;
+        if (enable) {
+            if (mIsAutoBrightnessEnabled) {
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable is already enabled");
+                return true;
+            }
+            mIsAutoBrightnessEnabled = true;
+            ActivateValidAmbientSensor();
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable enable");
+        } else {
+            if (!mIsAutoBrightnessEnabled) {
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable is already disabled");
+                return true;
+            }
+            DeactivateAllAmbientSensor();
+            mIsAutoBrightnessEnabled = false;
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable disable");
         }
-        DeactivateAllAmbientSensor();
-        mIsAutoBrightnessEnabled = false;
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetAutoBrightnessEnable disable");
-    }
-    return true;
+        return true;
+    });
 }
 
 bool BrightnessService::StateChangedSetAutoBrightness(bool enable)
 {
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness start, enable=%{public}d, "\
-        "isSensorEnabled=%{public}d, isSupport=%{public}d", enable, mIsLightSensorEnabled, mIsSupportLightSensor);
-    if (!mIsSupportLightSensor) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness not support");
-        SetSettingAutoBrightness(false);
-        return false;
-    }
-    if (enable) {
-        if (IsCurrentSensorEnable()) {
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness is already enabled");
-            return true;
+    return RunOnStrand([&] {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness start, enable=%{public}d, "\
+            "isSensorEnabled=%{public}d, isSupport=%{public}d", enable, mIsLightSensorEnabled, mIsSupportLightSensor);
+        if (!mIsSupportLightSensor) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness not support");
+            SetSettingAutoBrightness(false);
+            return false;
         }
-        ActivateValidAmbientSensor();
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness enable");
-    } else {
-        if (!IsCurrentSensorEnable()) {
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness is already disabled");
-            return true;
+        if (enable) {
+            if (IsCurrentSensorEnable()) {
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness is already enabled");
+                return true;
+            }
+            ActivateValidAmbientSensor();
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness enable");
+        } else {
+            if (!IsCurrentSensorEnable()) {
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness is already disabled");
+                return true;
+            }
+            DeactivateAllAmbientSensor();
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness disable");
         }
-        DeactivateAllAmbientSensor();
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "StateChangedSetAutoBrightness disable");
-    }
-    return true;
+        return true;
+    });
 }
 
 void BrightnessService::InitSensors()
@@ -495,7 +615,9 @@ void BrightnessService::AmbientLightCallback(SensorEvent* event)
         DISPLAY_HILOGE(FEAT_BRIGHTNESS, "AmbientLightData is null");
         return;
     }
-    BrightnessService::Get().ProcessLightLux(data->intensity);
+    // Handed over to the pipeline queue, the sensor thread must not wait for the strand, which may be
+    // unsubscribing the sensor
+    BrightnessService::Get().PostLightLux(data->intensity);
 }
 
 void BrightnessService::ActivateAmbientSensor()
@@ -533,6 +655,7 @@ void BrightnessService::DeactivateAmbientSensor()
     UnsubscribeSensor(SENSOR_TYPE_ID_AMBIENT_LIGHT, &mSensorUser);
     mIsLightSensorEnabled = false;
     mLightLuxManager.ClearLuxData();
+    NotifyLuxObserver(false);
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "DeactivateAmbientSensor");
 }
 
@@ -571,19 +694,18 @@ void BrightnessService::DeactivateAmbientSensor1()
     UnsubscribeSensor(SENSOR_TYPE_ID_AMBIENT_LIGHT1, &mSensorUser1);
     mIsLightSensor1Enabled = false;
     mLightLuxManager.ClearLuxData();
+    NotifyLuxObserver(false);
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "DeactivateAmbientSensor1");
 }
 
 void BrightnessService::ActivateValidAmbientSensor()
 {
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ActivateValidAmbientSensor");
-    bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
-    if (!isFoldable) {
+    if (!IsFoldDevice()) {
         ActivateAmbientSensor();
         return;
     }
-    std::string identity = IPCSkeleton::ResetCallingIdentity();
-    auto foldMode = Rosen::DisplayManagerLite::GetInstance().GetFoldDisplayMode();
+    auto foldMode = GetFoldDisplayMode();
     int sensorId = GetSensorIdWithDisplayMode(foldMode);
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ActivateValidAmbientSensor sensorId=%{public}d, mode=%{public}d",
         sensorId, foldMode);
@@ -592,19 +714,16 @@ void BrightnessService::ActivateValidAmbientSensor()
     } else if (sensorId == SENSOR_TYPE_ID_AMBIENT_LIGHT1) {
         ActivateAmbientSensor1();
     }
-    IPCSkeleton::SetCallingIdentity(identity);
 }
 
 void BrightnessService::DeactivateValidAmbientSensor()
 {
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "DeactivateValidAmbientSensor");
-    bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
-    if (!isFoldable) {
+    if (!IsFoldDevice()) {
         DeactivateAmbientSensor();
         return;
     }
-    std::string identity = IPCSkeleton::ResetCallingIdentity();
-    auto foldMode = Rosen::DisplayManagerLite::GetInstance().GetFoldDisplayMode();
+    auto foldMode = GetFoldDisplayMode();
     int sensorId = GetSensorIdWithDisplayMode(foldMode);
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "DeactivateValidAmbientSensor sensorId=%{public}d, mode=%{public}d",
         sensorId, foldMode);
@@ -613,14 +732,12 @@ void BrightnessService::DeactivateValidAmbientSensor()
     } else if (sensorId == SENSOR_TYPE_ID_AMBIENT_LIGHT1) {
         DeactivateAmbientSensor1();
     }
-    IPCSkeleton::SetCallingIdentity(identity);
 }
 
 void BrightnessService::DeactivateAllAmbientSensor()
 {
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "DeactivateAllAmbientSensor");
-    bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
-    if (!isFoldable) {
+    if (!IsFoldDevice()) {
         DeactivateAmbientSensor();
         return;
     }
@@ -631,39 +748,63 @@ void BrightnessService::DeactivateAllAmbientSensor()
 
 void BrightnessService::ProcessLightLux(float lux)
 {
-    DISPLAY_HILOGD(FEAT_BRIGHTNESS, "ProcessLightLux, lux=%{public}f, mLightLux=%{public}f",
-        lux, mLightLuxManager.GetSmoothedLux());
-    if (!CanSetBrightness()) {
-        if (mIsLuxActiveWithLog) {
-            mIsLuxActiveWithLog = false;
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ProcessLightLux:mIsLuxActiveWithLog=false");
+    RunOnStrand([&] {
+        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "ProcessLightLux, lux=%{public}f, mLightLux=%{public}f",
+            lux, mLightLuxManager.GetSmoothedLux());
+        if (!CanSetBrightness()) {
+            // The lux validity follows the sensor, which stays on while the brightness is overridden or boosted
+            if (mIsLuxActiveWithLog) {
+                mIsLuxActiveWithLog = false;
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ProcessLightLux:mIsLuxActiveWithLog=false");
+            }
+            return;
+        }
+        if (!mIsLuxActiveWithLog) {
+            mIsLuxActiveWithLog = true;
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ProcessLightLux:mIsLuxActiveWithLog=true");
+        }
+        auto& listeners = BrightnessDataListenerRegistry::Get();
+        listeners.Publish(DisplayDataChangeListenerType::LIGHT_OR_BRIGHTNESS_FOR_APS, mDisplayId,
+            BrightnessDataListenerRegistry::FIELD_LUX, lux);
+        if (mIsDefaultPipeline) {
+            BrightnessThresholdMonitor::Get().OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, lux);
+        }
+        bool isNeedUpdateBrightness = mLightLuxManager.IsNeedUpdateBrightness(lux);
+        NotifyLuxObserver(true);
+        if (isNeedUpdateBrightness) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UpdateLightLux, lux=%{public}f, mLightLux=%{public}f, isFirst=%{public}d",
+                lux, mLightLuxManager.GetSmoothedLux(), mLightLuxManager.GetIsFirstLux());
+            listeners.Publish(DisplayDataChangeListenerType::STABLE_LUX, mDisplayId,
+                BrightnessDataListenerRegistry::FIELD_LUX, mLightLuxManager.GetSmoothedLux());
+            UpdateCurrentBrightnessLevel(lux, mLightLuxManager.GetIsFirstLux());
         }
-        return;
-    }
-    if (!mIsLuxActiveWithLog) {
-        mIsLuxActiveWithLog = true;
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ProcessLightLux:mIsLuxActiveWithLog=true");
-    }
-    if (mLightLuxManager.IsNeedUpdateBrightness(lux)) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UpdateLightLux, lux=%{public}f, mLightLux=%{public}f, isFirst=%{public}d",
-            lux, mLightLuxManager.GetSmoothedLux(), mLightLuxManager.GetIsFirstLux());
-        UpdateCurrentBrightnessLevel(lux, mLightLuxManager.GetIsFirstLux());
-    }
 
-    for (int index = 0; index < LUX_LEVEL_LENGTH; index++) {
-        if (static_cast<uint32_t>(lux) < AMBIENT_LUX_LEVELS[index]) {
-            if (index != mLuxLevel || mLightLuxManager.GetIsFirstLux()) {
-                mLuxLevel = index;
-                // Notify ambient lux change event to battery statistics
-                // type:0 auto brightness, 1 manual brightness, 2 window brightness, 3 others
+        for (int index = 0; index < LUX_LEVEL_LENGTH; index++) {
+            if (static_cast<uint32_t>(lux) < AMBIENT_LUX_LEVELS[index]) {
+                if (index != mLuxLevel || mLightLuxManager.GetIsFirstLux()) {
+                    mLuxLevel = index;
+                    // Notify ambient lux change event to battery statistics
+                    // type:0 auto brightness, 1 manual brightness, 2 window brightness, 3 others
 #ifdef HAS_HIVIEWDFX_HISYSEVENT_PART
-                HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::DISPLAY, "AMBIENT_LIGHT",
-                    HiviewDFX::HiSysEvent::EventType::STATISTIC, "LEVEL", mLuxLevel, "TYPE", 0);
+                    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::DISPLAY, "AMBIENT_LIGHT",
+                        HiviewDFX::HiSysEvent::EventType::STATISTIC, "LEVEL", mLuxLevel, "TYPE", 0);
 #endif
+                }
+                break;
             }
-            break;
         }
+    });
+}
+
+void BrightnessService::PostLightLux(float lux)
+{
+    auto queue = queue_;
+    if (queue == nullptr) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "PostLightLux, queue is null");
+        return;
     }
+    FFRTTask task = [this, lux] { ProcessLightLux(lux); };
+    FFRTUtils::SubmitDelayTask(task, 0, queue);
 }
 
 void BrightnessService::UpdateCurrentBrightnessLevel(float lux, bool isFastDuration)
@@ -679,28 +820,31 @@ void BrightnessService::UpdateCurrentBrightnessLevel(float lux, bool isFastDurat
         }
         if (isFastDuration && mIsDisplayOnWhenFirstLuxReport) {
             duration = 0;
-            mIsDisplayOnWhenFirstLuxReport.store(false);
+            mIsDisplayOnWhenFirstLuxReport = false;
         }
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UpdateCurrentBrightnessLevel lux=%{public}f, mBrightnessLevel=%{public}d, "\
             "brightnessLevel=%{public}d, duration=%{public}d", lux, mBrightnessLevel, brightnessLevel, duration);
         mBrightnessLevel = brightnessLevel;
-        mCurrentBrightness.store(brightnessLevel);
+        mCurrentBrightness = brightnessLevel;
         if (mWaitForFirstLux) {
-            std::lock_guard<std::mutex> lock(mFirstLuxHandleLock);
-            FFRT_CANCEL(g_waitForFirstLuxTaskHandle, queue_);
+            FFRT_CANCEL(mWaitForFirstLuxTaskHandle, queue_);
             mWaitForFirstLux = false;
+            DisplayTraceRecorder::Get().Record(GetDisplayId(), DisplayTraceEvent::FIRST_LUX,
+                static_cast<uint32_t>(lux), brightnessLevel);
             DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UpdateCurrentBrightnessLevel CancelScreenOn waitforFisrtLux Task");
         }
-        mBrightnessTarget.store(brightnessLevel);
+        mBrightnessTarget = brightnessLevel;
         SetBrightnessLevel(brightnessLevel, duration);
     }
 }
 
 void BrightnessService::SetBrightnessLevel(uint32_t value, uint32_t duration)
 {
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetBrightnessLevel value=%{public}d, duration=%{public}d",
-        value, duration);
-    UpdateBrightness(value, duration, true);
+    RunOnStrand([&] {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetBrightnessLevel value=%{public}d, duration=%{public}d",
+            value, duration);
+        UpdateBrightness(value, duration, true);
+    });
 }
 
 uint32_t BrightnessService::GetBrightnessLevel(float lux)
@@ -734,71 +878,82 @@ bool BrightnessService::SetForcedBrightness(double value, uint32_t duration, Bri
 
 bool BrightnessService::SetBrightness(uint32_t value, uint32_t gradualDuration, bool continuous)
 {
-    DISPLAY_HILOGD(FEAT_BRIGHTNESS, "SetBrightness val=%{public}u, duration=%{public}u", value, gradualDuration);
-    if (IsBrightnessOverridden()) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ForceExitOverriddenMode brightness=%{public}u", value);
-        mIsBrightnessOverridden = false;
-    } else if (!CanSetBrightness()) {
-        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot set brightness, ignore the change");
-        mCachedSettingBrightness = value;
-        return false;
-    }
-    if (gradualDuration == 0) {
-        bool isSettingOn = IsAutoAdjustBrightness();
-        if (isSettingOn && IsCurrentSensorEnable()) {
-            mIsUserMode = true;
-            mBrightnessCalculationManager.UpdateBrightnessOffset(value, mLightLuxManager.GetSmoothedLux());
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UpdateBrightnessOffset level=%{public}d, mLightLux=%{public}f",
-                value, mLightLuxManager.GetSmoothedLux());
+    return RunOnStrand([&] {
+        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "SetBrightness val=%{public}u, duration=%{public}u", value, gradualDuration);
+        if (IsBrightnessOverridden()) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ForceExitOverriddenMode brightness=%{public}u", value);
+            mIsBrightnessOverridden = false;
+        } else if (!CanSetBrightness()) {
+            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot set brightness, ignore the change");
+            mCachedSettingBrightness = value;
+            return false;
         }
-    }
-    mBrightnessTarget.store(value);
-    mCurrentBrightness.store(value);
-    bool isSuccess = UpdateBrightness(value, gradualDuration, !continuous);
-    DISPLAY_HILOGD(FEAT_BRIGHTNESS, "SetBrightness val=%{public}d, isSuccess=%{public}d", value, isSuccess);
-    mIsUserMode = false;
-    return isSuccess;
+        if (gradualDuration == 0) {
+            bool isSettingOn = IsAutoAdjustBrightness();
+            if (isSettingOn && IsCurrentSensorEnable()) {
+                mIsUserMode = true;
+                mBrightnessCalculationManager.UpdateBrightnessOffset(value, mLightLuxManager.GetSmoothedLux());
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "UpdateBrightnessOffset level=%{public}d, mLightLux=%{public}f",
+                    value, mLightLuxManager.GetSmoothedLux());
+            }
+        }
+        mBrightnessTarget = value;
+        mCurrentBrightness = value;
+        bool isSuccess = UpdateBrightness(value, gradualDuration, !continuous);
+        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "SetBrightness val=%{public}d, isSuccess=%{public}d", value, isSuccess);
+        mIsUserMode = false;
+        return isSuccess;
+    });
 }
 
 void BrightnessService::SetScreenOnBrightness()
 {
-    uint32_t screenOnBrightness = GetScreenOnBrightness(true);
-    if (mWaitForFirstLux) {
-        std::lock_guard<std::mutex> lock(mFirstLuxHandleLock);
-        if (queue_ == nullptr) {
-            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "SetScreenOnBrightness, queue is null");
-        } else {
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetScreenOnBrightness waitForFirstLux");
-            FFRT_CANCEL(g_waitForFirstLuxTaskHandle, queue_);
-            screenOnBrightness = mCachedSettingBrightness;
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetScreenOnBrightness waitForFirstLux,GetSettingBrightness=%{public}d",
-                screenOnBrightness);
-            FFRTTask setBrightnessTask = [this, screenOnBrightness] {
-                this->UpdateBrightness(screenOnBrightness, 0, true);
-            };
-            g_waitForFirstLuxTaskHandle = FFRTUtils::SubmitDelayTask(setBrightnessTask, WAIT_FOR_FIRST_LUX_MAX_TIME,
-                queue_);
+    RunOnStrand([&] {
+        uint32_t screenOnBrightness = GetScreenOnBrightness(true);
+        if (mWaitForFirstLux) {
+            if (queue_ == nullptr) {
+                DISPLAY_HILOGW(FEAT_BRIGHTNESS, "SetScreenOnBrightness, queue is null");
+            } else {
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetScreenOnBrightness waitForFirstLux");
+                FFRT_CANCEL(mWaitForFirstLuxTaskHandle, queue_);
+                screenOnBrightness = mCachedSettingBrightness;
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS,
+                    "SetScreenOnBrightness waitForFirstLux,GetSettingBrightness=%{public}d", screenOnBrightness);
+                FFRTTask setBrightnessTask = [this, screenOnBrightness] {
+                    RunOnStrand([this, screenOnBrightness] {
+                        DisplayTraceRecorder::Get().Record(GetDisplayId(), DisplayTraceEvent::FIRST_LUX_TIMEOUT,
+                            screenOnBrightness);
+                        UpdateBrightness(screenOnBrightness, 0, true);
+                    });
+                };
+                DisplayTraceRecorder::Get().Record(GetDisplayId(), DisplayTraceEvent::FIRST_LUX_WAIT,
+                    screenOnBrightness, WAIT_FOR_FIRST_LUX_MAX_TIME);
+                mWaitForFirstLuxTaskHandle = FFRTUtils::SubmitDelayTask(setBrightnessTask,
+                    WAIT_FOR_FIRST_LUX_MAX_TIME, queue_);
+            }
+            return;
         }
-        return;
-    }
-    bool needUpdateBrightness = true;
-    if (IsBrightnessBoosted() || IsBrightnessOverridden()) {
-        needUpdateBrightness = false;
-    }
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetScreenOnBrightness screenOnBrightness=%{public}d, needUpdate=%{public}d",
-        screenOnBrightness, needUpdateBrightness);
-    UpdateBrightness(screenOnBrightness, 0, needUpdateBrightness);
+        bool needUpdateBrightness = true;
+        if (IsBrightnessBoosted() || IsBrightnessOverridden()) {
+            needUpdateBrightness = false;
+        }
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetScreenOnBrightness screenOnBrightness=%{public}d, needUpdate=%{public}d",
+            screenOnBrightness, needUpdateBrightness);
+        UpdateBrightness(screenOnBrightness, 0, needUpdateBrightness);
+    });
 }
 
 void BrightnessService::ClearOffset()
 {
-    if (mDimming->IsDimming()) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "mode off StopDimming");
-        mDimming->StopDimming();
-    }
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ClearOffset mLightLux=%{public}f", mLightLuxManager.GetSmoothedLux());
-    mBrightnessTarget.store(0);
-    mBrightnessCalculationManager.UpdateBrightnessOffset(0, mLightLuxManager.GetSmoothedLux());
+    RunOnStrand([&] {
+        if (mDimming->IsDimming()) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "mode off StopDimming");
+            mDimming->StopDimming();
+        }
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ClearOffset mLightLux=%{public}f", mLightLuxManager.GetSmoothedLux());
+        mBrightnessTarget = 0;
+        mBrightnessCalculationManager.UpdateBrightnessOffset(0, mLightLuxManager.GetSmoothedLux());
+    });
 }
 
 uint32_t BrightnessService::GetBrightness()
@@ -824,128 +979,141 @@ void BrightnessService::WaitDimmingDone() const
 
 uint32_t BrightnessService::GetCachedSettingBrightness()
 {
-    return mCachedSettingBrightness;
+    return ReadState(mCachedSettingBrightness, &StateSnapshot::cachedSettingBrightness);
 }
 
 bool BrightnessService::DiscountBrightness(double discount, uint32_t gradualDuration)
 {
-    if (!CanDiscountBrightness()) {
-        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot discount brightness, ignore the change");
-        return false;
-    }
-    auto safeDiscount = discount;
-    if (safeDiscount > DISCOUNT_MAX) {
-        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "discount value is greater than max, discount=%{public}f", discount);
-        safeDiscount = DISCOUNT_MAX;
-    }
-    if (safeDiscount < DISCOUNT_MIN) {
-        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "discount value is less than min, discount=%{public}f", discount);
-        safeDiscount = DISCOUNT_MIN;
-    }
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Discount brightness, safeDiscount=%{public}f", safeDiscount);
-    mDiscount = safeDiscount;
-    if (mDimmingCallback) {
-        mDimmingCallback->DiscountBrightness(safeDiscount);
-    }
-    uint32_t screenOnBrightness = GetScreenOnBrightness(false);
-    return UpdateBrightness(screenOnBrightness, gradualDuration);
+    return RunOnStrand([&] {
+        if (!CanDiscountBrightness()) {
+            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot discount brightness, ignore the change");
+            return false;
+        }
+        auto safeDiscount = discount;
+        if (safeDiscount > DISCOUNT_MAX) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "discount value is greater than max, discount=%{public}f", discount);
+            safeDiscount = DISCOUNT_MAX;
+        }
+        if (safeDiscount < DISCOUNT_MIN) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "discount value is less than min, discount=%{public}f", discount);
+            safeDiscount = DISCOUNT_MIN;
+        }
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Discount brightness, safeDiscount=%{public}f", safeDiscount);
+        mDiscount = safeDiscount;
+        if (mDimmingCallback) {
+            mDimmingCallback->DiscountBrightness(safeDiscount);
+        }
+        uint32_t screenOnBrightness = GetScreenOnBrightness(false);
+        return UpdateBrightness(screenOnBrightness, gradualDuration);
+    });
 }
 
 void BrightnessService::SetSleepBrightness()
 {
-    uint32_t value = GetSettingBrightness();
-    if (value <= MIN_DEFAULT_BRGIHTNESS_LEVEL) {
-        return;
-    }
-    uint32_t sleepBrightness = BrightnessParamHelper::GetSleepBrightness();
-    uint32_t sleepMinumumReductionBrightness = BrightnessParamHelper::GetSleepMinumumReductionBrightness();
-    if (value < sleepMinumumReductionBrightness) {
-        value = sleepMinumumReductionBrightness;
-    }
-    uint32_t enterSleepBrightness = std::max(std::min(value - sleepMinumumReductionBrightness, sleepBrightness),
-        MIN_DEFAULT_BRGIHTNESS_LEVEL);
-    uint32_t sleepDarkenTime = BrightnessParamHelper::GetSleepDarkenTime();
-    mIsSleepStatus = true;
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetSleepBrightness enterSleepBrightness=%{public}d, sleepDarkenTime=%{public}d",
-        enterSleepBrightness, sleepDarkenTime);
-    OverrideBrightness(enterSleepBrightness, sleepDarkenTime);
+    RunOnStrand([&] {
+        uint32_t value = GetSettingBrightness();
+        if (value <= MIN_DEFAULT_BRGIHTNESS_LEVEL) {
+            return;
+        }
+        uint32_t sleepBrightness = BrightnessParamHelper::GetSleepBrightness();
+        uint32_t sleepMinumumReductionBrightness = BrightnessParamHelper::GetSleepMinumumReductionBrightness();
+        if (value < sleepMinumumReductionBrightness) {
+            value = sleepMinumumReductionBrightness;
+        }
+        uint32_t enterSleepBrightness = std::max(std::min(value - sleepMinumumReductionBrightness, sleepBrightness),
+            MIN_DEFAULT_BRGIHTNESS_LEVEL);
+        uint32_t sleepDarkenTime = BrightnessParamHelper::GetSleepDarkenTime();
+        mIsSleepStatus = true;
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS,
+            "SetSleepBrightness enterSleepBrightness=%{public}d, sleepDarkenTime=%{public}d",
+            enterSleepBrightness, sleepDarkenTime);
+        OverrideBrightness(enterSleepBrightness, sleepDarkenTime);
+    });
 }
 
 bool BrightnessService::OverrideBrightness(uint32_t value, uint32_t gradualDuration)
 {
-    if (!CanOverrideBrightness()) {
-        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot override brightness, ignore the change");
-        return false;
-    }
-    if (!mIsBrightnessOverridden) {
-        mIsBrightnessOverridden = true;
-    }
-    mOverriddenBrightness = value;
-    mBeforeOverriddenBrightness = GetSettingBrightness();
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Override brightness, value=%{public}u, mBeforeOverriddenBrightness=%{public}d",
-        value, mBeforeOverriddenBrightness);
-    return UpdateBrightness(value, gradualDuration);
+    return RunOnStrand([&] {
+        if (!CanOverrideBrightness()) {
+            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot override brightness, ignore the change");
+            return false;
+        }
+        if (!mIsBrightnessOverridden) {
+            mIsBrightnessOverridden = true;
+        }
+        mOverriddenBrightness = value;
+        mBeforeOverriddenBrightness = GetSettingBrightness();
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Override brightness, value=%{public}u, mBeforeOverriddenBrightness=%{public}d",
+            value, mBeforeOverriddenBrightness);
+        return UpdateBrightness(value, gradualDuration);
+    });
 }
 
 bool BrightnessService::RestoreBrightness(uint32_t gradualDuration)
 {
-    if (!IsBrightnessOverridden()) {
-        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is not override, no need to restore");
-        return false;
-    }
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "restore brightness=%{public}d", mBeforeOverriddenBrightness);
-    mIsBrightnessOverridden = false;
-    return UpdateBrightness(mBeforeOverriddenBrightness, gradualDuration, true);
+    return RunOnStrand([&] {
+        if (!IsBrightnessOverridden()) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is not override, no need to restore");
+            return false;
+        }
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "restore brightness=%{public}d", mBeforeOverriddenBrightness);
+        mIsBrightnessOverridden = false;
+        return UpdateBrightness(mBeforeOverriddenBrightness, gradualDuration, true);
+    });
 }
 
 bool BrightnessService::IsBrightnessOverridden()
 {
-    return mIsBrightnessOverridden;
+    return ReadState(mIsBrightnessOverridden, &StateSnapshot::isBrightnessOverridden);
 }
 
 bool BrightnessService::BoostBrightness(uint32_t timeoutMs, uint32_t gradualDuration)
 {
-    if (!CanBoostBrightness() || queue_ == nullptr) {
-        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot boost brightness, ignore the change");
-        return false;
-    }
-    bool isSuccess = true;
-    if (!mIsBrightnessBoosted) {
-        uint32_t maxBrightness = BrightnessParamHelper::GetMaxBrightness();
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Boost brightness, maxBrightness: %{public}d", maxBrightness);
-        mIsBrightnessBoosted = true;
-        isSuccess = UpdateBrightness(maxBrightness, gradualDuration);
-    }
+    return RunOnStrand([&] {
+        if (!CanBoostBrightness() || queue_ == nullptr) {
+            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Cannot boost brightness, ignore the change");
+            return false;
+        }
+        bool isSuccess = true;
+        if (!mIsBrightnessBoosted) {
+            uint32_t maxBrightness = BrightnessParamHelper::GetMaxBrightness();
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Boost brightness, maxBrightness: %{public}d", maxBrightness);
+            mIsBrightnessBoosted = true;
+            isSuccess = UpdateBrightness(maxBrightness, gradualDuration);
+        }
 
-    // If boost multi-times, we will resend the cancel boost event.
-    FFRT_CANCEL(g_cancelBoostTaskHandle, queue_);
-    FFRTTask task = [this, gradualDuration] { this->CancelBoostBrightness(gradualDuration); };
-    g_cancelBoostTaskHandle = FFRTUtils::SubmitDelayTask(task, timeoutMs, queue_);
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BoostBrightness update timeout=%{public}u, isSuccess=%{public}d", timeoutMs,
-        isSuccess);
-    return isSuccess;
+        // If boost multi-times, we will resend the cancel boost event.
+        FFRT_CANCEL(mCancelBoostTaskHandle, queue_);
+        FFRTTask task = [this, gradualDuration] { this->CancelBoostBrightness(gradualDuration); };
+        mCancelBoostTaskHandle = FFRTUtils::SubmitDelayTask(task, timeoutMs, queue_);
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "BoostBrightness update timeout=%{public}u, isSuccess=%{public}d", timeoutMs,
+            isSuccess);
+        return isSuccess;
+    });
 }
 
 bool BrightnessService::CancelBoostBrightness(uint32_t gradualDuration)
 {
-    DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Cancel boost brightness");
-    if (!IsBrightnessBoosted() || queue_ == nullptr) {
-        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is not boost, no need to restore");
-        return false;
-    }
-    FFRT_CANCEL(g_cancelBoostTaskHandle, queue_);
-    mIsBrightnessBoosted = false;
-    return UpdateBrightness(mCachedSettingBrightness, gradualDuration, true);
+    return RunOnStrand([&] {
+        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Cancel boost brightness");
+        if (!IsBrightnessBoosted() || queue_ == nullptr) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is not boost, no need to restore");
+            return false;
+        }
+        FFRT_CANCEL(mCancelBoostTaskHandle, queue_);
+        mIsBrightnessBoosted = false;
+        return UpdateBrightness(mCachedSettingBrightness, gradualDuration, true);
+    });
 }
 
 bool BrightnessService::IsBrightnessBoosted()
 {
-    return mIsBrightnessBoosted;
+    return ReadState(mIsBrightnessBoosted, &StateSnapshot::isBrightnessBoosted);
 }
 
 bool BrightnessService::IsScreenOn()
 {
-    return (mState == DisplayState::DISPLAY_ON || mState == DisplayState::DISPLAY_DIM);
+    return IsScreenOnState(GetDisplayState());
 }
 
 bool BrightnessService::CanSetBrightness()
@@ -977,6 +1145,16 @@ bool BrightnessService::UpdateBrightness(uint32_t value, uint32_t gradualDuratio
 {
     DISPLAY_HILOGD(FEAT_BRIGHTNESS, "UpdateBrightness, value=%{public}u, discount=%{public}f,"\
         "duration=%{public}u, updateSetting=%{public}d", value, mDiscount, gradualDuration, updateSetting);
+    if (mIsBatching) {
+        // A superseded write still owes its setting update, the device only sees the last value
+        if (mHasPendingBrightness && mPendingBrightness.updateSetting && !updateSetting) {
+            auto settingBrightness = GetSafeBrightness(mPendingBrightness.value);
+            FFRTUtils::SubmitTask([this, settingBrightness] { this->SetSettingBrightness(settingBrightness); });
+        }
+        mPendingBrightness = {value, gradualDuration, updateSetting};
+        mHasPendingBrightness = true;
+        return true;
+    }
     mWaitForFirstLux = false;
     auto safeBrightness = GetSafeBrightness(value);
     if (mDimming->IsDimming()) {
@@ -987,6 +1165,8 @@ bool BrightnessService::UpdateBrightness(uint32_t value, uint32_t gradualDuratio
     brightness = GetMappingBrightnessLevel(brightness);
     if (gradualDuration > 0) {
         mDimming->StartDimming(GetSettingBrightness(), brightness, gradualDuration);
+        BrightnessDataListenerRegistry::Get().Publish(DisplayDataChangeListenerType::BRIGHTNESS_TARGET, mDisplayId,
+            BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, safeBrightness);
         return true;
     }
     bool isSuccess = mAction->SetBrightness(brightness);
@@ -998,12 +1178,19 @@ bool BrightnessService::UpdateBrightness(uint32_t value, uint32_t gradualDuratio
     }
     if (isSuccess) {
         ReportBrightnessBigData(brightness);
+        NotifyDeviceBrightnessObserver(brightness);
+        BrightnessDataListenerRegistry::Get().Publish(DisplayDataChangeListenerType::BRIGHTNESS_TARGET, mDisplayId,
+            BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, safeBrightness);
     }
     return isSuccess;
 }
 
 uint32_t BrightnessService::GetSettingBrightness(const std::string& key)
 {
+    if (!mIsDefaultPipeline) {
+        // The setting store only holds the brightness of the default pipeline
+        return GetCachedSettingBrightness();
+    }
     uint32_t settingBrightness = DEFAULT_BRIGHTNESS;
     auto isSuccess = BrightnessSettingHelper::GetSettingBrightness(settingBrightness, key);
     if (isSuccess != ERR_OK) {
@@ -1017,34 +1204,177 @@ uint32_t BrightnessService::GetSettingBrightness(const std::string& key)
 
 void BrightnessService::SetSettingBrightness(uint32_t value)
 {
-    BrightnessSettingHelper::SetSettingBrightness(value);
-    mBrightnessLevel = value;
-    mCachedSettingBrightness = value;
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetSettingBrightness brightness=%{public}u", value);
+    RunOnStrand([&] {
+        if (mIsDefaultPipeline) {
+            BrightnessSettingHelper::SetSettingBrightness(value);
+        }
+        mBrightnessLevel = value;
+        mCachedSettingBrightness = value;
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetSettingBrightness brightness=%{public}u", value);
+        SetObservedSettingBrightness(value);
+    });
+}
+
+void BrightnessService::SetObservedSettingBrightness(uint32_t value)
+{
+    mPublishedSettingBrightness.store(value);
+    mIsPublishedSettingValid.store(true);
+    NotifyChangeObserver();
+}
+
+void BrightnessService::SetChangeObserver(std::function<void()> observer)
+{
+    std::shared_ptr<const std::function<void()>> next;
+    if (observer) {
+        next = std::make_shared<const std::function<void()>>(std::move(observer));
+    }
+    std::atomic_store(&changeObserver, std::move(next));
+}
+
+void BrightnessService::NotifyChangeObserver()
+{
+    auto observer = std::atomic_load(&changeObserver);
+    if (observer != nullptr) {
+        (*observer)();
+    }
+}
+
+BrightnessService::PublishedState BrightnessService::GetPublishedState() const
+{
+    StateSnapshot snapshot = GetStateSnapshot();
+    PublishedState state;
+    state.settingBrightness = mPublishedSettingBrightness.load();
+    state.deviceBrightness = mPublishedDeviceBrightness.load();
+    state.deviceBrightnessHbm = mPublishedDeviceBrightnessHbm.load();
+    state.discount = snapshot.discount;
+    state.isSettingBrightnessValid = mIsPublishedSettingValid.load();
+    state.isDeviceBrightnessValid = mIsPublishedDeviceValid.load();
+    state.isAutoBrightnessEnabled = snapshot.isAutoBrightnessEnabled;
+    state.isBrightnessOverridden = snapshot.isBrightnessOverridden;
+    state.isBrightnessBoosted = snapshot.isBrightnessBoosted;
+    return state;
+}
+
+void BrightnessService::SetLuxObserver(std::function<void(bool, float, float, float)> luxObserver)
+{
+    RunOnStrand([&] { mLuxObserver = std::move(luxObserver); });
+}
+
+void BrightnessService::NotifyLuxObserver(bool isValid)
+{
+    if (mLuxObserver) {
+        mLuxObserver(isValid, mLightLuxManager.GetLux(), mLightLuxManager.GetFilteredLux(),
+            mLightLuxManager.GetSmoothedLux());
+    }
+}
+
+void BrightnessService::BeginBrightnessBatch()
+{
+    RunOnStrand([&] {
+        mIsBatching = true;
+        mHasPendingBrightness = false;
+    });
+}
+
+bool BrightnessService::EndBrightnessBatch()
+{
+    return RunOnStrand([&] {
+        mIsBatching = false;
+        if (!mHasPendingBrightness) {
+            return true;
+        }
+        mHasPendingBrightness = false;
+        PendingBrightness pending = mPendingBrightness;
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "EndBrightnessBatch value=%{public}u, duration=%{public}u",
+            pending.value, pending.gradualDuration);
+        return UpdateBrightness(pending.value, pending.gradualDuration, pending.updateSetting);
+    });
+}
+
+BrightnessService::StateSnapshot BrightnessService::GetStateSnapshot() const
+{
+    return mStrand.IsCurrent() ? MakeSnapshot() : mSnapshot.Load();
+}
+
+BrightnessService::StateSnapshot BrightnessService::MakeSnapshot() const
+{
+    StateSnapshot snapshot;
+    snapshot.state = mState;
+    snapshot.displayId = mDisplayId;
+    snapshot.currentSensorId = mCurrentSensorId;
+    snapshot.brightnessLevel = mBrightnessLevel;
+    snapshot.brightnessTarget = mBrightnessTarget;
+    snapshot.cachedSettingBrightness = mCachedSettingBrightness;
+    snapshot.overriddenBrightness = mOverriddenBrightness;
+    snapshot.luxLevel = mLuxLevel;
+    snapshot.discount = mDiscount;
+    snapshot.isSupportLightSensor = mIsSupportLightSensor;
+    snapshot.isAutoBrightnessEnabled = mIsAutoBrightnessEnabled;
+    snapshot.isBrightnessOverridden = mIsBrightnessOverridden;
+    snapshot.isBrightnessBoosted = mIsBrightnessBoosted;
+    snapshot.isSleepStatus = mIsSleepStatus;
+    snapshot.isUserMode = mIsUserMode;
+    return snapshot;
+}
+
+void BrightnessService::PublishSnapshot()
+{
+    StateSnapshot previous = mSnapshot.Load();
+    StateSnapshot current = MakeSnapshot();
+    mSnapshot.Store(current);
+    // Also covers the tasks no caller waits for, such as the boost timeout
+    if (current.discount != previous.discount ||
+        current.isAutoBrightnessEnabled != previous.isAutoBrightnessEnabled ||
+        current.isBrightnessOverridden != previous.isBrightnessOverridden ||
+        current.isBrightnessBoosted != previous.isBrightnessBoosted) {
+        NotifyChangeObserver();
+    }
+}
+
+void BrightnessService::NotifyDeviceBrightnessObserver(uint32_t level)
+{
+    uint32_t origLevel = GetOrigBrightnessLevel(level);
+    // Every device write, dimming steps included, which run off the strand
+    mPublishedDeviceBrightnessHbm.store(level);
+    mPublishedDeviceBrightness.store(origLevel);
+    mIsPublishedDeviceValid.store(true);
+    NotifyChangeObserver();
+    uint32_t displayId = GetDisplayId();
+    auto& listeners = BrightnessDataListenerRegistry::Get();
+    listeners.Publish(DisplayDataChangeListenerType::BRIGHTNESS_FOR_UI, displayId,
+        BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, origLevel);
+    listeners.Publish(DisplayDataChangeListenerType::LIGHT_OR_BRIGHTNESS_FOR_APS, displayId,
+        BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, origLevel);
+    // The thresholds carry no display id and watch the default display, other displays would interleave samples
+    if (mIsDefaultPipeline) {
+        BrightnessThresholdMonitor::Get().OnSample(BrightnessThresholdMonitor::TYPE_BRIGHTNESS, origLevel);
+    }
 }
 
 uint32_t BrightnessService::GetScreenOnBrightness(bool isUpdateTarget)
 {
-    uint32_t screenOnbrightness;
-    if (IsBrightnessBoosted()) {
-        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is boosted, return max brightness");
-        screenOnbrightness = BrightnessParamHelper::GetMaxBrightness();
-    } else if (IsBrightnessOverridden()) {
-        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is overridden, return overridden brightness=%{public}u",
-            mOverriddenBrightness);
-        screenOnbrightness = mOverriddenBrightness;
-    } else if (isUpdateTarget && mIsAutoBrightnessEnabled) {
-        if (mBrightnessTarget.load() > 0) {
-            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "update, return mBrightnessTarget=%{public}d", mBrightnessTarget.load());
-            screenOnbrightness = mBrightnessTarget.load();
+    return RunOnStrand([&] {
+        uint32_t screenOnbrightness;
+        if (IsBrightnessBoosted()) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is boosted, return max brightness");
+            screenOnbrightness = BrightnessParamHelper::GetMaxBrightness();
+        } else if (IsBrightnessOverridden()) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Brightness is overridden, return overridden brightness=%{public}u",
+                mOverriddenBrightness);
+            screenOnbrightness = mOverriddenBrightness;
+        } else if (isUpdateTarget && mIsAutoBrightnessEnabled) {
+            if (mBrightnessTarget > 0) {
+                DISPLAY_HILOGI(FEAT_BRIGHTNESS, "update, return mBrightnessTarget=%{public}d", mBrightnessTarget);
+                screenOnbrightness = mBrightnessTarget;
+            } else {
+                screenOnbrightness = 0;
+                mWaitForFirstLux = true;
+            }
         } else {
-            screenOnbrightness = 0;
-            mWaitForFirstLux = true;
+            screenOnbrightness = GetSettingBrightness();
         }
-    } else {
-        screenOnbrightness = GetSettingBrightness();
-    }
-    return screenOnbrightness;
+        return screenOnbrightness;
+    });
 }
 
 void BrightnessService::RegisterSettingBrightnessObserver()
@@ -1062,7 +1392,7 @@ void BrightnessService::UnregisterSettingBrightnessObserver()
 
 double BrightnessService::GetDiscount() const
 {
-    return mDiscount;
+    return ReadState(mDiscount, &StateSnapshot::discount);
 }
 
 uint32_t BrightnessService::GetDimmingUpdateTime() const
@@ -1160,13 +1490,15 @@ bool BrightnessService::IsDimming()
 
 std::string BrightnessService::GetReason()
 {
-    if (mIsBrightnessOverridden) {
+    // Also called from the dimming steps, which run off the strand
+    StateSnapshot snapshot = GetStateSnapshot();
+    if (snapshot.isBrightnessOverridden) {
         return "APP";
     }
-    if (mIsUserMode) {
+    if (snapshot.isUserMode) {
         return "USER";
     }
-    if (mIsAutoBrightnessEnabled) {
+    if (snapshot.isAutoBrightnessEnabled) {
         return "AUTO";
     }
     return "MANUAL";
@@ -1187,30 +1519,26 @@ void BrightnessService::ReportBrightnessBigData(uint32_t brightness)
 
 bool BrightnessService::IsSleepStatus()
 {
-    return mIsSleepStatus;
+    return ReadState(mIsSleepStatus, &StateSnapshot::isSleepStatus);
 }
 
 bool BrightnessService::GetIsSupportLightSensor()
 {
-    return mIsSupportLightSensor;
+    return IsSupportLightSensor();
 }
 
 bool BrightnessService::IsCurrentSensorEnable()
 {
-    bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
-    if (!isFoldable) {
+    if (!IsFoldDevice()) {
         return mIsLightSensorEnabled;
     }
     bool result = false;
-    std::string identity = IPCSkeleton::ResetCallingIdentity();
-    auto foldMode = Rosen::DisplayManagerLite::GetInstance().GetFoldDisplayMode();
-    int sensorId = GetSensorIdWithDisplayMode(foldMode);
+    int sensorId = GetSensorIdWithDisplayMode(GetFoldDisplayMode());
     if (sensorId == SENSOR_TYPE_ID_AMBIENT_LIGHT) {
         result = mIsLightSensorEnabled;
     } else if (sensorId == SENSOR_TYPE_ID_AMBIENT_LIGHT1) {
         result = mIsLightSensor1Enabled;
     }
-    IPCSkeleton::SetCallingIdentity(identity);
     return result;
 }
 
@@ -1236,51 +1564,55 @@ int BrightnessService::GetSensorIdWithDisplayMode(Rosen::FoldDisplayMode mode)
 
 bool BrightnessService::SetMaxBrightness(double value)
 {
-    uint32_t maxValue = static_cast<uint32_t>(std::round(value * MAX_DEFAULT_BRGIHTNESS_LEVEL));
-    if (maxValue == 0 || value < 0) {
-        maxValue = brightnessValueMin;
-    }
-    if (maxValue == brightnessValueMax) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness value=oldMax");
-        return true;
-    }
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness value=%{public}u, oldMax=%{public}u",
-        maxValue, brightnessValueMax);
-    brightnessValueMax =
-        (maxValue > MAX_DEFAULT_BRGIHTNESS_LEVEL ? MAX_DEFAULT_BRGIHTNESS_LEVEL : maxValue);
-    uint32_t currentBrightness = GetSettingBrightness();
-    if (brightnessValueMax < currentBrightness) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness currentBrightness=%{public}u", currentBrightness);
-        return UpdateBrightness(brightnessValueMax, DEFAULT_MAX_BRIGHTNESS_DURATION, true);
-    }
-    if (mCurrentBrightness.load() == 0) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "No need to update brightne during init");
-        return true;
-    }
-    return UpdateBrightness(mCurrentBrightness.load(), DEFAULT_MAX_BRIGHTNESS_DURATION, true);
+    return RunOnStrand([&] {
+        uint32_t maxValue = static_cast<uint32_t>(std::round(value * MAX_DEFAULT_BRGIHTNESS_LEVEL));
+        if (maxValue == 0 || value < 0) {
+            maxValue = brightnessValueMin;
+        }
+        if (maxValue == brightnessValueMax) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness value=oldMax");
+            return true;
+        }
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness value=%{public}u, oldMax=%{public}u",
+            maxValue, brightnessValueMax.load());
+        brightnessValueMax =
+            (maxValue > MAX_DEFAULT_BRGIHTNESS_LEVEL ? MAX_DEFAULT_BRGIHTNESS_LEVEL : maxValue);
+        uint32_t currentBrightness = GetSettingBrightness();
+        if (brightnessValueMax < currentBrightness) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness currentBrightness=%{public}u", currentBrightness);
+            return UpdateBrightness(brightnessValueMax, DEFAULT_MAX_BRIGHTNESS_DURATION, true);
+        }
+        if (mCurrentBrightness == 0) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "No need to update brightne during init");
+            return true;
+        }
+        return UpdateBrightness(mCurrentBrightness, DEFAULT_MAX_BRIGHTNESS_DURATION, true);
+    });
 }
 
 bool BrightnessService::SetMaxBrightnessNit(uint32_t maxNit)
 {
-    uint32_t max_value = GetBrightnessLevelFromNit(maxNit);
-    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightnessNit nitIn=%{public}u, levelOut=%{public}u",
-        maxNit, max_value);
-    if (max_value == brightnessValueMax) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness value=oldMax");
-        return true;
-    }
-    brightnessValueMax =
-        (max_value > MAX_DEFAULT_BRGIHTNESS_LEVEL ? MAX_DEFAULT_BRGIHTNESS_LEVEL : max_value);
-    uint32_t currentBrightness = GetSettingBrightness();
-    if (brightnessValueMax < currentBrightness) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightnessNit currentBrightness=%{public}u", currentBrightness);
-        return UpdateBrightness(brightnessValueMax, DEFAULT_MAX_BRIGHTNESS_DURATION, true);
-    }
-    if (mCurrentBrightness.load() == 0) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "No need to update brightne during init");
-        return true;
-    }
-    return UpdateBrightness(mCurrentBrightness.load(), DEFAULT_MAX_BRIGHTNESS_DURATION, true);
+    return RunOnStrand([&] {
+        uint32_t max_value = GetBrightnessLevelFromNit(maxNit);
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightnessNit nitIn=%{public}u, levelOut=%{public}u",
+            maxNit, max_value);
+        if (max_value == brightnessValueMax) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightness value=oldMax");
+            return true;
+        }
+        brightnessValueMax =
+            (max_value > MAX_DEFAULT_BRGIHTNESS_LEVEL ? MAX_DEFAULT_BRGIHTNESS_LEVEL : max_value);
+        uint32_t currentBrightness = GetSettingBrightness();
+        if (brightnessValueMax < currentBrightness) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetMaxBrightnessNit currentBrightness=%{public}u", currentBrightness);
+            return UpdateBrightness(brightnessValueMax, DEFAULT_MAX_BRIGHTNESS_DURATION, true);
+        }
+        if (mCurrentBrightness == 0) {
+            DISPLAY_HILOGI(FEAT_BRIGHTNESS, "No need to update brightne during init");
+            return true;
+        }
+        return UpdateBrightness(mCurrentBrightness, DEFAULT_MAX_BRIGHTNESS_DURATION, true);
+    });
 }
 
 int BrightnessService::NotifyScreenPowerStatus([[maybe_unused]] uint32_t displayId, [[maybe_unused]] uint32_t status)
@@ -1292,14 +1624,15 @@ int BrightnessService::NotifyScreenPowerStatus([[maybe_unused]] uint32_t display
 uint32_t BrightnessService::GetSafeBrightness(uint32_t value)
 {
     auto brightnessValue = value;
-    if (brightnessValue > brightnessValueMax) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "value is bigger than max=%{public}u, value=%{public}u",
-            brightnessValueMax, value);
-        brightnessValue = brightnessValueMax;
+    uint32_t maxValue = brightnessValueMax.load();
+    uint32_t minValue = brightnessValueMin.load();
+    if (brightnessValue > maxValue) {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "value is bigger than max=%{public}u, value=%{public}u", maxValue, value);
+        brightnessValue = maxValue;
     }
-    if (brightnessValue < brightnessValueMin) {
+    if (brightnessValue < minValue) {
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "brightness value is less than min, value=%{public}u", value);
-        brightnessValue = brightnessValueMin;
+        brightnessValue = minValue;
     }
     return brightnessValue;
 }
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "brightness_setting_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <chrono>
+
+#include "display_log.h"
+#include "setting_provider.h"
+#include "system_ability_definition.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+using namespace OHOS::PowerMgr;
+namespace {
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+BrightnessSettingCache& BrightnessSettingCache::Get()
+{
+    static BrightnessSettingCache instance;
+    return instance;
+}
+
+ErrCode BrightnessSettingCache::GetIntValue(const std::string& key, int32_t& value)
+{
+    auto entry = FindEntry(key);
+    if (entry == nullptr || (!entry->observed.load(std::memory_order_acquire) &&
+        GetSteadyTimeMs() >= entry->nextWatchTimeMs.load(std::memory_order_relaxed))) {
+        entry = WatchKey(key);
+    }
+    bool isObserved = entry->observed.load(std::memory_order_acquire);
+    if (isObserved && entry->valid.load(std::memory_order_acquire)) {
+        value = entry->value.load(std::memory_order_relaxed);
+        return ERR_OK;
+    }
+    uint32_t generation = entry->generation.load(std::memory_order_acquire);
+    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
+    ErrCode ret = provider.GetIntValue(key, value);
+    if (ret != ERR_OK || !isObserved) {
+        return ret;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    // The observer may have reported a newer value while this one was being read
+    if (!entry->valid.load(std::memory_order_relaxed) &&
+        entry->generation.load(std::memory_order_relaxed) == generation) {
+        StoreLocked(*entry, value);
+    }
+    return ERR_OK;
+}
+
+void BrightnessSettingCache::UpdateIntValue(const std::string& key, int32_t value)
+{
+    auto entry = FindEntry(key);
+    if (entry == nullptr || !entry->observed.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    StoreLocked(*entry, value);
+}
+
+uint32_t BrightnessSettingCache::GetGeneration() const
+{
+    return mGeneration.load(std::memory_order_acquire);
+}
+
+bool BrightnessSettingCache::IsObserved(const std::string& key) const
+{
+    auto entry = FindEntry(key);
+    return entry != nullptr && entry->observed.load(std::memory_order_acquire);
+}
+
+void BrightnessSettingCache::DeInit()
+{
+    std::lock_guard<std::mutex> watchLock(mWatchMutex);
+    std::map<std::string, std::shared_ptr<Entry>> entries;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        entries.swap(mEntries);
+        mGeneration.fetch_add(1, std::memory_order_release);
+    }
+    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
+    for (const auto& [key, entry] : entries) {
+        if (entry->observer == nullptr) {
+            continue;
+        }
+        ErrCode ret = provider.UnregisterObserver(entry->observer);
+        if (ret != ERR_OK) {
+            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "unregister setting cache observer failed, key=%{public}s, ret=%{public}d",
+                key.c_str(), ret);
+        }
+    }
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "setting cache cleared, keys=%{public}zu", entries.size());
+}
+
+std::shared_ptr<BrightnessSettingCache::Entry> BrightnessSettingCache::FindEntry(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mEntries.find(key);
+    return (iter != mEntries.end()) ? iter->second : nullptr;
+}
+
+std::shared_ptr<BrightnessSettingCache::Entry> BrightnessSettingCache::WatchKey(const std::string& key)
+{
+    std::lock_guard<std::mutex> watchLock(mWatchMutex);
+    auto entry = FindEntry(key);
+    if (entry != nullptr && (entry->observed.load(std::memory_order_relaxed) ||
+        GetSteadyTimeMs() < entry->nextWatchTimeMs.load(std::memory_order_relaxed))) {
+        return entry;
+    }
+    if (entry == nullptr) {
+        entry = std::make_shared<Entry>();
+        // Added before registering, since the observer may be fired as soon as it is registered
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEntries[key] = entry;
+    }
+    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
+    SettingObserver::UpdateFunc updateFunc = [](const std::string& changedKey) {
+        BrightnessSettingCache::Get().OnSettingChanged(changedKey);
+    };
+    entry->observer = provider.CreateObserver(key, updateFunc);
+    ErrCode ret = provider.RegisterObserver(entry->observer);
+    if (ret != ERR_OK) {
+        // Without an observer the value could go stale, so the key keeps being read from the store. The
+        // registration, another IPC, is only retried once the back-off has passed.
+        entry->observer = nullptr;
+        entry->watchRetryMs = std::clamp(entry->watchRetryMs * 2, WATCH_RETRY_MIN_MS, WATCH_RETRY_MAX_MS);
+        entry->nextWatchTimeMs.store(GetSteadyTimeMs() + entry->watchRetryMs, std::memory_order_relaxed);
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS,
+            "register setting cache observer failed, key=%{public}s, ret=%{public}d, retry in %{public}" PRId64 "ms",
+            key.c_str(), ret, entry->watchRetryMs);
+        return entry;
+    }
+    entry->watchRetryMs = 0;
+    entry->observed.store(true, std::memory_order_release);
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "setting cache watches key=%{public}s", key.c_str());
+    return entry;
+}
+
+void BrightnessSettingCache::OnSettingChanged(const std::string& key)
+{
+    auto entry = FindEntry(key);
+    if (entry == nullptr) {
+        return;
+    }
+    int32_t value = 0;
+    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
+    ErrCode ret = provider.GetIntValue(key, value);
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (ret != ERR_OK) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "refresh setting cache failed, key=%{public}s, ret=%{public}d",
+            key.c_str(), ret);
+        // The next read goes to the store again
+        entry->valid.store(false, std::memory_order_relaxed);
+        entry->generation.fetch_add(1, std::memory_order_release);
+        mGeneration.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    StoreLocked(*entry, value);
+}
+
+void BrightnessSettingCache::StoreLocked(Entry& entry, int32_t value)
+{
+    // The observer also reports the writes of this process, which change nothing
+    if (entry.valid.load(std::memory_order_relaxed) && entry.value.load(std::memory_order_relaxed) == value) {
+        return;
+    }
+    entry.value.store(value, std::memory_order_relaxed);
+    entry.generation.fetch_add(1, std::memory_order_relaxed);
+    entry.valid.store(true, std::memory_order_release);
+    mGeneration.fetch_add(1, std::memory_order_release);
+}
+} // namespace DisplayPowerMgr
+} // namespace OHOS
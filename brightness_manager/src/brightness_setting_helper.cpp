@@ -15,6 +15,11 @@
 
 #include "brightness_setting_helper.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include "brightness_ffrt.h"
+#include "brightness_setting_cache.h"
 #include "display_log.h"
 #include "setting_provider.h"
 #include "system_ability_definition.h"
@@ -24,11 +29,52 @@ namespace DisplayPowerMgr {
 namespace {
 constexpr int32_t AUTO_BRIGHTNESS_DISABLE = 0;
 constexpr int32_t AUTO_BRIGHTNESS_ENABLE = 1;
+// The setting is written once the brightness has been idle this long, and at least this often while it keeps moving
+constexpr int64_t SETTING_BRIGHTNESS_IDLE_MS = 500;
+constexpr int64_t SETTING_BRIGHTNESS_MAX_DELAY_MS = 2000;
+std::shared_ptr<PowerMgr::FFRTQueue> g_settingBrightnessQueue{};
+PowerMgr::FFRTHandle g_settingBrightnessTaskHandle{};
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 }
 
 using namespace OHOS::PowerMgr;
 sptr<SettingObserver> BrightnessSettingHelper::mAutoBrightnessObserver;
 sptr<SettingObserver> BrightnessSettingHelper::mBrightnessObserver;
+std::mutex BrightnessSettingHelper::mSettingBrightnessMutex;
+std::mutex BrightnessSettingHelper::mSettingBrightnessWriteMutex;
+bool BrightnessSettingHelper::mHasPendingSettingBrightness = false;
+uint32_t BrightnessSettingHelper::mPendingSettingBrightness = 0;
+int64_t BrightnessSettingHelper::mFirstPendingTimeMs = 0;
+bool BrightnessSettingHelper::mHasWrittenSettingBrightness = false;
+uint32_t BrightnessSettingHelper::mWrittenSettingBrightness = 0;
+uint32_t BrightnessSettingHelper::mWrittenSettingGeneration = 0;
+uint32_t BrightnessSettingHelper::mSettingBrightnessWriteCount = 0;
+
+void BrightnessSettingHelper::Init()
+{
+    std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+    if (g_settingBrightnessQueue == nullptr) {
+        g_settingBrightnessQueue = std::make_shared<PowerMgr::FFRTQueue>("brightness_setting_queue");
+    }
+}
+
+void BrightnessSettingHelper::DeInit()
+{
+    FlushSettingBrightness();
+    std::shared_ptr<PowerMgr::FFRTQueue> queue;
+    {
+        std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+        FFRT_CANCEL(g_settingBrightnessTaskHandle, g_settingBrightnessQueue);
+        queue.swap(g_settingBrightnessQueue);
+    }
+    // Destroyed without the lock, a write task of this queue may be waiting for it
+    queue.reset();
+}
 
 void BrightnessSettingHelper::RegisterSettingBrightnessObserver(SettingObserver::UpdateFunc func)
 {
@@ -61,33 +107,128 @@ void BrightnessSettingHelper::UnregisterSettingBrightnessObserver()
 
 void BrightnessSettingHelper::SetSettingBrightness(uint32_t value)
 {
-    uint32_t settingBrightness;
-    if (GetSettingBrightness(settingBrightness) != ERR_OK) {
-        return;
+    {
+        std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+        if (!mHasPendingSettingBrightness && IsSettingBrightnessWrittenLocked(value)) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "no need to set setting brightness");
+            return;
+        }
+        int64_t nowMs = GetSteadyTimeMs();
+        if (!mHasPendingSettingBrightness) {
+            mFirstPendingTimeMs = nowMs;
+        }
+        mPendingSettingBrightness = value;
+        mHasPendingSettingBrightness = true;
+        if (ScheduleSettingBrightnessWrite(nowMs)) {
+            return;
+        }
     }
-    if (value == static_cast<uint32_t>(settingBrightness)) {
-        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "no need to set setting brightness");
-        return;
+    WriteSettingBrightness();
+}
+
+bool BrightnessSettingHelper::ScheduleSettingBrightnessWrite(int64_t nowMs)
+{
+    // Called with mSettingBrightnessMutex held. Every new value pushes the write back by the idle time,
+    // but never past the maximum delay counted from the first value that is still pending.
+    if (g_settingBrightnessQueue == nullptr) {
+        return false;
+    }
+    int64_t delayMs = std::min(SETTING_BRIGHTNESS_IDLE_MS,
+        std::max(static_cast<int64_t>(0), mFirstPendingTimeMs + SETTING_BRIGHTNESS_MAX_DELAY_MS - nowMs));
+    FFRT_CANCEL(g_settingBrightnessTaskHandle, g_settingBrightnessQueue);
+    FFRTTask task = [] { WriteSettingBrightness(); };
+    g_settingBrightnessTaskHandle =
+        FFRTUtils::SubmitDelayTask(task, static_cast<uint32_t>(delayMs), g_settingBrightnessQueue);
+    return true;
+}
+
+void BrightnessSettingHelper::FlushSettingBrightness()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+        if (!mHasPendingSettingBrightness) {
+            return;
+        }
+        FFRT_CANCEL(g_settingBrightnessTaskHandle, g_settingBrightnessQueue);
+    }
+    WriteSettingBrightness();
+}
+
+void BrightnessSettingHelper::WriteSettingBrightness()
+{
+    // Writes are serialized so that a flush and the delayed task cannot persist values out of order
+    std::lock_guard<std::mutex> writeLock(mSettingBrightnessWriteMutex);
+    uint32_t value = 0;
+    {
+        std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+        if (!mHasPendingSettingBrightness) {
+            return;
+        }
+        value = mPendingSettingBrightness;
+        mHasPendingSettingBrightness = false;
+        if (IsSettingBrightnessWrittenLocked(value)) {
+            DISPLAY_HILOGD(FEAT_BRIGHTNESS, "no need to set setting brightness");
+            return;
+        }
     }
     SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
     auto ret = provider.PutIntValue(SETTING_BRIGHTNESS_KEY, static_cast<int32_t>(value));
+    std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+    mSettingBrightnessWriteCount++;
     if (ret != ERR_OK) {
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "set setting brightness failed, ret=%{public}d", ret);
+        // The stored value is unknown now, so the next request is written even if it repeats this one
+        mHasWrittenSettingBrightness = false;
         return;
     }
+    BrightnessSettingCache::Get().UpdateIntValue(SETTING_BRIGHTNESS_KEY, static_cast<int32_t>(value));
+    SetWrittenSettingBrightnessLocked(value, BrightnessSettingCache::Get().GetGeneration());
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "set setting brightness=%{public}u", value);
 }
 
+bool BrightnessSettingHelper::IsSettingBrightnessWrittenLocked(uint32_t value)
+{
+    // A change reported by the setting observer since then may have replaced the value in the store
+    auto& cache = BrightnessSettingCache::Get();
+    return mHasWrittenSettingBrightness && value == mWrittenSettingBrightness &&
+        mWrittenSettingGeneration == cache.GetGeneration() && cache.IsObserved(SETTING_BRIGHTNESS_KEY);
+}
+
+void BrightnessSettingHelper::SetWrittenSettingBrightnessLocked(uint32_t value, uint32_t generation)
+{
+    mWrittenSettingBrightness = value;
+    mWrittenSettingGeneration = generation;
+    mHasWrittenSettingBrightness = true;
+}
+
 ErrCode BrightnessSettingHelper::GetSettingBrightness(uint32_t& brightness, const std::string& key)
 {
-    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
+    uint32_t writeCount = 0;
+    if (key == SETTING_BRIGHTNESS_KEY) {
+        std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+        if (mHasPendingSettingBrightness) {
+            // The setting store has not seen this value yet
+            brightness = mPendingSettingBrightness;
+            return ERR_OK;
+        }
+        writeCount = mSettingBrightnessWriteCount;
+    }
     int32_t value;
-    ErrCode ret = provider.GetIntValue(key, value);
+    uint32_t generation = BrightnessSettingCache::Get().GetGeneration();
+    ErrCode ret = BrightnessSettingCache::Get().GetIntValue(key, value);
     if (ret != ERR_OK) {
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "get setting brightness failed, ret=%{public}d", ret);
         return ret;
     }
     brightness = static_cast<uint32_t>(value);
+    if (key == SETTING_BRIGHTNESS_KEY) {
+        // The store may have been changed by another writer, remember what it holds now unless
+        // one of our own writes completed meanwhile and made the value read here stale
+        std::lock_guard<std::mutex> lock(mSettingBrightnessMutex);
+        if (!mHasPendingSettingBrightness && writeCount == mSettingBrightnessWriteCount) {
+            SetWrittenSettingBrightnessLocked(brightness, generation);
+        }
+    }
     return ERR_OK;
 }
 
@@ -129,14 +270,15 @@ void BrightnessSettingHelper::SetSettingAutoBrightness(bool enable)
     if (ret != ERR_OK) {
         DISPLAY_HILOGW(
             FEAT_BRIGHTNESS, "set setting auto brightness failed, enable=%{public}d, ret=%{public}d", enable, ret);
+        return;
     }
+    BrightnessSettingCache::Get().UpdateIntValue(SETTING_AUTO_ADJUST_BRIGHTNESS_KEY, value);
 }
 
 bool BrightnessSettingHelper::GetSettingAutoBrightness(const std::string& key)
 {
-    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
     int32_t value;
-    ErrCode ret = provider.GetIntValue(key, value);
+    ErrCode ret = BrightnessSettingCache::Get().GetIntValue(key, value);
     if (ret != ERR_OK) {
         DISPLAY_HILOGW(
             FEAT_BRIGHTNESS, "get setting auto brightness failed key=%{public}s, ret=%{public}d", key.c_str(), ret);
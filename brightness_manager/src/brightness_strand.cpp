@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "brightness_strand.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+namespace {
+constexpr uint64_t NO_OWNER = 0;
+std::atomic<uint64_t> g_threadTokens{0};
+
+// Task tokens are odd and thread tokens even and non-zero, they never collide with each other or NO_OWNER
+uint64_t GetCallerToken()
+{
+    uint64_t taskId = ffrt::this_task::get_id();
+    if (taskId != 0) {
+        return (taskId << 1) | 1;
+    }
+    thread_local const uint64_t threadToken = (g_threadTokens.fetch_add(1, std::memory_order_relaxed) + 1) << 1;
+    return threadToken;
+}
+}
+
+bool BrightnessStrand::IsCurrent() const
+{
+    // Only the owner stores its own token, so any other caller never sees a match
+    return mOwner.load(std::memory_order_acquire) == GetCallerToken();
+}
+
+BrightnessStrand::Turn::Turn(BrightnessStrand& strand) : mStrand(strand)
+{
+    uint64_t token = GetCallerToken();
+    std::unique_lock<ffrt::mutex> lock(mStrand.mMutex);
+    uint64_t ticket = mStrand.mNextTicket++;
+    mStrand.mTurnChanged.wait(lock, [this, ticket] { return mStrand.mServingTicket == ticket; });
+    mStrand.mOwner.store(token, std::memory_order_release);
+}
+
+BrightnessStrand::Turn::~Turn()
+{
+    {
+        std::lock_guard<ffrt::mutex> lock(mStrand.mMutex);
+        mStrand.mOwner.store(NO_OWNER, std::memory_order_release);
+        mStrand.mServingTicket++;
+    }
+    mStrand.mTurnChanged.notify_all();
+}
+} // namespace DisplayPowerMgr
+} // namespace OHOS
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "brightness_threshold_monitor.h"
+
+#include <algorithm>
+
+#include "display_log.h"
+
+using namespace OHOS::PowerMgr;
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+namespace {
+constexpr size_t LUX_THRESHOLD_INDEX = 0;
+constexpr size_t BRIGHTNESS_THRESHOLD_INDEX = 1;
+constexpr size_t HYSTERESIS_INDEX = 2;
+}
+
+BrightnessThresholdMonitor& BrightnessThresholdMonitor::Get()
+{
+    static BrightnessThresholdMonitor instance;
+    return instance;
+}
+
+size_t BrightnessThresholdMonitor::GetIndex(ThresholdType type)
+{
+    return type == TYPE_BRIGHTNESS ? 1 : 0;
+}
+
+bool BrightnessThresholdMonitor::Register(const std::vector<int32_t>& threshold,
+    const sptr<IDisplayBrightnessCallback>& callback)
+{
+    if (threshold.empty() || callback == nullptr || callback->AsObject() == nullptr) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "SetLightBrightnessThreshold params verify failed");
+        return false;
+    }
+    auto getParam = [&threshold](size_t index) { return index < threshold.size() ? threshold[index] : -1; };
+    int32_t luxThreshold = getParam(LUX_THRESHOLD_INDEX);
+    int32_t brightnessThreshold = getParam(BRIGHTNESS_THRESHOLD_INDEX);
+    if (luxThreshold < 0 && brightnessThreshold < 0) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "SetLightBrightnessThreshold no threshold to monitor");
+        return false;
+    }
+    sptr<IRemoteObject> remote = callback->AsObject();
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mClients.find(remote) == mClients.end() && mClients.size() >= MAX_CLIENTS) {
+        DISPLAY_HILOGE(FEAT_BRIGHTNESS, "Too many light brightness threshold clients");
+        return false;
+    }
+    auto& client = mClients[remote];
+    if (client == nullptr) {
+        client = std::make_unique<Client>();
+        client->deathRecipient = new ClientDeathRecipient();
+        remote->AddDeathRecipient(client->deathRecipient);
+    }
+    client->callback = callback;
+    client->thresholds[GetIndex(TYPE_LIGHT)] = luxThreshold;
+    client->thresholds[GetIndex(TYPE_BRIGHTNESS)] = brightnessThreshold;
+    client->hysteresis = std::max(getParam(HYSTERESIS_INDEX), 0);
+    for (size_t index = 0; index < TYPE_COUNT; index++) {
+        InitStateLocked(*client, index);
+    }
+    RebuildLocked();
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetLightBrightnessThreshold lux=%{public}d, brightness=%{public}d,"
+        " hysteresis=%{public}d, clients=%{public}zu", luxThreshold, brightnessThreshold, client->hysteresis,
+        mClients.size());
+    return true;
+}
+
+void BrightnessThresholdMonitor::Remove(const sptr<IRemoteObject>& remote)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto iter = mClients.find(remote);
+    if (iter == mClients.end()) {
+        return;
+    }
+    remote->RemoveDeathRecipient(iter->second->deathRecipient);
+    mClients.erase(iter);
+    RebuildLocked();
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "remove light brightness threshold client, clients=%{public}zu", mClients.size());
+}
+
+void BrightnessThresholdMonitor::InitStateLocked(Client& client, size_t index)
+{
+    // The side of the current sample is the starting point, it is not a crossing and is not notified
+    const Channel& channel = mChannels[index];
+    if (client.thresholds[index] < 0 || !channel.hasValue) {
+        client.states[index] = STATE_UNKNOWN;
+        return;
+    }
+    client.states[index] = channel.lastValue >= client.thresholds[index] ? STATE_ABOVE : STATE_BELOW;
+}
+
+void BrightnessThresholdMonitor::RebuildLocked()
+{
+    uint32_t activeTypes = 0;
+    for (size_t index = 0; index < TYPE_COUNT; index++) {
+        Channel& channel = mChannels[index];
+        channel.upEdges.clear();
+        channel.downEdges.clear();
+        for (const auto& [remote, client] : mClients) {
+            int32_t threshold = client->thresholds[index];
+            if (threshold < 0) {
+                continue;
+            }
+            channel.upEdges.push_back({static_cast<double>(threshold) + client->hysteresis, client.get()});
+            channel.downEdges.push_back({static_cast<double>(threshold) - client->hysteresis, client.get()});
+        }
+        auto less = [](const Edge& a, const Edge& b) { return a.value < b.value; };
+        std::sort(channel.upEdges.begin(), channel.upEdges.end(), less);
+        std::sort(channel.downEdges.begin(), channel.downEdges.end(), less);
+        if (channel.upEdges.empty()) {
+            // Samples are not tracked without a client, the last one would be stale for the next client
+            channel.hasValue = false;
+        } else {
+            activeTypes |= 1U << index;
+        }
+    }
+    mActiveTypes.store(activeTypes, std::memory_order_release);
+}
+
+void BrightnessThresholdMonitor::OnSample(ThresholdType type, double value)
+{
+    size_t index = GetIndex(type);
+    if ((mActiveTypes.load(std::memory_order_acquire) & (1U << index)) == 0) {
+        return;
+    }
+    std::vector<Notification> notifications;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Channel& channel = mChannels[index];
+        double lastValue = channel.lastValue;
+        bool hasValue = channel.hasValue;
+        channel.lastValue = value;
+        channel.hasValue = true;
+        if (!hasValue) {
+            for (const auto& [remote, client] : mClients) {
+                InitStateLocked(*client, index);
+            }
+            return;
+        }
+        // Only the clients with an edge between the last and the new sample can change side
+        auto valueLess = [](double sample, const Edge& edge) { return sample < edge.value; };
+        bool isRising = value > lastValue;
+        const auto& edges = isRising ? channel.upEdges : channel.downEdges;
+        auto first = std::upper_bound(edges.begin(), edges.end(), std::min(lastValue, value), valueLess);
+        auto last = std::upper_bound(first, edges.end(), std::max(lastValue, value), valueLess);
+        ThresholdState state = isRising ? STATE_ABOVE : STATE_BELOW;
+        for (auto iter = first; iter != last; ++iter) {
+            Client* client = iter->client;
+            int8_t& current = client->states[index];
+            if (current == state) {
+                continue;
+            }
+            bool isCrossing = current != STATE_UNKNOWN;
+            current = state;
+            if (isCrossing) {
+                client->notified++;
+                notifications.push_back({client->callback, type, state});
+            }
+        }
+    }
+    if (notifications.empty()) {
+        return;
+    }
+    // One task per sample, the callbacks are called outside the lock
+    FFRTTask task = [this, notifications = std::move(notifications)] { Deliver(notifications); };
+    FFRTUtils::SubmitDelayTask(task, 0, mQueue);
+}
+
+void BrightnessThresholdMonitor::Deliver(const std::vector<Notification>& notifications)
+{
+    for (const auto& notification : notifications) {
+        DISPLAY_HILOGI(FEAT_BRIGHTNESS, "OnNotifyApsLightBrightnessChange type=%{public}u, state=%{public}d",
+            static_cast<uint32_t>(notification.type), static_cast<int32_t>(notification.state));
+        notification.callback->OnNotifyApsLightBrightnessChange(notification.type, notification.state);
+    }
+}
+
+void BrightnessThresholdMonitor::Dump(std::string& result) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    result.append("Light Brightness Thresholds: ").append(std::to_string(mClients.size())).append("\n");
+    for (const auto& [remote, client] : mClients) {
+        result.append("  Lux=").append(std::to_string(client->thresholds[GetIndex(TYPE_LIGHT)]));
+        result.append(" Brightness=").append(std::to_string(client->thresholds[GetIndex(TYPE_BRIGHTNESS)]));
+        result.append(" Hysteresis=").append(std::to_string(client->hysteresis));
+        result.append(" LuxState=").append(std::to_string(client->states[GetIndex(TYPE_LIGHT)]));
+        result.append(" BrightnessState=").append(std::to_string(client->states[GetIndex(TYPE_BRIGHTNESS)]));
+        result.append(" Notified=").append(std::to_string(client->notified)).append("\n");
+    }
+}
+
+void BrightnessThresholdMonitor::ClientDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& remote)
+{
+    auto object = remote.promote();
+    if (object != nullptr) {
+        BrightnessThresholdMonitor::Get().Remove(object);
+    }
+}
+} // namespace DisplayPowerMgr
+} // namespace OHOS
@@ -77,5 +77,14 @@ void CalculationConfigParser::PrintConfig(int displayId, const CalculationConfig
     text.append(ConfigParserBase::Get().PointXyToString("defaultPoints", data.defaultPoints));
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "%{public}s", text.c_str());
 }
+
+bool CalculationConfigParser::ValidateConfig(int displayId, CalculationConfig::Data& data)
+{
+    if (!ConfigParserBase::Get().NormalizePointXy("defaultPoints", data.defaultPoints)) {
+        DISPLAY_HILOGE(FEAT_BRIGHTNESS, "[%{public}d] CalculationConfig defaultPoints is invalid!", displayId);
+        return false;
+    }
+    return true;
+}
 } // namespace DisplayPowerMgr
 } // namespace OHOS
@@ -34,10 +34,16 @@ namespace DisplayPowerMgr {
 using std::string;
 using std::vector;
 
+BrightnessCalculationCurve::BrightnessCalculationCurve()
+{
+    BuildScreenDataTables();
+}
+
 void BrightnessCalculationCurve::InitParameters()
 {
     const ScreenConfig screenConfig = ConfigParse::Get().GetScreenConfig();
     mScreenConfig = screenConfig;
+    BuildScreenDataTables();
     int displayId = 0;
     const std::unordered_map<int, Config>& brightnessConfig =
         ConfigParse::Get().GetBrightnessConfig();
@@ -51,7 +57,7 @@ void BrightnessCalculationCurve::InitParameters()
 
 float BrightnessCalculationCurve::GetCurrentBrightness(float lux)
 {
-    std::vector<PointXy> curve = mCurveConfig.calculationConfig.defaultPoints;
+    const std::vector<PointXy>& curve = mCurveConfig.calculationConfig.defaultPoints;
     if (curve.size() == 0) {
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "GetCurrentBrightness default=%{public}f", mDefaultBrightness);
         return mDefaultBrightness;
@@ -61,24 +67,19 @@ float BrightnessCalculationCurve::GetCurrentBrightness(float lux)
     return brightness;
 }
 
-float BrightnessCalculationCurve::GetBrightnessCurveLevel(std::vector<PointXy>& linePointsList, float lux)
+float BrightnessCalculationCurve::GetBrightnessCurveLevel(const std::vector<PointXy>& linePointsList, float lux)
 {
-    float brightnessLevel = mDefaultBrightness;
-    for (auto point = linePointsList.begin(), prePoint = point; point != linePointsList.end(); point++) {
-        if (lux < point->x) {
-            if (point->x < prePoint->x || IsEqualF(point->x, prePoint->x)) {
-                brightnessLevel = mDefaultBrightness;
-            } else {
-                brightnessLevel = ((point->y - prePoint->y) / (point->x - prePoint->x) * (lux - prePoint->x))
-                    + prePoint->y;
-            }
-            break;
-        } else {
-            prePoint = point;
-            brightnessLevel = prePoint->y;
-        }
+    // points are sorted by x without duplicates and carry their segment slope, see NormalizePointXy
+    auto point = std::upper_bound(linePointsList.begin(), linePointsList.end(), lux,
+        [](float value, const PointXy& pointXy) { return value < pointXy.x; });
+    if (point == linePointsList.begin()) {
+        return mDefaultBrightness;
+    }
+    const PointXy& prePoint = *std::prev(point);
+    if (point == linePointsList.end()) {
+        return prePoint.y;
     }
-    return brightnessLevel;
+    return prePoint.slope * (lux - prePoint.x) + prePoint.y;
 }
 
 void BrightnessCalculationCurve::UpdateCurveAmbientLux(float lux)
@@ -91,40 +92,56 @@ void BrightnessCalculationCurve::UpdateCurrentUserId(int userId)
     mCurrentUserId = userId;
 }
 
-int BrightnessCalculationCurve::GetDisplayIdWithDisplayMode(int displayMode)
+void BrightnessCalculationCurve::BuildScreenDataTables()
+{
+    BuildScreenDataTable(mScreenConfig.brightnessConfig.displayModeMap, mDisplayModeTable);
+    BuildScreenDataTable(mScreenConfig.brightnessConfig.foldStatusModeMap, mFoldStatusTable);
+}
+
+void BrightnessCalculationCurve::BuildScreenDataTable(
+    const std::unordered_map<int, ScreenData>& data, ScreenDataTable& table)
 {
-    std::unordered_map<int, ScreenData> displayModeMap = mScreenConfig.brightnessConfig.displayModeMap;
-    if (displayModeMap.find(displayMode) != displayModeMap.end()) {
-        return displayModeMap[displayMode].displayId;
+    table.fill(ScreenData{ DEFAULT_DISPLAY_ID, DEFAULT_SENSOR_ID });
+    for (const auto& [key, value] : data) {
+        if (key < 0 || key >= SCREEN_DATA_TABLE_SIZE) {
+            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "screen data key=%{public}d out of table, use map lookup", key);
+            continue;
+        }
+        table[key] = value;
     }
-    return DEFAULT_DISPLAY_ID;
 }
 
-int BrightnessCalculationCurve::GetSensorIdWithDisplayMode(int displayMode)
+ScreenData BrightnessCalculationCurve::LookupScreenData(const ScreenDataTable& table,
+    const std::unordered_map<int, ScreenData>& data, int key)
 {
-    std::unordered_map<int, ScreenData> displayModeMap = mScreenConfig.brightnessConfig.displayModeMap;
-    if (displayModeMap.find(displayMode) != displayModeMap.end()) {
-        return displayModeMap[displayMode].sensorId;
+    if (key >= 0 && key < SCREEN_DATA_TABLE_SIZE) {
+        return table[key];
     }
-    return DEFAULT_SENSOR_ID;
+    auto it = data.find(key);
+    if (it != data.end()) {
+        return it->second;
+    }
+    return ScreenData{ DEFAULT_DISPLAY_ID, DEFAULT_SENSOR_ID };
+}
+
+int BrightnessCalculationCurve::GetDisplayIdWithDisplayMode(int displayMode)
+{
+    return LookupScreenData(mDisplayModeTable, mScreenConfig.brightnessConfig.displayModeMap, displayMode).displayId;
+}
+
+int BrightnessCalculationCurve::GetSensorIdWithDisplayMode(int displayMode)
+{
+    return LookupScreenData(mDisplayModeTable, mScreenConfig.brightnessConfig.displayModeMap, displayMode).sensorId;
 }
 
 int BrightnessCalculationCurve::GetDisplayIdWithFoldstatus(int foldStatus)
 {
-    std::unordered_map<int, ScreenData> displayModeMap = mScreenConfig.brightnessConfig.foldStatusModeMap;
-    if (displayModeMap.find(foldStatus) != displayModeMap.end()) {
-        return displayModeMap[foldStatus].displayId;
-    }
-    return DEFAULT_DISPLAY_ID;
+    return LookupScreenData(mFoldStatusTable, mScreenConfig.brightnessConfig.foldStatusModeMap, foldStatus).displayId;
 }
 
 int BrightnessCalculationCurve::GetSensorIdWithFoldstatus(int foldStatus)
 {
-    std::unordered_map<int, ScreenData> displayModeMap = mScreenConfig.brightnessConfig.foldStatusModeMap;
-    if (displayModeMap.find(foldStatus) != displayModeMap.end()) {
-        return displayModeMap[foldStatus].sensorId;
-    }
-    return DEFAULT_SENSOR_ID;
+    return LookupScreenData(mFoldStatusTable, mScreenConfig.brightnessConfig.foldStatusModeMap, foldStatus).sensorId;
 }
 
 } // namespace DisplayPowerMgr
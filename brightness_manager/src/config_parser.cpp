@@ -44,7 +44,10 @@ void ConfigParse::Initialize()
     for (int displayId = 0; displayId < DISPLAY_ID_MAX; displayId++) {
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "[%{public}d] Already init!", displayId);
         Config brightnessConfig{};
-        ParseConfig(displayId, brightnessConfig);
+        if (!ParseConfig(displayId, brightnessConfig)) {
+            DISPLAY_HILOGE(FEAT_BRIGHTNESS, "[%{public}d] Config is malformed, use the defaults!", displayId);
+            brightnessConfig = GetDefaultConfig(displayId);
+        }
         PrintConfig(displayId, brightnessConfig);
         mConfig[displayId] = brightnessConfig;
     }
@@ -67,8 +70,20 @@ bool ConfigParse::ParseConfig(int displayId, Config& data) const
     CalculationConfigParser::ParseConfig(displayId, data.calculationConfig);
     LuxFilterConfigParser::ParseConfig(displayId, data.luxFilterConfig);
     LuxThresholdConfigParser::ParseConfig(displayId, data.luxThresholdConfig);
+    // Normalize after parsing so built-in defaults get the same sorting and precomputed slopes
+    bool isValid = CalculationConfigParser::ValidateConfig(displayId, data.calculationConfig);
+    isValid = LuxThresholdConfigParser::ValidateConfig(displayId, data.luxThresholdConfig) && isValid;
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "[%{public}d] parse Config over!", displayId);
-    return true;
+    return isValid;
+}
+
+Config ConfigParse::GetDefaultConfig(int displayId) const
+{
+    // The built-in curves are valid, they only need the same normalization as parsed ones
+    Config data{};
+    CalculationConfigParser::ValidateConfig(displayId, data.calculationConfig);
+    LuxThresholdConfigParser::ValidateConfig(displayId, data.luxThresholdConfig);
+    return data;
 }
 
 void ConfigParse::PrintConfig(int displayId, const Config& data) const
@@ -15,10 +15,13 @@
 
 #include "config_parser_base.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <unistd.h>
 
+#include "brightness_base.h"
 #include "display_log.h"
 
 namespace OHOS {
@@ -141,46 +144,82 @@ const std::string ConfigParserBase::LoadConfigRoot(int displayId, const std::str
     return fileContent;
 }
 
-void ConfigParserBase::ParsePointXy(
+bool ConfigParserBase::ParsePointXy(
     const cJSON* root, const std::string& name, std::vector<PointXy>& data) const
 {
     data.clear();
     const cJSON* array = cJSON_GetObjectItemCaseSensitive(root, name.c_str());
     if (!DisplayJsonUtils::IsValidJsonArray(array)) {
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "root <%{public}s> is not found or is not an array!", name.c_str());
-        return;
+        return true;
     }
 
+    // A bad node leaves only the default point (-1, -1) behind, so NormalizePointXy rejects the whole curve
+    // instead of loading a truncated or zero-filled one
+    auto reject = [&data, &name](const char* reason) {
+        DISPLAY_HILOGE(FEAT_BRIGHTNESS, "array <%{public}s> %{public}s, curve rejected!", name.c_str(), reason);
+        data.assign(1, PointXy{});
+        return false;
+    };
     cJSON* item = nullptr;
     cJSON_ArrayForEach(item, array) {
         if (!DisplayJsonUtils::IsValidJsonArray(item)) {
-            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "array <%{public}s> element is not an array!", name.c_str());
-            return;
+            return reject("element is not an array");
         }
 
         PointXy pointXy{};
         uint32_t arraySize = (uint32_t)cJSON_GetArraySize(item);
         if (arraySize != POINT_XY_SIZE) {
-            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "array <%{public}s> size!=%{public}d!", name.c_str(), POINT_XY_SIZE);
-            return;
+            return reject("element size is not 2");
         }
 
         const cJSON* xNode = cJSON_GetArrayItem(item, POINT_X_INDEX);
-        if (DisplayJsonUtils::IsValidJsonNumber(xNode)) {
-            pointXy.x = static_cast<float>(xNode->valuedouble);
-        } else {
-            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "parse [%{public}s] error!", name.c_str());
+        const cJSON* yNode = cJSON_GetArrayItem(item, POINT_Y_INDEX);
+        if (!DisplayJsonUtils::IsValidJsonNumber(xNode) || !DisplayJsonUtils::IsValidJsonNumber(yNode)) {
+            return reject("element is not a number pair");
         }
+        pointXy.x = static_cast<float>(xNode->valuedouble);
+        pointXy.y = static_cast<float>(yNode->valuedouble);
+        data.emplace_back(pointXy);
+    }
+    return true;
+}
 
-        const cJSON* yNode = cJSON_GetArrayItem(item, POINT_Y_INDEX);
-        if (DisplayJsonUtils::IsValidJsonNumber(yNode)) {
-            pointXy.y = static_cast<float>(yNode->valuedouble);
-        } else {
-            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "parse [%{public}s] error!", name.c_str());
+bool ConfigParserBase::NormalizePointXy(const std::string& name, std::vector<PointXy>& data) const
+{
+    for (const auto& point : data) {
+        if (!std::isfinite(point.x) || !std::isfinite(point.y) || point.x < 0.0f || point.y < 0.0f) {
+            DISPLAY_HILOGE(FEAT_BRIGHTNESS, "<%{public}s> malformed point (%{public}f, %{public}f), curve rejected!",
+                name.c_str(), point.x, point.y);
+            data.clear();
+            return false;
         }
+    }
 
-        data.emplace_back(pointXy);
+    if (!std::is_sorted(data.begin(), data.end(), [](const PointXy& a, const PointXy& b) { return a.x < b.x; })) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "<%{public}s> x is not ascending, sorted!", name.c_str());
+        std::stable_sort(data.begin(), data.end(), [](const PointXy& a, const PointXy& b) { return a.x < b.x; });
+    }
+
+    // keep the last point of each duplicate x, it is the one the curve used for lux >= x
+    std::vector<PointXy> points{};
+    points.reserve(data.size());
+    for (const auto& point : data) {
+        if (!points.empty() && IsEqualF(points.back().x, point.x)) {
+            DISPLAY_HILOGW(FEAT_BRIGHTNESS, "<%{public}s> duplicate x=%{public}f, y=%{public}f replaced by %{public}f",
+                name.c_str(), point.x, points.back().y, point.y);
+            points.back() = point;
+            continue;
+        }
+        points.emplace_back(point);
+    }
+
+    for (size_t i = 0; i < points.size(); i++) {
+        points[i].slope = (i + 1 < points.size()) ?
+            (points[i + 1].y - points[i].y) / (points[i + 1].x - points[i].x) : 0.0f;
     }
+    data = std::move(points);
+    return true;
 }
 
 const std::string ConfigParserBase::PointXyToString(
@@ -15,6 +15,7 @@
 
 #include "light_lux_manager.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "display_log.h"
@@ -158,13 +159,12 @@ int64_t LightLuxManager::GetNextDarkenTime(int64_t timestamp) const
 void LightLuxManager::UpdateParam(const float lux)
 {
     mFilteredLux = lux;
-    std::vector<PointXy> brightenLinePointsList = GetBrightenLuxList();
-    float delta = CalcDelta(brightenLinePointsList);
+    auto& mode = GetCurrentModeData();
+    float delta = CalcDelta(mode.brightenPoints);
     if (delta >= 0) {
         mBrightenDelta = delta;
     }
-    std::vector<PointXy> darkenLinePointsList = GetDarkenLuxList();
-    delta = CalcDelta(darkenLinePointsList);
+    delta = CalcDelta(mode.darkenPoints);
     if (delta >= 0) {
         mDarkenDelta = delta;
     }
@@ -178,24 +178,18 @@ float LightLuxManager::CalcDelta(const std::vector<PointXy>& pointsList) const
         DISPLAY_HILOGE(FEAT_BRIGHTNESS, "error! input vector is empty");
         return INVALID_VALUE;
     }
-    float delta = 0;
-    PointXy temp = pointsList.front();
-    std::vector<PointXy>::const_iterator it;
-    for (it = pointsList.begin(); it != pointsList.end(); it++) {
-        if (mFilteredLux < it->x) {
-            if (it->x < temp.x || IsEqualF(it->x, temp.x)) {
-                delta = 1;
-            } else {
-                delta = (it->y - temp.y) / (it->x - temp.x) * (mFilteredLux - temp.x) + temp.y;
-                delta = (delta < 1 ? 1 : delta);
-            }
-            break;
-        } else {
-            temp = *it;
-            delta = it->y;
-        }
+    // points are sorted by x without duplicates and carry their segment slope, see NormalizePointXy
+    auto it = std::upper_bound(pointsList.begin(), pointsList.end(), mFilteredLux,
+        [](float value, const PointXy& point) { return value < point.x; });
+    if (it == pointsList.begin()) {
+        return 1;
+    }
+    const PointXy& temp = *std::prev(it);
+    if (it == pointsList.end()) {
+        return temp.y;
     }
-    return delta;
+    float delta = temp.slope * (mFilteredLux - temp.x) + temp.y;
+    return (delta < 1 ? 1 : delta);
 }
 
 float LightLuxManager::GetValidLux(float lux) const
@@ -279,24 +273,6 @@ const LuxThresholdConfig::Mode& LightLuxManager::GetCurrentModeData() const
     return mBrightnessConfigData.luxThresholdConfig.modeArray.at(ScenceLabel[static_cast<int>(mCurrentSceneMode)]);
 }
 
-std::vector<PointXy> LightLuxManager::GetBrightenLuxList()
-{
-    std::vector<PointXy> brightenPointsList;
-    auto& mode = GetCurrentModeData();
-    brightenPointsList = mode.brightenPoints;
-
-    return brightenPointsList;
-}
-
-std::vector<PointXy> LightLuxManager::GetDarkenLuxList()
-{
-    std::vector<PointXy> darkenPointsList;
-    auto& mode = GetCurrentModeData();
-    darkenPointsList = mode.darkenPoints;
-
-    return darkenPointsList;
-}
-
 int LightLuxManager::GetFilterNum()
 {
     std::string filterName = FilterLabel[static_cast<int>(mCurrentFilter)];
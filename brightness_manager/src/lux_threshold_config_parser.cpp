@@ -172,5 +172,28 @@ void LuxThresholdConfigParser::PrintConfig(
     text.append(ConfigParserBase::Get().PointXyToString("darkenPointsForLevel", data.brightenPointsForLevel));
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "%{public}s", text.c_str());
 }
+
+bool LuxThresholdConfigParser::ValidateConfig(int displayId, LuxThresholdConfig::Data& data)
+{
+    bool isValid = true;
+    for (auto& [key, value] : data.modeArray) {
+        if (!ConfigParserBase::Get().NormalizePointXy(key + ".brightenPoints", value.brightenPoints)) {
+            isValid = false;
+        }
+        if (!ConfigParserBase::Get().NormalizePointXy(key + ".darkenPoints", value.darkenPoints)) {
+            isValid = false;
+        }
+    }
+    if (!ConfigParserBase::Get().NormalizePointXy("brightenPointsForLevel", data.brightenPointsForLevel)) {
+        isValid = false;
+    }
+    if (!ConfigParserBase::Get().NormalizePointXy("darkenPointsForLevel", data.darkenPointsForLevel)) {
+        isValid = false;
+    }
+    if (!isValid) {
+        DISPLAY_HILOGE(FEAT_BRIGHTNESS, "[%{public}d] LuxThresholdConfig has invalid curves!", displayId);
+    }
+    return isValid;
+}
 } // namespace DisplayPowerMgr
 } // namespace OHOS
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MOCK_BRIGHTNESS_ACTION_H
+#define MOCK_BRIGHTNESS_ACTION_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Number of BrightnessAction::SetBrightness calls since the last reset
+uint64_t MockGetBrightnessWriteCount();
+void MockResetBrightnessWriteCount();
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // MOCK_BRIGHTNESS_ACTION_H
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "brightness_action.h"
+
+#include <atomic>
+
+#include "mock_brightness_action.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+namespace {
+std::atomic<uint64_t> g_brightnessWriteCount{0};
+}
+
+uint64_t MockGetBrightnessWriteCount()
+{
+    return g_brightnessWriteCount.load();
+}
+
+void MockResetBrightnessWriteCount()
+{
+    g_brightnessWriteCount.store(0);
+}
+
+BrightnessAction::BrightnessAction(uint32_t displayId) : mDisplayId(displayId)
+{}
+
+uint32_t BrightnessAction::GetDefaultDisplayId()
+{
+    return DEFAULT_DISPLAY_ID;
+}
+
+std::vector<uint32_t> BrightnessAction::GetAllDisplayId()
+{
+    return { DEFAULT_DISPLAY_ID };
+}
+
+uint32_t BrightnessAction::GetDisplayId()
+{
+    return mDisplayId;
+}
+
+void BrightnessAction::SetDisplayId(uint32_t displayId)
+{
+    mDisplayId = displayId;
+}
+
+DisplayState BrightnessAction::GetDisplayState()
+{
+    return DisplayState::DISPLAY_ON;
+}
+
+bool BrightnessAction::SetDisplayState(DisplayState state, const std::function<void(DisplayState)>& callback)
+{
+    if (callback) {
+        callback(state);
+    }
+    return true;
+}
+
+bool BrightnessAction::SetDisplayPower(DisplayState state, uint32_t reason)
+{
+    return true;
+}
+
+uint32_t BrightnessAction::GetBrightness()
+{
+    std::lock_guard lock(mMutexBrightness);
+    return mBrightness;
+}
+
+bool BrightnessAction::SetBrightness(uint32_t value)
+{
+    return SetBrightness(mDisplayId, value);
+}
+
+bool BrightnessAction::SetBrightness(uint32_t displayId, uint32_t value)
+{
+    std::lock_guard lock(mMutexBrightness);
+    mBrightness = value;
+    g_brightnessWriteCount++;
+    return true;
+}
+} // namespace DisplayPowerMgr
+} // namespace OHOS
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "config_parser.h"
+#include "display_log.h"
+#include "mock_brightness_action.h"
+
+// Access the calculation manager to load the panel config without BrightnessService::Init
+#define private public
+#include "brightness_service.h"
+#undef private
+
+using namespace OHOS;
+using namespace OHOS::DisplayPowerMgr;
+
+namespace {
+void InitBrightnessService()
+{
+    static std::once_flag flag;
+    std::call_once(flag, [] {
+        ConfigParse::Get().Initialize();
+        BrightnessService::Get().mBrightnessCalculationManager.InitParameters();
+    });
+}
+
+void BrightnessFoldStatusLookup(benchmark::State& state)
+{
+    InitBrightnessService();
+    auto& service = BrightnessService::Get();
+    int foldStatus = 0;
+    for (auto _ : state) {
+        auto status = static_cast<Rosen::FoldStatus>(foldStatus);
+        benchmark::DoNotOptimize(service.GetDisplayIdWithFoldstatus(status));
+        benchmark::DoNotOptimize(service.GetSensorIdWithFoldstatus(status));
+        foldStatus = (foldStatus + 1) % static_cast<int>(Rosen::FoldStatus::HALF_FOLD);
+    }
+}
+BENCHMARK(BrightnessFoldStatusLookup);
+
+void BrightnessDisplayModeLookup(benchmark::State& state)
+{
+    InitBrightnessService();
+    auto& service = BrightnessService::Get();
+    int displayMode = 0;
+    for (auto _ : state) {
+        auto mode = static_cast<Rosen::FoldDisplayMode>(displayMode);
+        benchmark::DoNotOptimize(service.GetDisplayIdWithDisplayMode(mode));
+        benchmark::DoNotOptimize(service.GetSensorIdWithDisplayMode(mode));
+        displayMode = (displayMode + 1) % static_cast<int>(Rosen::FoldDisplayMode::COORDINATION);
+    }
+}
+BENCHMARK(BrightnessDisplayModeLookup);
+
+// Listener callback to brightness write, the Rosen write is replaced by mock_brightness_action.cpp
+void BrightnessFoldTransition(benchmark::State& state)
+{
+    InitBrightnessService();
+    BrightnessService::FoldStatusLisener listener;
+    bool isFolded = false;
+    MockResetBrightnessWriteCount();
+    for (auto _ : state) {
+        isFolded = !isFolded;
+        listener.OnFoldStatusChanged(isFolded ? Rosen::FoldStatus::FOLDED : Rosen::FoldStatus::EXPAND);
+    }
+    state.counters["writes_per_transition"] = benchmark::Counter(
+        static_cast<double>(MockGetBrightnessWriteCount()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BrightnessFoldTransition)->Unit(benchmark::kMicrosecond);
+} // namespace
+
+BENCHMARK_MAIN();
@@ -16,8 +16,10 @@
 #include <gtest/gtest.h>
 #include "brightness_config_parser.h"
 #include "calculation_config_parser.h"
+#include "calculation_curve.h"
 #include "config_parser_base.h"
 #include "display_log.h"
+#include "light_lux_manager.h"
 #include "lux_filter_config_parser.h"
 #include "lux_threshold_config_parser.h"
 
@@ -90,7 +92,9 @@ HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest002, TestSize.Level
 
     std::vector<PointXy> data;
     ConfigParserBase parser;
-    parser.ParsePointXy(root_, "points", data);
+    EXPECT_FALSE(parser.ParsePointXy(root_, "points", data));
+    ASSERT_EQ(data.size(), NUMBER_ONE);
+    EXPECT_FALSE(parser.NormalizePointXy("points", data));
     EXPECT_TRUE(data.empty());
     DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest002 function end!");
 }
@@ -141,7 +145,9 @@ HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest006, TestSize.Level
 
     std::vector<PointXy> data;
     ConfigParserBase parser;
-    parser.ParsePointXy(root_, "points", data);
+    EXPECT_FALSE(parser.ParsePointXy(root_, "points", data));
+    ASSERT_EQ(data.size(), NUMBER_ONE);
+    EXPECT_FALSE(parser.NormalizePointXy("points", data));
     EXPECT_TRUE(data.empty());
     DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest006 function end!");
 }
@@ -622,4 +628,112 @@ HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest044, TestSize.Level
     EXPECT_TRUE(ret);
     DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest044 function end!");
 }
+
+HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest045, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest045 function start!");
+    std::vector<PointXy> data{ { POINT_2_X, POINT_2_Y }, { POINT_1_X, POINT_1_Y }, { POINT_2_X, POINT_1_Y } };
+    ConfigParserBase parser;
+    bool ret = parser.NormalizePointXy("points", data);
+    EXPECT_TRUE(ret);
+    ASSERT_EQ(data.size(), NUMBER_TWO);
+    EXPECT_FLOAT_EQ(data[0].x, POINT_1_X);
+    EXPECT_FLOAT_EQ(data[1].x, POINT_2_X);
+    EXPECT_FLOAT_EQ(data[1].y, POINT_1_Y);
+    EXPECT_FLOAT_EQ(data[0].slope, 0.0f);
+    EXPECT_FLOAT_EQ(data[1].slope, 0.0f);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest045 function end!");
+}
+
+HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest046, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest046 function start!");
+    std::vector<PointXy> data{ { POINT_1_X, POINT_1_Y }, { POINT_2_X, POINT_2_Y } };
+    ConfigParserBase parser;
+    EXPECT_TRUE(parser.NormalizePointXy("points", data));
+    ASSERT_EQ(data.size(), NUMBER_TWO);
+    EXPECT_FLOAT_EQ(data[0].slope, (POINT_2_Y - POINT_1_Y) / (POINT_2_X - POINT_1_X));
+
+    data.emplace_back(PointXy{});
+    EXPECT_FALSE(parser.NormalizePointXy("points", data));
+    EXPECT_TRUE(data.empty());
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest046 function end!");
+}
+
+HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest047, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest047 function start!");
+    CalculationConfig::Data data;
+    EXPECT_TRUE(CalculationConfigParser::ValidateConfig(0, data));
+    ASSERT_FALSE(data.defaultPoints.empty());
+    EXPECT_FLOAT_EQ(data.defaultPoints[0].slope,
+        (data.defaultPoints[1].y - data.defaultPoints[0].y) / (data.defaultPoints[1].x - data.defaultPoints[0].x));
+    EXPECT_FLOAT_EQ(data.defaultPoints.back().slope, 0.0f);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest047 function end!");
+}
+
+HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest048, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest048 function start!");
+    CalculationConfig::Data data;
+    const std::string json = R"({"defaultPoints": [[1.5, 2.3], [4.0, "5.0"], [8.0, 9.0]]})";
+    EXPECT_TRUE(CalculationConfigParser::ParseConfigJsonRoot(0, json, data));
+    ASSERT_EQ(data.defaultPoints.size(), NUMBER_ONE);
+    EXPECT_FALSE(CalculationConfigParser::ValidateConfig(0, data));
+    EXPECT_TRUE(data.defaultPoints.empty());
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest048 function end!");
+}
+
+HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest049, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest049 function start!");
+    LuxThresholdConfig::Data data;
+    const std::string json = R"({"brightenPointsForLevel": [[4.0, 1.0], [10.0]],
+        "thresholdMode": [{"modeName": "DefaultMode", "brightenPoints": [[0.0, 5.0], [null, 10.0]]}]})";
+    EXPECT_TRUE(LuxThresholdConfigParser::ParseConfigJsonRoot(json, data));
+    ASSERT_EQ(data.brightenPointsForLevel.size(), NUMBER_ONE);
+    ASSERT_EQ(data.modeArray["DefaultMode"].brightenPoints.size(), NUMBER_ONE);
+    EXPECT_FALSE(LuxThresholdConfigParser::ValidateConfig(0, data));
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest049 function end!");
+}
+
+HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest050, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest050 function start!");
+    std::vector<PointXy> curve{ { 40.0f, 40.0f }, { 10.0f, 20.0f }, { 20.0f, 40.0f } };
+    ConfigParserBase parser;
+    ASSERT_TRUE(parser.NormalizePointXy("points", curve));
+    BrightnessCalculationCurve calculation;
+    // below the first point the default brightness is used
+    EXPECT_FLOAT_EQ(calculation.GetBrightnessCurveLevel(curve, 5.0f), calculation.mDefaultBrightness);
+    EXPECT_FLOAT_EQ(calculation.GetBrightnessCurveLevel(curve, 10.0f), 20.0f);
+    EXPECT_FLOAT_EQ(calculation.GetBrightnessCurveLevel(curve, 15.0f), 30.0f);
+    EXPECT_FLOAT_EQ(calculation.GetBrightnessCurveLevel(curve, 20.0f), 40.0f);
+    EXPECT_FLOAT_EQ(calculation.GetBrightnessCurveLevel(curve, 30.0f), 40.0f);
+    // past the last point its y is held
+    EXPECT_FLOAT_EQ(calculation.GetBrightnessCurveLevel(curve, 50.0f), 40.0f);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest050 function end!");
+}
+
+HWTEST_F(BrightnessConfigParseTest, BrightnessConfigParseTest051, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest051 function start!");
+    std::vector<PointXy> points{ { 10.0f, 0.5f }, { 40.0f, 30.5f }, { 20.0f, 10.5f } };
+    ConfigParserBase parser;
+    ASSERT_TRUE(parser.NormalizePointXy("points", points));
+    LightLuxManager luxManager;
+    EXPECT_LT(luxManager.CalcDelta({}), 0.0f);
+    luxManager.mFilteredLux = 5.0f;
+    EXPECT_FLOAT_EQ(luxManager.CalcDelta(points), 1.0f);
+    // interpolated deltas are clamped to 1
+    luxManager.mFilteredLux = 10.0f;
+    EXPECT_FLOAT_EQ(luxManager.CalcDelta(points), 1.0f);
+    luxManager.mFilteredLux = 15.0f;
+    EXPECT_FLOAT_EQ(luxManager.CalcDelta(points), 5.5f);
+    luxManager.mFilteredLux = 30.0f;
+    EXPECT_FLOAT_EQ(luxManager.CalcDelta(points), 20.5f);
+    luxManager.mFilteredLux = 50.0f;
+    EXPECT_FLOAT_EQ(luxManager.CalcDelta(points), 30.5f);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessConfigParseTest051 function end!");
+}
 } // namespace
@@ -14,9 +14,17 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 #include "display_log.h"
 #include "display_power_mgr_client.h"
+#include "brightness_data_listener_registry.h"
 #include "brightness_manager.h"
+#include "brightness_threshold_monitor.h"
+#include "display_brightness_callback_stub.h"
+#include "display_brightness_listener_stub.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -26,6 +34,56 @@ using namespace std;
 
 namespace {
     const double NO_DISCOUNT = 1.00;
+    const int LISTENER_WAIT_STEP_MS = 10;
+    const int LISTENER_WAIT_MAX_STEPS = 200;
+
+    class TestDataChangeListener : public DisplayBrightnessListenerStub {
+    public:
+        void OnDataChanged(const std::string& params) override
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mLastParams = params;
+            mCount++;
+        }
+        bool WaitFor(int count)
+        {
+            for (int i = 0; i < LISTENER_WAIT_MAX_STEPS && mCount < count; i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(LISTENER_WAIT_STEP_MS));
+            }
+            return mCount >= count;
+        }
+        std::string GetLastParams()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mLastParams;
+        }
+
+        std::atomic<int> mCount{0};
+    private:
+        std::mutex mMutex;
+        std::string mLastParams;
+    };
+
+    class TestThresholdCallback : public DisplayBrightnessCallbackStub {
+    public:
+        void OnNotifyApsLightBrightnessChange(uint32_t type, int32_t state) override
+        {
+            mLastType = type;
+            mLastState = state;
+            mCount++;
+        }
+        bool WaitFor(int count)
+        {
+            for (int i = 0; i < LISTENER_WAIT_MAX_STEPS && mCount < count; i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(LISTENER_WAIT_STEP_MS));
+            }
+            return mCount >= count;
+        }
+
+        std::atomic<int> mCount{0};
+        std::atomic<uint32_t> mLastType{0};
+        std::atomic<int32_t> mLastState{-1};
+    };
 }
 
 class BrightnessManagerTest : public Test {
@@ -95,4 +153,67 @@ HWTEST_F(BrightnessManagerTest, BrightnessManagerSetSceneMode001, TestSize.Level
     EXPECT_FALSE(BrightnessManager::Get().SetSceneMode(SceneModeType::MAX, true));
     DISPLAY_HILOGI(LABEL_TEST, "BrightnessManagerSetSceneMode001 function end!");
 }
+
+// ==================== Data Change Listener Tests ====================
+
+HWTEST_F(BrightnessManagerTest, BrightnessDataListenerRegistry001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessDataListenerRegistry001 function start!");
+    auto& registry = BrightnessDataListenerRegistry::Get();
+    const auto type = DisplayDataChangeListenerType::BRIGHTNESS_TARGET;
+    EXPECT_NE(registry.Register(nullptr, type, "test", ""), 0);
+
+    sptr<TestDataChangeListener> listener = new TestDataChangeListener();
+    EXPECT_EQ(registry.Register(listener, type, "test", R"({"minIntervalMs":500})"), 0);
+    registry.Publish(type, 0, BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, 100);
+    EXPECT_TRUE(listener->WaitFor(1));
+    // Published within the interval: coalesced to the latest value of each display, delivered in one batch
+    registry.Publish(type, 0, BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, 110);
+    registry.Publish(type, 0, BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, 120);
+    registry.Publish(type, 1, BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, 130);
+    registry.Publish(DisplayDataChangeListenerType::STABLE_LUX, 0, BrightnessDataListenerRegistry::FIELD_LUX, 1);
+    EXPECT_TRUE(listener->WaitFor(2));
+    std::string batch = listener->GetLastParams();
+    EXPECT_EQ(batch.find("110"), std::string::npos);
+    EXPECT_NE(batch.find("120"), std::string::npos);
+    EXPECT_NE(batch.find("130"), std::string::npos);
+    EXPECT_EQ(listener->mCount, 2);
+
+    EXPECT_EQ(registry.Unregister(type, "test"), 0);
+    registry.Publish(type, 0, BrightnessDataListenerRegistry::FIELD_BRIGHTNESS, 140);
+    EXPECT_FALSE(listener->WaitFor(3));
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessDataListenerRegistry001 function end!");
+}
+
+// ==================== Light Brightness Threshold Tests ====================
+
+HWTEST_F(BrightnessManagerTest, BrightnessThresholdMonitor001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessThresholdMonitor001 function start!");
+    auto& monitor = BrightnessThresholdMonitor::Get();
+    sptr<TestThresholdCallback> callback = new TestThresholdCallback();
+    EXPECT_FALSE(monitor.Register({-1, -1}, callback));
+    // Lux threshold 200 with hysteresis 20, brightness not monitored
+    EXPECT_TRUE(monitor.Register({200, -1, 20}, callback));
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, 100);
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, 210);
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_BRIGHTNESS, 255);
+    EXPECT_FALSE(callback->WaitFor(1));
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, 220);
+    EXPECT_TRUE(callback->WaitFor(1));
+    EXPECT_EQ(callback->mLastType, BrightnessThresholdMonitor::TYPE_LIGHT);
+    EXPECT_EQ(callback->mLastState, BrightnessThresholdMonitor::STATE_ABOVE);
+    // Within the hysteresis band nothing is sent, under it the client is told once
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, 190);
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, 100);
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, 50);
+    EXPECT_TRUE(callback->WaitFor(2));
+    EXPECT_EQ(callback->mLastState, BrightnessThresholdMonitor::STATE_BELOW);
+    EXPECT_FALSE(callback->WaitFor(3));
+
+    monitor.Remove(callback->AsObject());
+    monitor.OnSample(BrightnessThresholdMonitor::TYPE_LIGHT, 1000);
+    EXPECT_FALSE(callback->WaitFor(3));
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessThresholdMonitor001 function end!");
+}
 } // namespace
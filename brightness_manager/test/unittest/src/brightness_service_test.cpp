@@ -16,13 +16,24 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest-death-test.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 #include "display_log.h"
 #include "display_power_mgr_client.h"
 
 // Make private members accessible for testing
 #define private public
+#include "brightness_manager.h"
+#include "brightness_pipeline_registry.h"
 #include "brightness_service.h"
+#include "brightness_setting_cache.h"
+#include "brightness_setting_helper.h"
+#include "brightness_strand.h"
+#include "brightness_threshold_monitor.h"
 #undef private
+#include "display_brightness_callback_stub.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -38,6 +49,11 @@ namespace {
     const uint32_t MIN_BRIGHTNESS_VALUE = 1;
     const uint32_t MAX_BRIGHTNESS_VALUE = 255;
     const uint32_t TEST_TIMEOUT_MS = 1000;
+    const uint32_t SECONDARY_DISPLAY_ID = 7;
+    const uint32_t BOOST_TIMEOUT_MS = 100;
+    const int32_t STRAND_TEST_THREADS = 4;
+    const int32_t STRAND_TEST_RUNS = 1000;
+    const uint32_t STRAND_WAITER_DELAY_MS = 20;
 }
 
 class BrightnessServiceTest : public Test {
@@ -741,6 +757,54 @@ HWTEST_F(BrightnessServiceTest, GetCurrentDisplayId_ValidDefault_ReturnsId, Test
     DISPLAY_HILOGI(LABEL_TEST, "GetCurrentDisplayId_ValidDefault_ReturnsId end!");
 }
 
+HWTEST_F(BrightnessServiceTest, GetCurrentDisplayId_FoldDevice_UsesCachedMode, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "GetCurrentDisplayId_FoldDevice_UsesCachedMode start!");
+    bool isFoldDevice = brightnessService->mIsFoldDevice;
+    bool isCached = brightnessService->mIsFoldDisplayModeCached;
+    Rosen::FoldDisplayMode foldMode = brightnessService->mFoldDisplayMode;
+
+    brightnessService->mIsFoldDevice = true;
+    brightnessService->mIsFoldDisplayModeCached = true;
+    BrightnessService::DisplayModeListener listener;
+    listener.OnDisplayModeChanged(Rosen::FoldDisplayMode::MAIN);
+    EXPECT_EQ(brightnessService->GetFoldDisplayMode(), Rosen::FoldDisplayMode::MAIN);
+    EXPECT_EQ(brightnessService->GetCurrentDisplayId(0),
+        static_cast<uint32_t>(brightnessService->GetDisplayIdWithDisplayMode(Rosen::FoldDisplayMode::MAIN)));
+    listener.OnDisplayModeChanged(Rosen::FoldDisplayMode::FULL);
+    EXPECT_EQ(brightnessService->GetCurrentDisplayId(0),
+        static_cast<uint32_t>(brightnessService->GetDisplayIdWithDisplayMode(Rosen::FoldDisplayMode::FULL)));
+
+    brightnessService->mIsFoldDevice = false;
+    EXPECT_EQ(brightnessService->GetCurrentDisplayId(1), 1);
+
+    brightnessService->mIsFoldDevice = isFoldDevice;
+    brightnessService->mIsFoldDisplayModeCached = isCached;
+    brightnessService->mFoldDisplayMode = foldMode;
+    DISPLAY_HILOGI(LABEL_TEST, "GetCurrentDisplayId_FoldDevice_UsesCachedMode end!");
+}
+
+HWTEST_F(BrightnessServiceTest, IsFoldDevice_NotSeeded_QueriesDisplayManager, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "IsFoldDevice_NotSeeded_QueriesDisplayManager start!");
+    // Arrange
+    bool isFoldDevice = brightnessService->mIsFoldDevice;
+    bool isSeeded = brightnessService->mIsFoldDeviceSeeded;
+    bool isFoldable = Rosen::DisplayManagerLite::GetInstance().IsFoldable();
+    brightnessService->mIsFoldDevice = !isFoldable;
+    brightnessService->mIsFoldDeviceSeeded = false;
+
+    // Act & Assert
+    EXPECT_EQ(brightnessService->IsFoldDevice(), isFoldable);
+    brightnessService->mIsFoldDeviceSeeded = true;
+    EXPECT_EQ(brightnessService->IsFoldDevice(), !isFoldable);
+
+    // Cleanup
+    brightnessService->mIsFoldDevice = isFoldDevice;
+    brightnessService->mIsFoldDeviceSeeded = isSeeded;
+    DISPLAY_HILOGI(LABEL_TEST, "IsFoldDevice_NotSeeded_QueriesDisplayManager end!");
+}
+
 HWTEST_F(BrightnessServiceTest, GetCurrentSensorId_ReturnsValidId, TestSize.Level1)
 {
     DISPLAY_HILOGI(LABEL_TEST, "GetCurrentSensorId_ReturnsValidId start!");
@@ -757,6 +821,20 @@ HWTEST_F(BrightnessServiceTest, SetCurrentSensorId_ValidId_Success, TestSize.Lev
     DISPLAY_HILOGI(LABEL_TEST, "SetCurrentSensorId_ValidId_Success end!");
 }
 
+HWTEST_F(BrightnessServiceTest, BrightnessParamHelper_InvalidateCache_ReloadsValue, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessParamHelper_InvalidateCache_ReloadsValue start!");
+    uint32_t maxBrightness = BrightnessParamHelper::GetMaxBrightness();
+    EXPECT_EQ(BrightnessParamHelper::mMaxBrightness.load(), static_cast<int64_t>(maxBrightness));
+    EXPECT_EQ(BrightnessParamHelper::GetMaxBrightness(), maxBrightness);
+
+    BrightnessParamHelper::InvalidateCache();
+    EXPECT_EQ(BrightnessParamHelper::mMaxBrightness.load(), BrightnessParamHelper::PARAM_NOT_CACHED);
+    EXPECT_EQ(BrightnessParamHelper::GetMaxBrightness(), maxBrightness);
+    EXPECT_LE(BrightnessParamHelper::GetMinBrightness(), maxBrightness);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessParamHelper_InvalidateCache_ReloadsValue end!");
+}
+
 // ==================== Light Brightness Threshold Tests ====================
 
 HWTEST_F(BrightnessServiceTest, SetLightBrightnessThreshold_EmptyThreshold_ReturnsZero, TestSize.Level1)
@@ -777,6 +855,39 @@ HWTEST_F(BrightnessServiceTest, SetLightBrightnessThreshold_NullCallback_Returns
     DISPLAY_HILOGI(LABEL_TEST, "SetLightBrightnessThreshold_NullCallback_ReturnsZero end!");
 }
 
+HWTEST_F(BrightnessServiceTest, SetLightBrightnessThreshold_SecondaryDisplay_NotSampled, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "SetLightBrightnessThreshold_SecondaryDisplay_NotSampled start!");
+    class ThresholdCallback : public DisplayBrightnessCallbackStub {
+    public:
+        void OnNotifyApsLightBrightnessChange(uint32_t type, int32_t state) override {}
+    };
+    auto& monitor = BrightnessThresholdMonitor::Get();
+    sptr<ThresholdCallback> callback = new ThresholdCallback();
+    ASSERT_TRUE(monitor.Register({-1, static_cast<int32_t>(DEFAULT_BRIGHTNESS_VALUE), 0}, callback));
+    BrightnessService primary;
+    BrightnessService secondary(SECONDARY_DISPLAY_ID, false);
+    auto getDump = [&monitor] {
+        std::string dump;
+        monitor.Dump(dump);
+        return dump;
+    };
+
+    // Act: The secondary display goes above the threshold between two samples of the default one
+    primary.NotifyDeviceBrightnessObserver(MIN_BRIGHTNESS_VALUE);
+    secondary.NotifyDeviceBrightnessObserver(MAX_BRIGHTNESS_VALUE);
+    primary.NotifyDeviceBrightnessObserver(MIN_BRIGHTNESS_VALUE + 1);
+
+    // Assert: Only the default display moves the client
+    EXPECT_NE(getDump().find("BrightnessState=0 Notified=0"), std::string::npos);
+    primary.NotifyDeviceBrightnessObserver(MAX_BRIGHTNESS_VALUE);
+    EXPECT_NE(getDump().find("BrightnessState=1 Notified=1"), std::string::npos);
+
+    // Cleanup
+    monitor.Remove(callback->AsObject());
+    DISPLAY_HILOGI(LABEL_TEST, "SetLightBrightnessThreshold_SecondaryDisplay_NotSampled end!");
+}
+
 // ==================== Sensor Support Tests ====================
 
 HWTEST_F(BrightnessServiceTest, IsSupportLightSensor_ReturnsBool, TestSize.Level1)
@@ -827,6 +938,120 @@ HWTEST_F(BrightnessServiceTest, GetSettingAutoBrightness_DefaultKey_ReturnsBool,
 // which is not available in this test environment
 // These tests should be implemented with proper mocking of BrightnessSettingHelper
 
+HWTEST_F(BrightnessServiceTest, SetSettingBrightness_WriteBehind_CoalescesPendingValue, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "SetSettingBrightness_WriteBehind_CoalescesPendingValue start!");
+    uint32_t original = brightnessService->GetSettingBrightness();
+    uint32_t target = (original == DEFAULT_BRIGHTNESS_VALUE) ? DEFAULT_BRIGHTNESS_VALUE + 1 : DEFAULT_BRIGHTNESS_VALUE;
+
+    // Act: Several values in a row are held in memory, only the last one is left to be written
+    BrightnessSettingHelper::SetSettingBrightness(MIN_BRIGHTNESS_VALUE);
+    BrightnessSettingHelper::SetSettingBrightness(MAX_BRIGHTNESS_VALUE);
+    BrightnessSettingHelper::SetSettingBrightness(target);
+
+    // Assert: Reads see the pending value before it reaches the setting store
+    EXPECT_TRUE(BrightnessSettingHelper::mHasPendingSettingBrightness);
+    EXPECT_EQ(BrightnessSettingHelper::mPendingSettingBrightness, target);
+    EXPECT_EQ(brightnessService->GetSettingBrightness(), target);
+
+    // Act: Flush as on screen off
+    BrightnessSettingHelper::FlushSettingBrightness();
+    EXPECT_FALSE(BrightnessSettingHelper::mHasPendingSettingBrightness);
+
+    // Cleanup
+    BrightnessSettingHelper::SetSettingBrightness(original);
+    BrightnessSettingHelper::FlushSettingBrightness();
+    DISPLAY_HILOGI(LABEL_TEST, "SetSettingBrightness_WriteBehind_CoalescesPendingValue end!");
+}
+
+HWTEST_F(BrightnessServiceTest, SetSettingBrightness_ExternalChange_WritesAgain, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "SetSettingBrightness_ExternalChange_WritesAgain start!");
+    uint32_t original = brightnessService->GetSettingBrightness();
+    auto& cache = BrightnessSettingCache::Get();
+    const std::string key = BrightnessSettingHelper::SETTING_BRIGHTNESS_KEY;
+    if (!cache.IsObserved(key)) {
+        // Without an observer every value is written, there is nothing to invalidate
+        DISPLAY_HILOGI(LABEL_TEST, "SetSettingBrightness_ExternalChange_WritesAgain skipped");
+        return;
+    }
+    uint32_t target = (original == DEFAULT_BRIGHTNESS_VALUE) ? DEFAULT_BRIGHTNESS_VALUE + 1 : DEFAULT_BRIGHTNESS_VALUE;
+    BrightnessSettingHelper::SetSettingBrightness(target);
+    BrightnessSettingHelper::FlushSettingBrightness();
+
+    // Assert: Repeating the stored value is dropped
+    BrightnessSettingHelper::SetSettingBrightness(target);
+    EXPECT_FALSE(BrightnessSettingHelper::mHasPendingSettingBrightness);
+
+    // Act: Another writer changes the store, as the setting observer reports it
+    cache.UpdateIntValue(key, static_cast<int32_t>(MIN_BRIGHTNESS_VALUE));
+    BrightnessSettingHelper::SetSettingBrightness(target);
+
+    // Assert: The same value is written again
+    EXPECT_TRUE(BrightnessSettingHelper::mHasPendingSettingBrightness);
+
+    // Cleanup
+    BrightnessSettingHelper::SetSettingBrightness(original);
+    BrightnessSettingHelper::FlushSettingBrightness();
+    DISPLAY_HILOGI(LABEL_TEST, "SetSettingBrightness_ExternalChange_WritesAgain end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessSettingCache_ObservedKey_ServesWrittenValue, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessSettingCache_ObservedKey_ServesWrittenValue start!");
+    auto& cache = BrightnessSettingCache::Get();
+    const std::string key = BrightnessSettingHelper::SETTING_AUTO_ADJUST_BRIGHTNESS_KEY;
+    int32_t original = 0;
+    if (cache.GetIntValue(key, original) != ERR_OK || !cache.IsObserved(key)) {
+        // No setting store or observer in this environment, reads keep going to the store
+        DISPLAY_HILOGI(LABEL_TEST, "BrightnessSettingCache_ObservedKey_ServesWrittenValue skipped");
+        return;
+    }
+
+    // Act: A value written by this process replaces the cached one and moves the generation
+    uint32_t generation = cache.GetGeneration();
+    int32_t updated = (original == 0) ? 1 : 0;
+    cache.UpdateIntValue(key, updated);
+
+    // Assert: The next read is served from memory
+    int32_t value = original;
+    EXPECT_EQ(cache.GetIntValue(key, value), ERR_OK);
+    EXPECT_EQ(value, updated);
+    EXPECT_NE(cache.GetGeneration(), generation);
+
+    // Cleanup
+    cache.UpdateIntValue(key, original);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessSettingCache_ObservedKey_ServesWrittenValue end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessSettingCache_DeInit_DropsObservers, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessSettingCache_DeInit_DropsObservers start!");
+    auto& cache = BrightnessSettingCache::Get();
+    const std::string key = BrightnessSettingHelper::SETTING_AUTO_ADJUST_BRIGHTNESS_KEY;
+    int32_t value = 0;
+    cache.GetIntValue(key, value);
+    auto entry = cache.FindEntry(key);
+    ASSERT_NE(entry, nullptr);
+    if (!entry->observed) {
+        // Assert: A failed registration is not retried before the back-off has passed
+        EXPECT_GT(entry->nextWatchTimeMs.load(), 0);
+        cache.GetIntValue(key, value);
+        EXPECT_EQ(cache.FindEntry(key), entry);
+        EXPECT_FALSE(entry->observed);
+    }
+
+    // Act
+    uint32_t generation = cache.GetGeneration();
+    cache.DeInit();
+
+    // Assert: Nothing is watched or served from memory any more
+    EXPECT_EQ(cache.FindEntry(key), nullptr);
+    EXPECT_FALSE(cache.IsObserved(key));
+    EXPECT_NE(cache.GetGeneration(), generation);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessSettingCache_DeInit_DropsObservers end!");
+}
+
 // ==================== Screen Power Status Tests ====================
 
 HWTEST_F(BrightnessServiceTest, NotifyScreenPowerStatus_ValidInput_ReturnsZero, TestSize.Level1)
@@ -1178,6 +1403,35 @@ HWTEST_F(BrightnessServiceTest, ProcessLightLux_VaryingLux_Success, TestSize.Lev
     DISPLAY_HILOGI(LABEL_TEST, "ProcessLightLux_VaryingLux_Success end!");
 }
 
+HWTEST_F(BrightnessServiceTest, ProcessLightLux_WhenOverridden_KeepsLuxValid, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "ProcessLightLux_WhenOverridden_KeepsLuxValid start!");
+    // Arrange
+    brightnessService->SetDisplayState(0, DisplayState::DISPLAY_ON);
+    if (brightnessService->IsBrightnessBoosted()) {
+        brightnessService->CancelBoostBrightness(0);
+    }
+    std::atomic<int> validCount {0};
+    std::atomic<int> invalidCount {0};
+    brightnessService->SetLuxObserver([&validCount, &invalidCount](bool isValid, float, float, float) {
+        (isValid ? validCount : invalidCount)++;
+    });
+    brightnessService->ProcessLightLux(100.0f);
+    EXPECT_GT(validCount.load(), 0);
+
+    // Act: The brightness can not be set, the sensor keeps reporting
+    ASSERT_TRUE(brightnessService->OverrideBrightness(DEFAULT_BRIGHTNESS_VALUE));
+    brightnessService->ProcessLightLux(200.0f);
+
+    // Assert: The lux is not reported invalid
+    EXPECT_EQ(invalidCount.load(), 0);
+
+    // Cleanup
+    brightnessService->RestoreBrightness();
+    brightnessService->SetLuxObserver(nullptr);
+    DISPLAY_HILOGI(LABEL_TEST, "ProcessLightLux_WhenOverridden_KeepsLuxValid end!");
+}
+
 // ==================== SetBrightnessLevel Tests ====================
 
 HWTEST_F(BrightnessServiceTest, SetBrightnessLevel_WithZeroDuration_Success, TestSize.Level1)
@@ -1420,4 +1674,170 @@ HWTEST_F(BrightnessServiceTest, OverrideBrightness_SecondOverride_UpdatesValue,
     DISPLAY_HILOGI(LABEL_TEST, "OverrideBrightness_SecondOverride_UpdatesValue end!");
 }
 
+HWTEST_F(BrightnessServiceTest, BrightnessPipeline_SecondaryDisplay_KeepsOwnState, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessPipeline_SecondaryDisplay_KeepsOwnState start!");
+    brightnessService->SetDisplayState(0, DisplayState::DISPLAY_ON);
+    brightnessService->DiscountBrightness(NO_DISCOUNT);
+    auto& registry = BrightnessPipelineRegistry::Get();
+    auto pipeline = registry.Add(SECONDARY_DISPLAY_ID);
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_FALSE(pipeline->IsDefaultPipeline());
+    EXPECT_EQ(registry.Find(SECONDARY_DISPLAY_ID), pipeline);
+    EXPECT_EQ(registry.Add(SECONDARY_DISPLAY_ID), pipeline);
+
+    // State and discount of the secondary display do not leak into the default pipeline
+    pipeline->SetDisplayState(SECONDARY_DISPLAY_ID, DisplayState::DISPLAY_ON);
+    EXPECT_TRUE(pipeline->DiscountBrightness(HALF_DISCOUNT));
+    EXPECT_DOUBLE_EQ(pipeline->GetDiscount(), HALF_DISCOUNT);
+    EXPECT_DOUBLE_EQ(brightnessService->GetDiscount(), NO_DISCOUNT);
+    pipeline->SetDisplayState(SECONDARY_DISPLAY_ID, DisplayState::DISPLAY_OFF);
+    EXPECT_EQ(pipeline->GetDisplayState(), DisplayState::DISPLAY_OFF);
+    EXPECT_TRUE(brightnessService->IsScreenOn());
+
+    // A detached display falls back to the default pipeline
+    EXPECT_TRUE(registry.Remove(SECONDARY_DISPLAY_ID));
+    EXPECT_EQ(registry.Find(SECONDARY_DISPLAY_ID), nullptr);
+    std::shared_ptr<BrightnessService> holder;
+    EXPECT_EQ(&registry.Resolve(SECONDARY_DISPLAY_ID, holder), brightnessService);
+    EXPECT_EQ(registry.Add(brightnessService->GetDisplayId()), nullptr);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessPipeline_SecondaryDisplay_KeepsOwnState end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessPipeline_OverrideSecondary_LeavesDefault, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessPipeline_OverrideSecondary_LeavesDefault start!");
+    brightnessService->SetDisplayState(0, DisplayState::DISPLAY_ON);
+    auto& registry = BrightnessPipelineRegistry::Get();
+    auto pipeline = registry.Add(SECONDARY_DISPLAY_ID);
+    ASSERT_NE(pipeline, nullptr);
+    pipeline->SetDisplayState(SECONDARY_DISPLAY_ID, DisplayState::DISPLAY_ON);
+
+    // Override and restore of a secondary display act on its own pipeline only
+    EXPECT_TRUE(BrightnessManager::Get().OverrideDisplayBrightness(SECONDARY_DISPLAY_ID, DEFAULT_BRIGHTNESS_VALUE));
+    EXPECT_TRUE(BrightnessManager::Get().IsDisplayBrightnessOverridden(SECONDARY_DISPLAY_ID));
+    EXPECT_FALSE(brightnessService->IsBrightnessOverridden());
+    EXPECT_TRUE(BrightnessManager::Get().RestoreDisplayBrightness(SECONDARY_DISPLAY_ID));
+    EXPECT_FALSE(pipeline->IsBrightnessOverridden());
+
+    pipeline->SetDisplayState(SECONDARY_DISPLAY_ID, DisplayState::DISPLAY_OFF);
+    EXPECT_TRUE(registry.Remove(SECONDARY_DISPLAY_ID));
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessPipeline_OverrideSecondary_LeavesDefault end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessStrand_ConcurrentRuns_AreSerialized, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessStrand_ConcurrentRuns_AreSerialized start!");
+    BrightnessStrand strand;
+    int32_t counter = 0;
+    std::atomic<int32_t> running {0};
+    std::atomic<bool> overlapped {false};
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < STRAND_TEST_THREADS; i++) {
+        threads.emplace_back([&] {
+            for (int32_t run = 0; run < STRAND_TEST_RUNS; run++) {
+                int32_t value = strand.Run([&] {
+                    if (running.fetch_add(1) != 0) {
+                        overlapped = true;
+                    }
+                    // Nested runs on the same strand execute inline
+                    int32_t result = strand.Run([&] { return ++counter; });
+                    running.fetch_sub(1);
+                    return result;
+                });
+                EXPECT_GT(value, 0);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_EQ(counter, STRAND_TEST_THREADS * STRAND_TEST_RUNS);
+    EXPECT_FALSE(strand.IsCurrent());
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessStrand_ConcurrentRuns_AreSerialized end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessStrand_Waiter_RunsOwnTaskOnly, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessStrand_Waiter_RunsOwnTaskOnly start!");
+    BrightnessStrand strand;
+    std::atomic<bool> isWaiterStarted {false};
+    std::thread::id ownerRunner;
+    std::thread::id waiterRunner;
+    std::thread waiter;
+    strand.Run([&] {
+        ownerRunner = std::this_thread::get_id();
+        waiter = std::thread([&] {
+            isWaiterStarted = true;
+            strand.Run([&] { waiterRunner = std::this_thread::get_id(); });
+        });
+        while (!isWaiterStarted.load()) {
+            std::this_thread::yield();
+        }
+        // Gives the waiter time to queue up behind this task
+        std::this_thread::sleep_for(std::chrono::milliseconds(STRAND_WAITER_DELAY_MS));
+    });
+    // The owner left without running the waiter's task, the waiter ran it on its own thread
+    std::thread::id waiterThread = waiter.get_id();
+    waiter.join();
+    EXPECT_EQ(ownerRunner, std::this_thread::get_id());
+    EXPECT_EQ(waiterRunner, waiterThread);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessStrand_Waiter_RunsOwnTaskOnly end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessService_NestedRun_PublishesOnce, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessService_NestedRun_PublishesOnce start!");
+    double discount = brightnessService->mSnapshot.Load().discount;
+    brightnessService->RunOnStrand([&] {
+        brightnessService->RunOnStrand([&] { brightnessService->mDiscount = HALF_DISCOUNT; });
+        // Not published before the outermost task is done
+        EXPECT_DOUBLE_EQ(brightnessService->mSnapshot.Load().discount, discount);
+    });
+    EXPECT_DOUBLE_EQ(brightnessService->mSnapshot.Load().discount, HALF_DISCOUNT);
+    brightnessService->RunOnStrand([&] { brightnessService->mDiscount = discount; });
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessService_NestedRun_PublishesOnce end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessService_StateChange_PublishesSnapshot, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessService_StateChange_PublishesSnapshot start!");
+    brightnessService->SetDisplayState(0, DisplayState::DISPLAY_ON);
+    EXPECT_TRUE(brightnessService->DiscountBrightness(HALF_DISCOUNT));
+    auto snapshot = brightnessService->GetStateSnapshot();
+    EXPECT_EQ(snapshot.state, DisplayState::DISPLAY_ON);
+    EXPECT_DOUBLE_EQ(snapshot.discount, HALF_DISCOUNT);
+
+    brightnessService->SetDisplayState(0, DisplayState::DISPLAY_OFF);
+    EXPECT_EQ(brightnessService->GetStateSnapshot().state, DisplayState::DISPLAY_OFF);
+    EXPECT_EQ(brightnessService->GetDisplayState(), DisplayState::DISPLAY_OFF);
+
+    brightnessService->SetDisplayState(0, DisplayState::DISPLAY_ON);
+    brightnessService->DiscountBrightness(NO_DISCOUNT);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessService_StateChange_PublishesSnapshot end!");
+}
+
+HWTEST_F(BrightnessServiceTest, BrightnessService_BoostTimeout_NotifiesChange, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessService_BoostTimeout_NotifiesChange start!");
+    brightnessService->SetDisplayState(0, DisplayState::DISPLAY_ON);
+    if (brightnessService->IsBrightnessOverridden()) {
+        brightnessService->RestoreBrightness(0);
+    }
+    std::atomic<int32_t> changes {0};
+    BrightnessService::SetChangeObserver([&changes] { changes++; });
+    ASSERT_TRUE(brightnessService->BoostBrightness(BOOST_TIMEOUT_MS, 0));
+    EXPECT_TRUE(brightnessService->GetPublishedState().isBrightnessBoosted);
+    int32_t changesBoosted = changes.load();
+    EXPECT_GT(changesBoosted, 0);
+
+    // Nobody waits for the timeout task, the change is still reported
+    std::this_thread::sleep_for(std::chrono::milliseconds(BOOST_TIMEOUT_MS * 3));
+    EXPECT_FALSE(brightnessService->GetPublishedState().isBrightnessBoosted);
+    EXPECT_GT(changes.load(), changesBoosted);
+    BrightnessService::SetChangeObserver(nullptr);
+    DISPLAY_HILOGI(LABEL_TEST, "BrightnessService_BoostTimeout_NotifiesChange end!");
+}
+
 } // namespace
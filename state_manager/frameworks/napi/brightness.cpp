@@ -31,10 +31,6 @@ const uint32_t ARGV_CONTINUOUS_INDEX = 1;
 const uint32_t ERR_DATA_INDEX = 0;
 const uint32_t ERR_CODE_INDEX = 1;
 const uint32_t MAX_FAIL_ARGC = 2;
-const uint32_t MAX_BRIGHTNESS = DisplayPowerMgrClient::GetInstance().GetMaxBrightness();
-const uint32_t MIN_BRIGHTNESS = DisplayPowerMgrClient::GetInstance().GetMinBrightness();
-const uint32_t DEFAULT_BRIGHTNESS = DisplayPowerMgrClient::GetInstance().GetDefaultBrightness();
-const uint32_t MAIN_DISPLAY_ID = DisplayPowerMgrClient::GetInstance().GetMainDisplayId();
 
 const std::string FUNC_SUCEESS_NAME = "success";
 const std::string FUNC_FAIL_NAME = "fail";
@@ -48,6 +44,17 @@ const std::string GET_VALUE_ERROR_MGR = "get system screen brightness fail";
 const std::string SET_MODE_ERROR_MGR = "value is not an available number";
 const std::string SET_MODE_NOT_SUPPORTED_ERROR_MGR = "Auto adjusting brightness is not supported";
 const std::string SET_KEEP_SCREENON_ERROR_MGR = "value is not an available boolean";
+
+// Brightness limits are fetched on first use and cached by the client, so loading this module costs no IPC.
+uint32_t GetMaxBrightness()
+{
+    return DisplayPowerMgrClient::GetInstance().GetMaxBrightness();
+}
+
+uint32_t GetMinBrightness()
+{
+    return DisplayPowerMgrClient::GetInstance().GetMinBrightness();
+}
 } // namespace
 
 std::map<DisplayErrors, std::string> Brightness::Result::errorTable_ = {
@@ -70,7 +77,7 @@ Brightness::~Brightness()
 void Brightness::GetValue()
 {
     uint32_t brightness = brightnessInfo_.GetBrightness();
-    if (brightness < MIN_BRIGHTNESS || brightness > MAX_BRIGHTNESS) {
+    if (brightness < GetMinBrightness() || brightness > GetMaxBrightness()) {
         result_.Error(COMMON_ERROR_COED, GET_VALUE_ERROR_MGR);
     } else {
         result_.SetResult(BRIGHTNESS_VALUE, brightness);
@@ -88,7 +95,7 @@ void Brightness::SetValue(napi_callback_info& info)
         return;
     }
 
-    int32_t value = MIN_BRIGHTNESS;
+    int32_t value = static_cast<int32_t>(GetMinBrightness());
     bool continuous = false;
     if (napi_get_value_int32(env_, napiBrightness, &value) != napi_ok) {
         if (napiUndefined != nullptr) {
@@ -141,7 +148,7 @@ void Brightness::SystemSetValue()
     if (napiValRef_ == nullptr) {
         result_.Error(INPUT_ERROR_CODE, SET_VALUE_ERROR_MGR);
     } else {
-        int32_t brightness = MIN_BRIGHTNESS;
+        int32_t brightness = static_cast<int32_t>(GetMinBrightness());
         napi_value napiVal = nullptr;
         napi_get_reference_value(env_, napiValRef_, &napiVal);
         napi_get_value_int32(env_, napiVal, &brightness);
@@ -314,7 +321,8 @@ napi_value Brightness::Result::GetResult(napi_env env)
 
 uint32_t Brightness::BrightnessInfo::GetBrightness() const
 {
-    uint32_t brightness = DisplayPowerMgrClient::GetInstance().GetBrightness(MAIN_DISPLAY_ID);
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    uint32_t brightness = client.GetBrightness(static_cast<uint32_t>(client.GetMainDisplayId()));
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Get brightness: %{public}d", brightness);
     return brightness;
 }
@@ -322,8 +330,10 @@ uint32_t Brightness::BrightnessInfo::GetBrightness() const
 bool Brightness::BrightnessInfo::SetBrightness(int32_t value, bool continuous)
 {
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "Set brightness: %{public}d, %{public}d", value, continuous);
-    value = value > static_cast<int32_t>(MAX_BRIGHTNESS) ? static_cast<int32_t>(MAX_BRIGHTNESS) : value;
-    value = value < static_cast<int32_t>(MIN_BRIGHTNESS) ? static_cast<int32_t>(MIN_BRIGHTNESS) : value;
+    int32_t maxBrightness = static_cast<int32_t>(GetMaxBrightness());
+    int32_t minBrightness = static_cast<int32_t>(GetMinBrightness());
+    value = value > maxBrightness ? maxBrightness : value;
+    value = value < minBrightness ? minBrightness : value;
     bool isSucc = DisplayPowerMgrClient::GetInstance().SetBrightness(value, 0, continuous);
     if (!isSucc) {
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "Failed to set brightness: %{public}d", value);
@@ -18,12 +18,14 @@
 #include <if_system_ability_manager.h>
 #include <iservice_registry.h>
 #include <system_ability_definition.h>
+#include <thread>
 #include "new"
 #include "refbase.h"
 #include "iremote_broker.h"
 #include "iremote_object.h"
 
 #include "display_log.h"
+#include "ffrt_utils.h"
 #include "display_common.h"
 #include "display_power_info.h"
 #include "idisplay_power_callback.h"
@@ -43,11 +45,40 @@ namespace {
 constexpr int32_t DEFAULT_VALUE = -1;
 constexpr uint32_t BRIGHTNESS_DEFAULT_PROXY = 0;
 }
-sptr<IDisplayPowerMgr> DisplayPowerMgrClient::GetProxy()
+std::shared_ptr<DisplayPowerMgrClient::Connection> DisplayPowerMgrClient::LoadConnection()
+{
+    // Lock-free: the reader pins the published pointer in its epoch only until it holds a reference
+    auto& readers = readers_[readerEpoch_.load() & 1U];
+    readers.fetch_add(1);
+    Connection* published = publishedConnection_.load();
+    std::shared_ptr<Connection> connection = published != nullptr ? published->shared_from_this() : nullptr;
+    readers.fetch_sub(1);
+    return connection;
+}
+
+void DisplayPowerMgrClient::PublishConnection(std::shared_ptr<Connection> connection)
+{
+    // Called with mutex_ held. Readers that may still see the previous pointer have pinned it in the old
+    // epoch, readers arriving later load the new one, so only the old epoch is drained before releasing it.
+    publishedConnection_.store(connection.get());
+    uint32_t epoch = readerEpoch_.fetch_add(1);
+    while (readers_[epoch & 1U].load() != 0) {
+        std::this_thread::yield();
+    }
+    connection_.swap(connection);
+}
+
+std::shared_ptr<DisplayPowerMgrClient::Connection> DisplayPowerMgrClient::GetConnection()
 {
+    auto connection = LoadConnection();
+    if (connection != nullptr) {
+        return connection;
+    }
+
     std::lock_guard lock(mutex_);
-    if (proxy_ != nullptr) {
-        return proxy_;
+    connection = connection_;
+    if (connection != nullptr) {
+        return connection;
     }
 
     sptr<ISystemAbilityManager> sam = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
@@ -70,10 +101,17 @@ sptr<IDisplayPowerMgr> DisplayPowerMgrClient::GetProxy()
         return nullptr;
     }
 
-    proxy_ = iface_cast<IDisplayPowerMgr>(obj);
+    connection = std::make_shared<Connection>(iface_cast<IDisplayPowerMgr>(obj));
     deathRecipient_ = dr;
+    PublishConnection(connection);
     DISPLAY_HILOGI(COMP_FWK, "Succeed to connect display manager service, pid=%{public}d", getpid());
-    return proxy_;
+    return connection;
+}
+
+sptr<IDisplayPowerMgr> DisplayPowerMgrClient::GetProxy()
+{
+    auto connection = GetConnection();
+    return connection != nullptr ? connection->proxy : nullptr;
 }
 
 void DisplayPowerMgrClient::OnRemoteDied(const wptr<IRemoteObject>& remote)
@@ -84,15 +122,99 @@ void DisplayPowerMgrClient::OnRemoteDied(const wptr<IRemoteObject>& remote)
     }
 
     std::lock_guard lock(mutex_);
-    RETURN_IF(proxy_ == nullptr);
+    auto connection = connection_;
+    RETURN_IF(connection == nullptr || connection->proxy == nullptr);
 
-    auto serviceRemote = proxy_->AsObject();
+    auto serviceRemote = connection->proxy->AsObject();
     if ((serviceRemote != nullptr) && (serviceRemote == remote.promote())) {
         serviceRemote->RemoveDeathRecipient(deathRecipient_);
-        proxy_ = nullptr;
+        // Callers still holding the dead connection keep it and its snapshot mapping until they return
+        PublishConnection(nullptr);
+        {
+            std::lock_guard limitsLock(limitsMutex_);
+            isLimitsCached_ = false;
+            limitsEpoch_++;
+        }
     }
 }
 
+ErrCode DisplayPowerMgrClient::GetBrightnessLimits(BrightnessLimits& limits, bool isMainDisplayNeeded)
+{
+    uint32_t generation = 0;
+    bool isGenerationKnown = ReadLimitsGeneration(generation);
+    uint64_t epoch = 0;
+    {
+        std::lock_guard lock(limitsMutex_);
+        bool isCacheValid = isLimitsCached_ && (isGenerationKnown ?
+            (isCachedGenerationKnown_ && cachedLimitsGeneration_ == generation) : !isMainDisplayNeeded);
+        if (isCacheValid) {
+            limits = limits_;
+            return ERR_OK;
+        }
+        epoch = limitsEpoch_;
+    }
+    // Concurrent callers may fetch at the same time, which is cheaper than serializing them on the IPC
+    auto proxy = GetProxy();
+    RETURN_IF_WITH_RET(proxy == nullptr, ERR_NO_INIT);
+    BrightnessLimits fetched;
+    auto ret = proxy->GetBrightnessLimits(fetched.maxBrightness, fetched.minBrightness,
+        fetched.defaultBrightness, fetched.mainDisplayId);
+    if (ret != ERR_OK) {
+        DISPLAY_HILOGE(COMP_FWK, "GetBrightnessLimits, ret = %{public}d", ret);
+        return ret;
+    }
+    {
+        std::lock_guard lock(limitsMutex_);
+        if (limitsEpoch_ == epoch) {
+            limits_ = fetched;
+            cachedLimitsGeneration_ = generation;
+            isCachedGenerationKnown_ = isGenerationKnown;
+            isLimitsCached_ = true;
+        }
+    }
+    limits = fetched;
+    return ERR_OK;
+}
+
+bool DisplayPowerMgrClient::ReadLimitsGeneration(uint32_t& generation)
+{
+    auto reader = GetSnapshotReader();
+    return reader != nullptr && reader->ReadLimitsGeneration(generation);
+}
+
+bool DisplayPowerMgrClient::ReadSnapshot(uint32_t displayId, DisplayPowerSnapshotData& data)
+{
+    auto reader = GetSnapshotReader();
+    return reader != nullptr && reader->Read(displayId, data);
+}
+
+std::shared_ptr<const DisplayPowerSnapshotReader> DisplayPowerMgrClient::GetSnapshotReader()
+{
+    auto connection = GetConnection();
+    RETURN_IF_WITH_RET(connection == nullptr, nullptr);
+    // Only one attempt per connection, a service without the snapshot is served by IPC from then on
+    if (connection->snapshotReader.load(std::memory_order_acquire) == nullptr &&
+        !connection->isSnapshotRequested.exchange(true)) {
+        int fd = -1;
+        auto ret = connection->proxy->GetPowerSnapshot(fd);
+        if (ret != ERR_OK) {
+            DISPLAY_HILOGW(COMP_FWK, "GetPowerSnapshot, ret = %{public}d", ret);
+            return nullptr;
+        }
+        auto mapped = std::make_unique<DisplayPowerSnapshotReader>();
+        if (!mapped->Map(fd)) {
+            DISPLAY_HILOGW(COMP_FWK, "Failed to map power snapshot");
+            return nullptr;
+        }
+        connection->snapshotOwner = std::move(mapped);
+        connection->snapshotReader.store(connection->snapshotOwner.get(), std::memory_order_release);
+    }
+    auto reader = connection->snapshotReader.load(std::memory_order_acquire);
+    RETURN_IF_WITH_RET(reader == nullptr, nullptr);
+    // The reader shares ownership of its connection, which keeps the mapping alive
+    return std::shared_ptr<const DisplayPowerSnapshotReader>(connection, reader);
+}
+
 bool DisplayPowerMgrClient::SetScreenDisplayState(uint64_t screenId, DisplayState state, uint32_t reason)
 {
     auto proxy = GetProxy();
@@ -121,6 +243,10 @@ bool DisplayPowerMgrClient::SetDisplayState(DisplayState state,
 
 DisplayState DisplayPowerMgrClient::GetDisplayState(uint32_t id)
 {
+    DisplayPowerSnapshotData snapshot;
+    if (ReadSnapshot(id, snapshot) && (snapshot.flags & SNAPSHOT_STATE_VALID) != 0) {
+        return static_cast<DisplayState>(snapshot.state);
+    }
     auto proxy = GetProxy();
     if (proxy == nullptr) {
         return DisplayState::DISPLAY_UNKNOWN;
@@ -150,15 +276,13 @@ std::vector<uint32_t> DisplayPowerMgrClient::GetDisplayIds()
 
 int32_t DisplayPowerMgrClient::GetMainDisplayId()
 {
-    auto proxy = GetProxy();
-    RETURN_IF_WITH_RET(proxy == nullptr, INVALID_DISPLAY_ID);
-    uint32_t id = DEFAULT_MAIN_DISPLAY_ID;
-    auto ret = proxy->GetMainDisplayId(id);
+    BrightnessLimits limits;
+    auto ret = GetBrightnessLimits(limits, true);
+    RETURN_IF_WITH_RET(ret == ERR_NO_INIT, INVALID_DISPLAY_ID);
     if (ret != ERR_OK) {
-        DISPLAY_HILOGE(COMP_FWK, "GetMainDisplayId, ret = %{public}d", ret);
         return DEFAULT_MAIN_DISPLAY_ID;
     }
-    return id;
+    return static_cast<int32_t>(limits.mainDisplayId);
 }
 
 bool DisplayPowerMgrClient::SetForcedBrightness(double value, uint32_t displayId, uint32_t duration,
@@ -175,6 +299,47 @@ bool DisplayPowerMgrClient::SetForcedBrightness(double value, uint32_t displayId
     return result;
 }
 
+void DisplayPowerMgrClient::SubmitAsyncTask(std::function<void()> task)
+{
+    std::call_once(asyncQueueFlag_, [this] {
+        asyncQueue_ = std::make_shared<PowerMgr::FFRTQueue>("display_power_mgr_client");
+    });
+    PowerMgr::FFRTTask ffrtTask = std::move(task);
+    PowerMgr::FFRTUtils::SubmitDelayTask(ffrtTask, 0, asyncQueue_);
+}
+
+std::future<bool> DisplayPowerMgrClient::SetDisplayStateAsync(DisplayState state,
+    PowerMgr::StateChangeReason reason, uint32_t id)
+{
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future();
+    SetDisplayStateAsync(state, [promise](bool result) { promise->set_value(result); }, reason, id);
+    return future;
+}
+
+void DisplayPowerMgrClient::SetDisplayStateAsync(DisplayState state, std::function<void(bool)> callback,
+    PowerMgr::StateChangeReason reason, uint32_t id)
+{
+    SubmitAsyncTask([this, state, callback = std::move(callback), reason, id] {
+        bool result = SetDisplayState(state, reason, id);
+        if (callback) {
+            callback(result);
+        }
+    });
+}
+
+bool DisplayPowerMgrClient::SetBrightnessAsync(uint32_t value, uint32_t displayId, bool continuous)
+{
+    auto proxy = GetProxy();
+    RETURN_IF_WITH_RET(proxy == nullptr, false);
+    auto ret = proxy->SetBrightnessAsync(value, displayId, continuous);
+    if (ret != ERR_OK) {
+        DISPLAY_HILOGE(COMP_FWK, "SetBrightnessAsync, ret = %{public}d", ret);
+        return false;
+    }
+    return true;
+}
+
 bool DisplayPowerMgrClient::SetBrightness(uint32_t value, uint32_t displayId, bool continuous)
 {
     auto proxy = GetProxy();
@@ -244,6 +409,10 @@ bool DisplayPowerMgrClient::RestoreBrightness(uint32_t displayId, uint32_t durat
 
 uint32_t DisplayPowerMgrClient::GetBrightness(uint32_t displayId)
 {
+    DisplayPowerSnapshotData snapshot;
+    if (ReadSnapshot(displayId, snapshot) && (snapshot.flags & SNAPSHOT_BRIGHTNESS_VALID) != 0) {
+        return snapshot.brightness;
+    }
     auto proxy = GetProxy();
     RETURN_IF_WITH_RET(proxy == nullptr, BRIGHTNESS_OFF);
     uint32_t brightness = BRIGHTNESS_OFF;
@@ -257,41 +426,35 @@ uint32_t DisplayPowerMgrClient::GetBrightness(uint32_t displayId)
 
 uint32_t DisplayPowerMgrClient::GetDefaultBrightness()
 {
-    auto proxy = GetProxy();
-    RETURN_IF_WITH_RET(proxy == nullptr, BRIGHTNESS_DEFAULT);
-    uint32_t brightness = BRIGHTNESS_DEFAULT_PROXY;
-    auto ret = proxy->GetDefaultBrightness(brightness);
+    BrightnessLimits limits;
+    auto ret = GetBrightnessLimits(limits);
+    RETURN_IF_WITH_RET(ret == ERR_NO_INIT, BRIGHTNESS_DEFAULT);
     if (ret != ERR_OK) {
-        DISPLAY_HILOGE(COMP_FWK, "GetDefaultBrightness, ret = %{public}d", ret);
         return BRIGHTNESS_DEFAULT_PROXY;
     }
-    return brightness;
+    return limits.defaultBrightness;
 }
 
 uint32_t DisplayPowerMgrClient::GetMaxBrightness()
 {
-    auto proxy = GetProxy();
-    RETURN_IF_WITH_RET(proxy == nullptr, BRIGHTNESS_MAX);
-    uint32_t brightness = BRIGHTNESS_DEFAULT_PROXY;
-    auto ret = proxy->GetMaxBrightness(brightness);
+    BrightnessLimits limits;
+    auto ret = GetBrightnessLimits(limits);
+    RETURN_IF_WITH_RET(ret == ERR_NO_INIT, BRIGHTNESS_MAX);
     if (ret != ERR_OK) {
-        DISPLAY_HILOGE(COMP_FWK, "GetMaxBrightness, ret = %{public}d", ret);
         return BRIGHTNESS_DEFAULT_PROXY;
     }
-    return brightness;
+    return limits.maxBrightness;
 }
 
 uint32_t DisplayPowerMgrClient::GetMinBrightness()
 {
-    auto proxy = GetProxy();
-    RETURN_IF_WITH_RET(proxy == nullptr, BRIGHTNESS_MIN);
-    uint32_t brightness = BRIGHTNESS_DEFAULT_PROXY;
-    auto ret = proxy->GetMinBrightness(brightness);
+    BrightnessLimits limits;
+    auto ret = GetBrightnessLimits(limits);
+    RETURN_IF_WITH_RET(ret == ERR_NO_INIT, BRIGHTNESS_MIN);
     if (ret != ERR_OK) {
-        DISPLAY_HILOGE(COMP_FWK, "GetMinBrightness, ret = %{public}d", ret);
         return BRIGHTNESS_DEFAULT_PROXY;
     }
-    return brightness;
+    return limits.minBrightness;
 }
 
 bool DisplayPowerMgrClient::AdjustBrightness(uint32_t value, uint32_t duration, uint32_t id)
@@ -322,6 +485,11 @@ bool DisplayPowerMgrClient::AutoAdjustBrightness(bool enable)
 
 bool DisplayPowerMgrClient::IsAutoAdjustBrightness()
 {
+    DisplayPowerSnapshotData snapshot;
+    if (ReadSnapshot(static_cast<uint32_t>(GetMainDisplayId()), snapshot) &&
+        (snapshot.flags & SNAPSHOT_AUTO_ADJUST_VALID) != 0) {
+        return (snapshot.flags & SNAPSHOT_AUTO_ADJUST) != 0;
+    }
     auto proxy = GetProxy();
     RETURN_IF_WITH_RET(proxy == nullptr, false);
     bool result = false;
@@ -333,6 +501,17 @@ bool DisplayPowerMgrClient::IsAutoAdjustBrightness()
     return result;
 }
 
+bool DisplayPowerMgrClient::GetLuxEstimate(DisplayLuxSnapshotData& data)
+{
+    auto reader = GetSnapshotReader();
+    DisplayLuxSnapshotData snapshot;
+    if (reader == nullptr || !reader->ReadLux(snapshot) || (snapshot.flags & SNAPSHOT_LUX_VALID) == 0) {
+        return false;
+    }
+    data = snapshot;
+    return true;
+}
+
 bool DisplayPowerMgrClient::SetScreenOnBrightness()
 {
     auto proxy = GetProxy();
@@ -405,6 +584,10 @@ bool DisplayPowerMgrClient::CancelBoostBrightness(uint32_t displayId)
 
 uint32_t DisplayPowerMgrClient::GetDeviceBrightness(uint32_t displayId, bool useHbm)
 {
+    DisplayPowerSnapshotData snapshot;
+    if (ReadSnapshot(displayId, snapshot) && (snapshot.flags & SNAPSHOT_DEVICE_BRIGHTNESS_VALID) != 0) {
+        return useHbm ? snapshot.deviceBrightnessHbm : snapshot.deviceBrightness;
+    }
     auto proxy = GetProxy();
     RETURN_IF_WITH_RET(proxy == nullptr, 0);
     uint32_t brightness = BRIGHTNESS_OFF;
@@ -438,6 +621,32 @@ bool DisplayPowerMgrClient::GetFeatureSupport(BrightnessFeatureType feature)
     return result;
 }
 
+bool DisplayPowerMgrClient::ExecuteBrightnessCommands(const std::vector<BrightnessCommand>& commands,
+    std::vector<BrightnessCommandResult>& results)
+{
+    auto proxy = GetProxy();
+    RETURN_IF_WITH_RET(proxy == nullptr, false);
+    auto ret = proxy->ExecuteBrightnessCommands(commands, results);
+    if (ret != ERR_OK) {
+        DISPLAY_HILOGE(COMP_FWK, "ExecuteBrightnessCommands, ret = %{public}d", ret);
+        lastError_ = static_cast<DisplayErrors>(ret);
+        return false;
+    }
+    return results.size() == commands.size();
+}
+
+void DisplayPowerMgrClient::ExecuteBrightnessCommandsAsync(const std::vector<BrightnessCommand>& commands,
+    std::function<void(bool, const std::vector<BrightnessCommandResult>&)> callback)
+{
+    SubmitAsyncTask([this, commands, callback = std::move(callback)] {
+        std::vector<BrightnessCommandResult> results;
+        bool ret = ExecuteBrightnessCommands(commands, results);
+        if (callback) {
+            callback(ret, results);
+        }
+    });
+}
+
 bool DisplayPowerMgrClient::SetCoordinated(bool coordinated, uint32_t displayId)
 {
     auto proxy = GetProxy();
@@ -604,6 +813,20 @@ DisplayErrors DisplayPowerMgrClient::SetMultiScreenDisplayState(uint64_t screenI
     return static_cast<DisplayErrors>(result);
 }
 
+DisplayErrors DisplayPowerMgrClient::SetMultiScreenDisplayStates(const std::vector<MultiScreenStateRequest>& requests,
+    std::vector<MultiScreenStateResult>& results)
+{
+    auto proxy = GetProxy();
+    RETURN_IF_WITH_RET(proxy == nullptr, DisplayErrors::ERR_CONNECTION_FAIL);
+    int32_t result = static_cast<int32_t>(DisplayErrors::ERR_OK);
+    auto ret = proxy->SetMultiScreenDisplayStates(requests, results, result);
+    if (ret != ERR_OK) {
+        DISPLAY_HILOGE(COMP_FWK, "SetMultiScreenDisplayStates, ret = %{public}d", ret);
+        return DisplayErrors::ERR_CONNECTION_FAIL;
+    }
+    return static_cast<DisplayErrors>(result);
+}
+
 DisplayErrors DisplayPowerMgrClient::GetMultiScreenDisplayState(uint64_t screenId, DisplayState& state)
 {
     auto proxy = GetProxy();
@@ -17,11 +17,15 @@
 #define DISPLAYMGR_DISPLAY_MGR_CLIENT_H
 
 #include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
 #include <iremote_object.h>
 #include <singleton.h>
 #include <vector>
 
 #include "display_power_info.h"
+#include "display_power_snapshot.h"
 #include "idisplay_power_callback.h"
 #include "idisplay_power_mgr.h"
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
@@ -30,6 +34,10 @@
 #include "power_state_machine_info.h"
 #include "display_mgr_errors.h"
 
+namespace ffrt {
+class queue;
+} // namespace ffrt
+
 namespace OHOS {
 namespace DisplayPowerMgr {
 class DisplayPowerMgrClient : public DelayedRefSingleton<DisplayPowerMgrClient> {
@@ -43,12 +51,24 @@ public:
     bool SetDisplayState(DisplayState state,
         PowerMgr::StateChangeReason reason = PowerMgr::StateChangeReason::STATE_CHANGE_REASON_UNKNOWN,
         uint32_t id = 0);
+    // Asynchronous variants return without waiting for the service. Requests with a result are sent in
+    // submission order from a client queue and complete through the future or callback on that queue.
+    std::future<bool> SetDisplayStateAsync(DisplayState state,
+        PowerMgr::StateChangeReason reason = PowerMgr::StateChangeReason::STATE_CHANGE_REASON_UNKNOWN,
+        uint32_t id = 0);
+    void SetDisplayStateAsync(DisplayState state, std::function<void(bool)> callback,
+        PowerMgr::StateChangeReason reason = PowerMgr::StateChangeReason::STATE_CHANGE_REASON_UNKNOWN,
+        uint32_t id = 0);
     DisplayState GetDisplayState(uint32_t id = 0);
     std::vector<uint32_t> GetDisplayIds();
     int32_t GetMainDisplayId();
     bool SetForcedBrightness(double value, uint32_t displayId = 0, uint32_t duration = 500,
         BrightnessValueType valueType = BrightnessValueType::RELATIVE_TO_CURRENT_RANGE);
+    // A continuous value may be coalesced with the ones following it within a short interval. true then only
+    // means it was accepted, only the last value of the interval is applied, and a failure is not reported.
     bool SetBrightness(uint32_t value, uint32_t displayId = 0, bool continuous = false);
+    // One-way request for callers that do not need the result, such as continuous slider updates
+    bool SetBrightnessAsync(uint32_t value, uint32_t displayId = 0, bool continuous = false);
     bool SetMaxBrightness(double value, uint32_t enterTestMode = 0);
     bool SetMaxBrightnessNit(uint32_t maxNit, uint32_t enterTestMode = 0);
     bool DiscountBrightness(double discount, uint32_t displayId = 0);
@@ -62,6 +82,10 @@ public:
     bool AdjustBrightness(uint32_t value, uint32_t duration, uint32_t id = 0);
     bool AutoAdjustBrightness(bool enable);
     bool IsAutoAdjustBrightness();
+    // Reads the ambient light estimates of the display service from shared memory, without IPC.
+    // Returns false while they are not valid, e.g. the light sensor is off. STABLE_LUX data change listeners
+    // are told when the smoothed lux changes.
+    bool GetLuxEstimate(DisplayLuxSnapshotData& data);
     bool SetScreenOnBrightness();
     bool UpdateScreenPowerState(bool isScreenOn);
     bool RegisterCallback(sptr<IDisplayPowerCallback> callback);
@@ -72,6 +96,12 @@ public:
     bool GetFeatureSupport(BrightnessFeatureType feature);
     bool SetCoordinated(bool coordinated, uint32_t displayId = 0);
     std::string RunJsonCommand(const std::string& request);
+    // Applies the commands in order with one IPC, results holds one entry per command.
+    // The brightness reaches the panel once, after the last command.
+    bool ExecuteBrightnessCommands(const std::vector<BrightnessCommand>& commands,
+        std::vector<BrightnessCommandResult>& results);
+    void ExecuteBrightnessCommandsAsync(const std::vector<BrightnessCommand>& commands,
+        std::function<void(bool, const std::vector<BrightnessCommandResult>&)> callback);
     // Registers a brightness data change listener. Returns 0 on success.
     // Both callerId (for server-side deduplication) and params (a JSON string) are optional.
     int32_t RegisterDataChangeListener(const sptr<IDisplayBrightnessListener>& listener,
@@ -103,6 +133,14 @@ public:
      * @param state [out] Current display state. DISPLAY_UNKNOWN if not found.
      */
     DisplayErrors GetMultiScreenDisplayState(uint64_t screenId, DisplayState& state);
+    /**
+     * @brief Set the display states of several screens with one call, the screens are powered concurrently.
+     *
+     * @param requests One entry per screen, a screen appears at most once. Max 16 entries.
+     * @param results [out] One entry per request in request order, holding the result of that screen.
+     */
+    DisplayErrors SetMultiScreenDisplayStates(const std::vector<MultiScreenStateRequest>& requests,
+        std::vector<MultiScreenStateResult>& results);
     /**
      * @brief Register the callback for display state change of specific screen(s).
      *
@@ -139,8 +177,39 @@ private:
         DisplayPowerMgrClient& client_;
     };
 
+    // Brightness range and main display id are fetched with one IPC and cached until the service dies or
+    // the limits generation of the power snapshot moves (boot completion, fold display mode switch).
+    // Callers without a snapshot, such as non-system apps, cannot observe a fold switch. They keep the
+    // brightness range for the connection but refetch the main display id on every GetMainDisplayId.
+    struct BrightnessLimits {
+        uint32_t maxBrightness {BRIGHTNESS_MAX};
+        uint32_t minBrightness {BRIGHTNESS_MIN};
+        uint32_t defaultBrightness {BRIGHTNESS_DEFAULT};
+        uint32_t mainDisplayId {DEFAULT_MAIN_DISPLAY_ID};
+    };
+
+    // One service connection. It is replaced on service death and released, with its snapshot mapping,
+    // once the last caller that loaded it returns.
+    struct Connection : public std::enable_shared_from_this<Connection> {
+        explicit Connection(sptr<IDisplayPowerMgr> serviceProxy) : proxy(std::move(serviceProxy)) {}
+        sptr<IDisplayPowerMgr> proxy;
+        // Shared snapshot of the service state, mapped on first use by the one caller that requested it.
+        // snapshotOwner is written once before snapshotReader publishes it and lives as long as the connection.
+        std::unique_ptr<DisplayPowerSnapshotReader> snapshotOwner;
+        std::atomic<const DisplayPowerSnapshotReader*> snapshotReader {nullptr};
+        std::atomic<bool> isSnapshotRequested {false};
+    };
+
+    std::shared_ptr<Connection> GetConnection();
+    std::shared_ptr<Connection> LoadConnection();
+    void PublishConnection(std::shared_ptr<Connection> connection);
     sptr<IDisplayPowerMgr> GetProxy();
     void OnRemoteDied(const wptr<IRemoteObject>& remote);
+    ErrCode GetBrightnessLimits(BrightnessLimits& limits, bool isMainDisplayNeeded = false);
+    bool ReadLimitsGeneration(uint32_t& generation);
+    bool ReadSnapshot(uint32_t displayId, DisplayPowerSnapshotData& data);
+    std::shared_ptr<const DisplayPowerSnapshotReader> GetSnapshotReader();
+    void SubmitAsyncTask(std::function<void()> task);
 
     static constexpr int32_t INVALID_DISPLAY_ID {-1};
     static constexpr int32_t DEFAULT_MAIN_DISPLAY_ID {0};
@@ -150,9 +219,25 @@ private:
     static constexpr uint32_t BRIGHTNESS_MIN {1};
 
     std::atomic<DisplayErrors> lastError_ {DisplayErrors::ERR_OK};
+    // Serializes connecting and OnRemoteDied, a connected client reads the connection without it
     std::mutex mutex_;
-    sptr<IDisplayPowerMgr> proxy_ {nullptr};
+    // Owned under mutex_, readers go through LoadConnection
+    std::shared_ptr<Connection> connection_ {nullptr};
+    std::atomic<Connection*> publishedConnection_ {nullptr};
+    // Readers of the current epoch between loading publishedConnection_ and taking their reference
+    std::atomic<uint32_t> readerEpoch_ {0};
+    std::atomic<uint32_t> readers_[2] {};
     sptr<IRemoteObject::DeathRecipient> deathRecipient_ {nullptr};
+    // Protects the cached limits, never held across an IPC
+    std::mutex limitsMutex_;
+    bool isLimitsCached_ {false};
+    uint32_t cachedLimitsGeneration_ {0};
+    bool isCachedGenerationKnown_ {false};
+    // Bumped on service death so that limits fetched from the dead instance are not cached
+    uint64_t limitsEpoch_ {0};
+    BrightnessLimits limits_;
+    std::once_flag asyncQueueFlag_;
+    std::shared_ptr<ffrt::queue> asyncQueue_ {nullptr};
 #ifdef ENABLE_SCREEN_POWER_OFF_STRATEGY
     sptr<IRemoteObject> token_ {nullptr};
 #endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_DISPLAY_MANAGER_CALLBACK_MAILBOX_H
+#define POWERMGR_DISPLAY_MANAGER_CALLBACK_MAILBOX_H
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <datetime_ex.h>
+
+#include "display_log.h"
+#include "ffrt_utils.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Counts the deliveries queued or running on the mailboxes sharing it
+class DeliveryTracker {
+public:
+    void Begin()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_++;
+    }
+
+    void End()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--inFlight_ == 0) {
+            idle_.notify_all();
+        }
+    }
+
+    // Returns false if deliveries are still running after timeoutMs
+    bool Wait(uint32_t timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return idle_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return inFlight_ == 0; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    uint32_t inFlight_ {0};
+};
+
+struct DeliveryStats {
+    uint64_t delivered {0};
+    uint64_t slow {0};
+    uint64_t dropped {0};
+    size_t pending {0};
+    int64_t maxCostMs {0};
+    bool isQuarantined {false};
+};
+
+inline void AppendDeliveryStats(const DeliveryStats& stats, std::string& result)
+{
+    result.append(" Delivered=").append(std::to_string(stats.delivered));
+    result.append(" Slow=").append(std::to_string(stats.slow));
+    result.append(" Dropped=").append(std::to_string(stats.dropped));
+    result.append(" Pending=").append(std::to_string(stats.pending));
+    result.append(" MaxCostMs=").append(std::to_string(stats.maxCostMs));
+    result.append(stats.isQuarantined ? " Quarantined\n" : "\n");
+}
+
+// Deadlines of a mailbox and the millisecond clock its deliveries are measured with. Tests inject the clock to
+// make a subscriber late or on time without depending on how the scheduler runs it.
+struct DeliveryPolicy {
+    int64_t deliveryDeadlineMs {100};
+    int64_t quarantineMs {1000};
+    uint32_t maxSlowDeliveries {3};
+    std::function<int64_t()> clock {[] { return GetTickCount(); }};
+};
+
+// Notifications of one remote subscriber, delivered in posting order by an FFRT task so that the subscriber
+// neither blocks the poster nor delays the other subscribers. The deliver function is expected to make a oneway
+// call, so that the task does not wait for the subscriber. A delivery running past the deadline marks the
+// subscriber as lagging: its queued notifications are then coalesced to the latest one of each key, and at
+// most MAX_PENDING are kept. A subscriber lagging for maxSlowDeliveries deliveries in a row, or found still
+// inside one delivery after quarantineMs, is quarantined: the mailbox closes and onQuarantine is run on an FFRT
+// task, so that the owner drops the subscriber.
+template<typename Notification>
+class CallbackMailbox : public std::enable_shared_from_this<CallbackMailbox<Notification>> {
+public:
+    using DeliverFunc = std::function<void(const Notification&)>;
+    using KeyFunc = std::function<uint64_t(const Notification&)>;
+    using QuarantineFunc = std::function<void()>;
+
+    static constexpr size_t MAX_PENDING = 16;
+
+    CallbackMailbox(std::string label, DeliverFunc deliver, KeyFunc key, std::shared_ptr<DeliveryTracker> tracker,
+        QuarantineFunc onQuarantine = nullptr, DeliveryPolicy policy = {})
+        : label_(std::move(label)), deliver_(std::move(deliver)), key_(std::move(key)), tracker_(std::move(tracker)),
+          onQuarantine_(std::move(onQuarantine)), policy_(std::move(policy))
+    {
+    }
+    CallbackMailbox(const CallbackMailbox&) = delete;
+    CallbackMailbox& operator=(const CallbackMailbox&) = delete;
+
+    void Post(const Notification& notification)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (isClosed_) {
+                return;
+            }
+            int64_t runningMs = isDelivering_ ? policy_.clock() - deliveryStartMs_ : 0;
+            if (runningMs > policy_.quarantineMs) {
+                DISPLAY_HILOGE(COMP_SVC, "%{public}s hangs for %{public}" PRId64 "ms", label_.c_str(), runningMs);
+                QuarantineLocked();
+                return;
+            }
+            bool isLagging = isDelivering_ && (isLagging_ || runningMs > policy_.deliveryDeadlineMs);
+            if (isLagging) {
+                uint64_t key = key_(notification);
+                auto isSameKey = [this, key](const Notification& pending) { return key_(pending) == key; };
+                if (auto iter = std::find_if(mailbox_.begin(), mailbox_.end(), isSameKey); iter != mailbox_.end()) {
+                    *iter = notification;
+                    stats_.dropped++;
+                    return;
+                }
+                if (mailbox_.size() >= MAX_PENDING) {
+                    DISPLAY_HILOGW(COMP_SVC, "%{public}s is stuck, drop the oldest notification", label_.c_str());
+                    mailbox_.pop_front();
+                    stats_.dropped++;
+                }
+            }
+            mailbox_.push_back(notification);
+            if (isDelivering_) {
+                return;
+            }
+            isDelivering_ = true;
+        }
+        tracker_->Begin();
+        PowerMgr::FFRTUtils::SubmitTask([self = this->shared_from_this()] { self->Drain(); });
+    }
+
+    // Discards the queued notifications, a delivery already running completes and later posts are ignored
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isClosed_ = true;
+        mailbox_.clear();
+    }
+
+    const std::string& GetLabel() const
+    {
+        return label_;
+    }
+
+    DeliveryStats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        DeliveryStats stats = stats_;
+        stats.pending = mailbox_.size();
+        return stats;
+    }
+
+private:
+    void QuarantineLocked()
+    {
+        stats_.dropped += mailbox_.size();
+        stats_.isQuarantined = true;
+        isClosed_ = true;
+        mailbox_.clear();
+        if (onQuarantine_ != nullptr) {
+            // Not run inline, the poster may hold the lock the owner takes to drop the subscriber
+            PowerMgr::FFRTUtils::SubmitTask(onQuarantine_);
+        }
+    }
+
+    void Drain()
+    {
+        while (true) {
+            Notification notification;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (mailbox_.empty()) {
+                    isDelivering_ = false;
+                    break;
+                }
+                notification = std::move(mailbox_.front());
+                mailbox_.pop_front();
+                deliveryStartMs_ = policy_.clock();
+            }
+            deliver_(notification);
+            int64_t cost = policy_.clock() - deliveryStartMs_;
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.delivered++;
+            stats_.maxCostMs = std::max(stats_.maxCostMs, cost);
+            isLagging_ = cost > policy_.deliveryDeadlineMs;
+            slowInRow_ = isLagging_ ? slowInRow_ + 1 : 0;
+            stats_.slow += isLagging_ ? 1 : 0;
+            if (isClosed_) {
+                continue;
+            }
+            if (slowInRow_ >= policy_.maxSlowDeliveries) {
+                DISPLAY_HILOGE(COMP_SVC, "%{public}s exceeded %{public}" PRId64 "ms %{public}u times in a row",
+                    label_.c_str(), policy_.deliveryDeadlineMs, slowInRow_);
+                QuarantineLocked();
+            } else if (isLagging_) {
+                stats_.dropped += Coalesce();
+                DISPLAY_HILOGW(COMP_SVC, "%{public}s exceeded %{public}" PRId64 "ms, pending=%{public}zu",
+                    label_.c_str(), policy_.deliveryDeadlineMs, mailbox_.size());
+            }
+        }
+        tracker_->End();
+    }
+
+    // Keeps the latest notification of each key, in the order of those latest notifications
+    size_t Coalesce()
+    {
+        std::deque<Notification> latest;
+        for (auto iter = mailbox_.rbegin(); iter != mailbox_.rend(); ++iter) {
+            uint64_t key = key_(*iter);
+            auto isSameKey = [this, key](const Notification& kept) { return key_(kept) == key; };
+            if (std::find_if(latest.begin(), latest.end(), isSameKey) == latest.end()) {
+                latest.push_front(std::move(*iter));
+            }
+        }
+        size_t dropped = mailbox_.size() - latest.size();
+        mailbox_.swap(latest);
+        return dropped;
+    }
+
+    const std::string label_;
+    const DeliverFunc deliver_;
+    const KeyFunc key_;
+    const std::shared_ptr<DeliveryTracker> tracker_;
+    const QuarantineFunc onQuarantine_;
+    const DeliveryPolicy policy_;
+    std::mutex mutex_;  // Protects the members below
+    std::deque<Notification> mailbox_;
+    bool isDelivering_ {false};
+    bool isClosed_ {false};
+    bool isLagging_ {false};  // The last delivery ran past the deadline
+    uint32_t slowInRow_ {0};
+    int64_t deliveryStartMs_ {0};
+    DeliveryStats stats_;
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // POWERMGR_DISPLAY_MANAGER_CALLBACK_MAILBOX_H
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISPLAYMGR_DISPLAY_API_METRICS_H
+#define DISPLAYMGR_DISPLAY_API_METRICS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <cJSON.h>
+
+#include "display_mgr_errors.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// IPC handlers of DisplayPowerMgrService, in the order of DisplayApiMetrics::GetName
+enum class DisplayApi : uint32_t {
+    SET_MULTI_SCREEN_DISPLAY_STATE,
+    GET_MULTI_SCREEN_DISPLAY_STATE,
+    REGISTER_MULTI_SCREEN_DISPLAY_STATE_CALLBACK,
+    UNREGISTER_MULTI_SCREEN_DISPLAY_STATE_CALLBACK,
+    SET_MULTI_SCREEN_DISPLAY_STATES,
+    SET_SCREEN_DISPLAY_STATE,
+    SET_DISPLAY_STATE,
+    GET_DISPLAY_STATE,
+    GET_DISPLAY_IDS,
+    GET_MAIN_DISPLAY_ID,
+    SET_FORCED_BRIGHTNESS,
+    SET_BRIGHTNESS,
+    SET_BRIGHTNESS_ASYNC,
+    DISCOUNT_BRIGHTNESS,
+    OVERRIDE_BRIGHTNESS,
+    OVERRIDE_DISPLAY_OFF_DELAY,
+    RESTORE_BRIGHTNESS,
+    GET_BRIGHTNESS,
+    GET_DEFAULT_BRIGHTNESS,
+    GET_MAX_BRIGHTNESS,
+    GET_MIN_BRIGHTNESS,
+    GET_BRIGHTNESS_LIMITS,
+    GET_POWER_SNAPSHOT,
+    EXECUTE_BRIGHTNESS_COMMANDS,
+    ADJUST_BRIGHTNESS,
+    AUTO_ADJUST_BRIGHTNESS,
+    IS_AUTO_ADJUST_BRIGHTNESS,
+    REGISTER_CALLBACK,
+    BOOST_BRIGHTNESS,
+    CANCEL_BOOST_BRIGHTNESS,
+    GET_DEVICE_BRIGHTNESS,
+    SET_COORDINATED,
+    SET_LIGHT_BRIGHTNESS_THRESHOLD,
+    SET_MAX_BRIGHTNESS,
+    SET_MAX_BRIGHTNESS_NIT,
+    SET_SCREEN_ON_BRIGHTNESS,
+    UPDATE_SCREEN_POWER_STATE,
+    NOTIFY_SCREEN_POWER_STATUS,
+    WAIT_DIMMING_DONE,
+    GET_FEATURE_SUPPORT,
+    RUN_JSON_COMMAND,
+    REGISTER_DATA_CHANGE_LISTENER,
+    UNREGISTER_DATA_CHANGE_LISTENER,
+    SET_SCREEN_POWER_OFF_STRATEGY,
+    SET_SCENE_MODE,
+    COUNT,
+};
+
+// Calls, latency and errors of every IPC handler since the last reset. Recording a call only touches relaxed
+// atomics of its own handler. Latencies are kept in microseconds in log-linear buckets: one per microsecond
+// below 16us, then 8 per power of two, so that a percentile is off by at most 1/8 of its value.
+class DisplayApiMetrics {
+public:
+    static constexpr size_t API_COUNT = static_cast<size_t>(DisplayApi::COUNT);
+
+    struct Summary {
+        uint64_t calls {0};
+        uint64_t errors {0};
+        int64_t inFlight {0};
+        int64_t peakInFlight {0};
+        uint64_t avgUs {0};
+        uint64_t p50Us {0};
+        uint64_t p90Us {0};
+        uint64_t p99Us {0};
+        uint64_t maxUs {0};
+    };
+
+    static DisplayApiMetrics& Get()
+    {
+        static DisplayApiMetrics instance;
+        return instance;
+    }
+
+    void Begin(DisplayApi api)
+    {
+        Entry& entry = entries_[GetIndex(api)];
+        int64_t inFlight = entry.inFlight.fetch_add(1, std::memory_order_relaxed) + 1;
+        int64_t peak = entry.peakInFlight.load(std::memory_order_relaxed);
+        while (inFlight > peak &&
+            !entry.peakInFlight.compare_exchange_weak(peak, inFlight, std::memory_order_relaxed)) {}
+    }
+
+    void End(DisplayApi api, uint64_t costUs)
+    {
+        Entry& entry = entries_[GetIndex(api)];
+        entry.inFlight.fetch_sub(1, std::memory_order_relaxed);
+        entry.calls.fetch_add(1, std::memory_order_relaxed);
+        entry.totalUs.fetch_add(costUs, std::memory_order_relaxed);
+        uint64_t maxUs = entry.maxUs.load(std::memory_order_relaxed);
+        while (costUs > maxUs && !entry.maxUs.compare_exchange_weak(maxUs, costUs, std::memory_order_relaxed)) {}
+        entry.buckets[GetBucket(costUs)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RecordError(DisplayApi api, DisplayErrors error)
+    {
+        if (error == DisplayErrors::ERR_OK) {
+            return;
+        }
+        entries_[GetIndex(api)].errors[GetErrorIndex(error)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t GetErrorCount(DisplayApi api, DisplayErrors error) const
+    {
+        return entries_[GetIndex(api)].errors[GetErrorIndex(error)].load(std::memory_order_relaxed);
+    }
+
+    Summary GetSummary(DisplayApi api) const
+    {
+        const Entry& entry = entries_[GetIndex(api)];
+        Summary summary;
+        std::array<uint64_t, BUCKET_COUNT> buckets;
+        uint64_t total = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            buckets[bucket] = entry.buckets[bucket].load(std::memory_order_relaxed);
+            total += buckets[bucket];
+        }
+        for (const auto& errors : entry.errors) {
+            summary.errors += errors.load(std::memory_order_relaxed);
+        }
+        summary.calls = entry.calls.load(std::memory_order_relaxed);
+        summary.inFlight = entry.inFlight.load(std::memory_order_relaxed);
+        summary.peakInFlight = entry.peakInFlight.load(std::memory_order_relaxed);
+        summary.maxUs = entry.maxUs.load(std::memory_order_relaxed);
+        if (summary.calls > 0) {
+            summary.avgUs = entry.totalUs.load(std::memory_order_relaxed) / summary.calls;
+        }
+        summary.p50Us = GetPercentile(buckets, total, PERCENT_50, summary.maxUs);
+        summary.p90Us = GetPercentile(buckets, total, PERCENT_90, summary.maxUs);
+        summary.p99Us = GetPercentile(buckets, total, PERCENT_99, summary.maxUs);
+        return summary;
+    }
+
+    // Calls in flight are not reset, they are counted once they complete
+    void Reset()
+    {
+        for (auto& entry : entries_) {
+            entry.calls.store(0, std::memory_order_relaxed);
+            entry.totalUs.store(0, std::memory_order_relaxed);
+            entry.maxUs.store(0, std::memory_order_relaxed);
+            entry.peakInFlight.store(entry.inFlight.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            for (auto& bucket : entry.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            for (auto& errors : entry.errors) {
+                errors.store(0, std::memory_order_relaxed);
+            }
+        }
+        resetTimeUs_.store(GetNowUs(), std::memory_order_relaxed);
+    }
+
+    void Dump(std::string& result) const
+    {
+        uint64_t elapsedUs = GetElapsedUs();
+        result.append("API Metrics: SinceResetMs=").append(std::to_string(elapsedUs / US_PER_MS)).append("\n");
+        char line[LINE_SIZE];
+        for (size_t index = 0; index < API_COUNT; index++) {
+            auto api = static_cast<DisplayApi>(index);
+            Summary summary = GetSummary(api);
+            if (summary.calls == 0 && summary.inFlight == 0 && summary.errors == 0) {
+                continue;
+            }
+            double rate = elapsedUs > 0 ? static_cast<double>(summary.calls) * US_PER_S / elapsedUs : 0.0;
+            int size = snprintf(line, sizeof(line), "  %s Calls=%" PRIu64 " Rate=%.2f/s InFlight=%" PRId64
+                " PeakInFlight=%" PRId64 " AvgUs=%" PRIu64 " P50Us=%" PRIu64 " P90Us=%" PRIu64 " P99Us=%" PRIu64
+                " MaxUs=%" PRIu64 " Errors=%" PRIu64, GetName(api), summary.calls, rate, summary.inFlight,
+                summary.peakInFlight, summary.avgUs, summary.p50Us, summary.p90Us, summary.p99Us, summary.maxUs,
+                summary.errors);
+            if (size > 0) {
+                result.append(line, std::min(static_cast<size_t>(size), sizeof(line) - 1));
+            }
+            AppendErrors(api, result);
+            result.append("\n");
+        }
+    }
+
+    // {"ret":0,"sinceResetMs":1000,"apis":[{"name":"SetDisplayState","calls":2,...,"errors":{"201":1}}]}
+    std::string ToJson() const
+    {
+        cJSON* root = cJSON_CreateObject();
+        if (root == nullptr) {
+            return "";
+        }
+        cJSON_AddNumberToObject(root, "ret", 0);
+        cJSON_AddNumberToObject(root, "sinceResetMs", static_cast<double>(GetElapsedUs() / US_PER_MS));
+        cJSON* apis = cJSON_CreateArray();
+        for (size_t index = 0; index < API_COUNT && apis != nullptr; index++) {
+            auto api = static_cast<DisplayApi>(index);
+            Summary summary = GetSummary(api);
+            if (summary.calls == 0 && summary.inFlight == 0 && summary.errors == 0) {
+                continue;
+            }
+            cJSON* item = cJSON_CreateObject();
+            if (item == nullptr) {
+                continue;
+            }
+            cJSON_AddStringToObject(item, "name", GetName(api));
+            cJSON_AddNumberToObject(item, "calls", static_cast<double>(summary.calls));
+            cJSON_AddNumberToObject(item, "inFlight", static_cast<double>(summary.inFlight));
+            cJSON_AddNumberToObject(item, "peakInFlight", static_cast<double>(summary.peakInFlight));
+            cJSON_AddNumberToObject(item, "avgUs", static_cast<double>(summary.avgUs));
+            cJSON_AddNumberToObject(item, "p50Us", static_cast<double>(summary.p50Us));
+            cJSON_AddNumberToObject(item, "p90Us", static_cast<double>(summary.p90Us));
+            cJSON_AddNumberToObject(item, "p99Us", static_cast<double>(summary.p99Us));
+            cJSON_AddNumberToObject(item, "maxUs", static_cast<double>(summary.maxUs));
+            cJSON* errors = cJSON_CreateObject();
+            for (size_t error = 0; error < ERROR_COUNT && errors != nullptr; error++) {
+                uint64_t count = entries_[index].errors[error].load(std::memory_order_relaxed);
+                if (count > 0) {
+                    cJSON_AddNumberToObject(errors, GetErrorLabel(error).c_str(), static_cast<double>(count));
+                }
+            }
+            cJSON_AddItemToObject(item, "errors", errors);
+            cJSON_AddItemToArray(apis, item);
+        }
+        cJSON_AddItemToObject(root, "apis", apis);
+        char* json = cJSON_PrintUnformatted(root);
+        std::string result = (json != nullptr) ? json : "";
+        cJSON_free(json);
+        cJSON_Delete(root);
+        return result;
+    }
+
+    static const char* GetName(DisplayApi api)
+    {
+        static constexpr std::array<const char*, API_COUNT> NAMES {
+            "SetMultiScreenDisplayState",
+            "GetMultiScreenDisplayState",
+            "RegisterMultiScreenDisplayStateCallback",
+            "UnregisterMultiScreenDisplayStateCallback",
+            "SetMultiScreenDisplayStates",
+            "SetScreenDisplayState",
+            "SetDisplayState",
+            "GetDisplayState",
+            "GetDisplayIds",
+            "GetMainDisplayId",
+            "SetForcedBrightness",
+            "SetBrightness",
+            "SetBrightnessAsync",
+            "DiscountBrightness",
+            "OverrideBrightness",
+            "OverrideDisplayOffDelay",
+            "RestoreBrightness",
+            "GetBrightness",
+            "GetDefaultBrightness",
+            "GetMaxBrightness",
+            "GetMinBrightness",
+            "GetBrightnessLimits",
+            "GetPowerSnapshot",
+            "ExecuteBrightnessCommands",
+            "AdjustBrightness",
+            "AutoAdjustBrightness",
+            "IsAutoAdjustBrightness",
+            "RegisterCallback",
+            "BoostBrightness",
+            "CancelBoostBrightness",
+            "GetDeviceBrightness",
+            "SetCoordinated",
+            "SetLightBrightnessThreshold",
+            "SetMaxBrightness",
+            "SetMaxBrightnessNit",
+            "SetScreenOnBrightness",
+            "UpdateScreenPowerState",
+            "NotifyScreenPowerStatus",
+            "WaitDimmingDone",
+            "GetFeatureSupport",
+            "RunJsonCommand",
+            "RegisterDataChangeListener",
+            "UnregisterDataChangeListener",
+            "SetScreenPowerOffStrategy",
+            "SetSceneMode",
+        };
+        return NAMES[GetIndex(api)];
+    }
+
+    // Smallest latency held by the bucket
+    static uint64_t GetBucketLowerUs(size_t bucket)
+    {
+        if (bucket < LINEAR_BUCKETS) {
+            return bucket;
+        }
+        size_t exponent = LINEAR_BITS + (bucket - LINEAR_BUCKETS) / SUB_BUCKETS;
+        uint64_t subBucket = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+        return (SUB_BUCKETS + subBucket) << (exponent - SUB_BUCKET_BITS);
+    }
+
+    static size_t GetBucket(uint64_t costUs)
+    {
+        if (costUs < LINEAR_BUCKETS) {
+            return static_cast<size_t>(costUs);
+        }
+        size_t exponent = 0;
+        for (uint64_t value = costUs; value > 1; value >>= 1) {
+            exponent++;
+        }
+        if (exponent > MAX_EXPONENT) {
+            return BUCKET_COUNT - 1;
+        }
+        size_t subBucket = static_cast<size_t>(costUs >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return LINEAR_BUCKETS + (exponent - LINEAR_BITS) * SUB_BUCKETS + subBucket;
+    }
+
+private:
+    static constexpr size_t SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t LINEAR_BITS = 4;
+    static constexpr size_t LINEAR_BUCKETS = 1 << LINEAR_BITS;
+    static constexpr size_t MAX_EXPONENT = 25;  // Up to about 67s, longer calls share the last bucket
+    static constexpr size_t BUCKET_COUNT = LINEAR_BUCKETS + (MAX_EXPONENT + 1 - LINEAR_BITS) * SUB_BUCKETS;
+    static constexpr uint64_t PERCENT_50 = 50;
+    static constexpr uint64_t PERCENT_90 = 90;
+    static constexpr uint64_t PERCENT_99 = 99;
+    static constexpr uint64_t PERCENT_100 = 100;
+    static constexpr uint64_t US_PER_MS = 1000;
+    static constexpr double US_PER_S = 1000000.0;
+    static constexpr size_t LINE_SIZE = 256;
+    // Errors are counted per DisplayErrors value, the last one holds any other code
+    static constexpr std::array<int32_t, 7> ERROR_CODES {
+        static_cast<int32_t>(DisplayErrors::ERR_PERMISSION_DENIED),
+        static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED),
+        static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID),
+        static_cast<int32_t>(DisplayErrors::ERR_CONNECTION_FAIL),
+        static_cast<int32_t>(DisplayErrors::ERR_STATE_CHANGE_FAILED),
+        static_cast<int32_t>(DisplayErrors::ERR_REGISTRATION_FAILED),
+        0,
+    };
+    static constexpr size_t ERROR_COUNT = ERROR_CODES.size();
+
+    struct alignas(64) Entry {
+        std::atomic<uint64_t> calls {0};
+        std::atomic<uint64_t> totalUs {0};
+        std::atomic<uint64_t> maxUs {0};
+        std::atomic<int64_t> inFlight {0};
+        std::atomic<int64_t> peakInFlight {0};
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets {};
+        std::array<std::atomic<uint64_t>, ERROR_COUNT> errors {};
+    };
+
+    DisplayApiMetrics() = default;
+
+    static size_t GetIndex(DisplayApi api)
+    {
+        auto index = static_cast<size_t>(api);
+        return index < API_COUNT ? index : 0;
+    }
+
+    static size_t GetErrorIndex(DisplayErrors error)
+    {
+        for (size_t index = 0; index + 1 < ERROR_COUNT; index++) {
+            if (ERROR_CODES[index] == static_cast<int32_t>(error)) {
+                return index;
+            }
+        }
+        return ERROR_COUNT - 1;
+    }
+
+    static std::string GetErrorLabel(size_t index)
+    {
+        return index + 1 < ERROR_COUNT ? std::to_string(ERROR_CODES[index]) : "other";
+    }
+
+    static uint64_t GetNowUs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    uint64_t GetElapsedUs() const
+    {
+        uint64_t now = GetNowUs();
+        uint64_t resetTime = resetTimeUs_.load(std::memory_order_relaxed);
+        return now > resetTime ? now - resetTime : 0;
+    }
+
+    // Upper bound of the bucket holding the percentile, never above the largest latency seen
+    static uint64_t GetPercentile(const std::array<uint64_t, BUCKET_COUNT>& buckets, uint64_t total,
+        uint64_t percent, uint64_t maxUs)
+    {
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t rank = (total * percent + PERCENT_100 - 1) / PERCENT_100;
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            seen += buckets[bucket];
+            if (seen >= rank) {
+                uint64_t upper = bucket + 1 < BUCKET_COUNT ? GetBucketLowerUs(bucket + 1) - 1 : maxUs;
+                return std::min(upper, maxUs);
+            }
+        }
+        return maxUs;
+    }
+
+    void AppendErrors(DisplayApi api, std::string& result) const
+    {
+        const Entry& entry = entries_[GetIndex(api)];
+        bool isFirst = true;
+        for (size_t error = 0; error < ERROR_COUNT; error++) {
+            uint64_t count = entry.errors[error].load(std::memory_order_relaxed);
+            if (count == 0) {
+                continue;
+            }
+            result.append(isFirst ? "(" : ",").append(GetErrorLabel(error));
+            result.append(":").append(std::to_string(count));
+            isFirst = false;
+        }
+        if (!isFirst) {
+            result.append(")");
+        }
+    }
+
+    std::array<Entry, API_COUNT> entries_;
+    std::atomic<uint64_t> resetTimeUs_ {GetNowUs()};
+};
+
+// Measures one IPC call, created next to the DisplayXCollie of the handler. Errors reported on the same thread
+// while the scope is alive are counted for its handler.
+class DisplayApiScope {
+public:
+    explicit DisplayApiScope(DisplayApi api) : api_(api), previous_(current_), beginUs_(GetNowUs())
+    {
+        DisplayApiMetrics::Get().Begin(api_);
+        current_ = this;
+    }
+
+    ~DisplayApiScope()
+    {
+        current_ = previous_;
+        uint64_t now = GetNowUs();
+        DisplayApiMetrics::Get().End(api_, now > beginUs_ ? now - beginUs_ : 0);
+    }
+
+    DisplayApiScope(const DisplayApiScope&) = delete;
+    DisplayApiScope& operator=(const DisplayApiScope&) = delete;
+
+    // Ignored outside of an IPC handler
+    static void ReportError(DisplayErrors error)
+    {
+        if (current_ != nullptr) {
+            DisplayApiMetrics::Get().RecordError(current_->api_, error);
+        }
+    }
+
+private:
+    static uint64_t GetNowUs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static inline thread_local DisplayApiScope* current_ = nullptr;
+    DisplayApi api_;
+    DisplayApiScope* previous_;
+    uint64_t beginUs_;
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // DISPLAYMGR_DISPLAY_API_METRICS_H
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISPLAYMGR_DISPLAY_OFF_DELAY_SCHEDULER_H
+#define DISPLAYMGR_DISPLAY_OFF_DELAY_SCHEDULER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <datetime_ex.h>
+
+#include "display_power_info.h"
+#include "ffrt_utils.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Delayed display off of OverrideDisplayOffDelay, kept per display. A display is armed with a delay while it is on,
+// the next deferrable off request of that display is then carried out once the delay expires, unless an on request
+// of the same display comes first. Another off request meanwhile replaces the pending one and restarts the delay.
+// The arm is used up by the expiry or the on request, as the single delay of the baseline was: a later off request
+// is carried out at once until the display is armed again.
+class DisplayOffDelayScheduler {
+public:
+    using ExpireCallback = std::function<void(uint32_t id, DisplayState state, uint32_t reason)>;
+
+    void Arm(uint32_t id, uint32_t delayMs)
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        Entry& entry = entries_[id];
+        entry.isArmed = true;
+        entry.delayMs = delayMs;
+    }
+
+    // A pending off request is left to expire
+    void Disarm(uint32_t id)
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        auto iter = entries_.find(id);
+        if (iter != entries_.end()) {
+            iter->second.isArmed = false;
+        }
+    }
+
+    // Moves the arm of a display without a pending request to another display, e.g. to follow the main display
+    // across a fold. Returns false if nothing was moved.
+    bool MoveArm(uint32_t from, uint32_t to)
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        auto iter = entries_.find(from);
+        if (from == to || iter == entries_.end() || !iter->second.isArmed || iter->second.isPending) {
+            return false;
+        }
+        Entry& target = entries_[to];
+        if (target.isPending) {
+            return false;
+        }
+        target.isArmed = true;
+        target.delayMs = iter->second.delayMs;
+        iter->second.isArmed = false;
+        return true;
+    }
+
+    bool IsArmed(uint32_t id) const
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        auto iter = entries_.find(id);
+        return iter != entries_.end() && iter->second.isArmed;
+    }
+
+    bool IsPending(uint32_t id) const
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        auto iter = entries_.find(id);
+        return iter != entries_.end() && iter->second.isPending;
+    }
+
+    // Returns false if the display is not armed, the request is then to be carried out at once
+    bool Schedule(uint32_t id, DisplayState state, uint32_t reason, const ExpireCallback& callback)
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        auto iter = entries_.find(id);
+        if (iter == entries_.end() || !iter->second.isArmed) {
+            return false;
+        }
+        Entry& entry = iter->second;
+        if (entry.isPending) {
+            FFRTUtils::CancelTask(entry.handle, queue_);
+            replaced_++;
+        }
+        entry.isPending = true;
+        entry.state = state;
+        entry.reason = reason;
+        entry.callback = callback;
+        entry.deadlineMs = GetTickCount() + entry.delayMs;
+        uint64_t generation = ++entry.generation;
+        FFRTTask task = [this, id, generation]() { Expire(id, generation); };
+        entry.handle = FFRTUtils::SubmitDelayTask(task, entry.delayMs, queue_);
+        scheduled_++;
+        return true;
+    }
+
+    // Cancels the pending off request of an on request and disarms the display. Returns false if the display is
+    // not armed, the on request is then to be carried out as usual.
+    bool CancelForOn(uint32_t id)
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        auto iter = entries_.find(id);
+        if (iter == entries_.end() || !iter->second.isArmed) {
+            return false;
+        }
+        Entry& entry = iter->second;
+        if (entry.isPending) {
+            FFRTUtils::CancelTask(entry.handle, queue_);
+            canceled_++;
+        }
+        ClearLocked(entry);
+        return true;
+    }
+
+    void CancelAll()
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        for (auto& [id, entry] : entries_) {
+            if (entry.isPending) {
+                FFRTUtils::CancelTask(entry.handle, queue_);
+                canceled_++;
+            }
+            ClearLocked(entry);
+        }
+    }
+
+    void Dump(std::string& result) const
+    {
+        std::lock_guard<ffrt::mutex> lock(mutex_);
+        result.append("Display Off Delay: Scheduled=").append(std::to_string(scheduled_));
+        result.append(" Replaced=").append(std::to_string(replaced_));
+        result.append(" Canceled=").append(std::to_string(canceled_));
+        result.append(" Expired=").append(std::to_string(expired_)).append("\n");
+        int64_t now = GetTickCount();
+        for (const auto& [id, entry] : entries_) {
+            if (!entry.isArmed && !entry.isPending) {
+                continue;
+            }
+            result.append("  Display Id=").append(std::to_string(id));
+            result.append(" Armed=").append(std::to_string(entry.isArmed));
+            result.append(" DelayMs=").append(std::to_string(entry.delayMs));
+            if (entry.isPending) {
+                result.append(" PendingState=").append(std::to_string(static_cast<uint32_t>(entry.state)));
+                result.append(" Reason=").append(std::to_string(entry.reason));
+                int64_t remainingMs = entry.deadlineMs > now ? entry.deadlineMs - now : 0;
+                result.append(" RemainingMs=").append(std::to_string(remainingMs));
+            }
+            result.append("\n");
+        }
+    }
+
+private:
+    using FFRTUtils = PowerMgr::FFRTUtils;
+    using FFRTTask = PowerMgr::FFRTTask;
+
+    struct Entry {
+        bool isArmed {false};
+        bool isPending {false};
+        uint32_t delayMs {0};
+        DisplayState state {DisplayState::DISPLAY_UNKNOWN};
+        uint32_t reason {0};
+        int64_t deadlineMs {0};
+        // Tells a replaced task that is already running from the pending one
+        uint64_t generation {0};
+        ExpireCallback callback;
+        PowerMgr::FFRTHandle handle;
+    };
+
+    static void ClearLocked(Entry& entry)
+    {
+        entry.isArmed = false;
+        entry.isPending = false;
+        entry.callback = nullptr;
+        entry.handle = nullptr;
+    }
+
+    void Expire(uint32_t id, uint64_t generation)
+    {
+        ExpireCallback callback;
+        DisplayState state;
+        uint32_t reason;
+        {
+            std::lock_guard<ffrt::mutex> lock(mutex_);
+            auto iter = entries_.find(id);
+            if (iter == entries_.end() || !iter->second.isPending || iter->second.generation != generation) {
+                return;
+            }
+            Entry& entry = iter->second;
+            callback = std::move(entry.callback);
+            state = entry.state;
+            reason = entry.reason;
+            ClearLocked(entry);
+            expired_++;
+        }
+        // Called outside the lock, the display may be armed again or get another request meanwhile
+        if (callback) {
+            callback(id, state, reason);
+        }
+    }
+
+    mutable ffrt::mutex mutex_;
+    std::map<uint32_t, Entry> entries_;
+    uint64_t scheduled_ {0};
+    uint64_t replaced_ {0};
+    uint64_t canceled_ {0};
+    uint64_t expired_ {0};
+    // Expiries of all displays run in order on one queue
+    std::shared_ptr<PowerMgr::FFRTQueue> queue_ {std::make_shared<PowerMgr::FFRTQueue>("display_off_delay_queue")};
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // DISPLAYMGR_DISPLAY_OFF_DELAY_SCHEDULER_H
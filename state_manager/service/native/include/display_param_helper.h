@@ -16,6 +16,7 @@
 #ifndef POWERMGR_DISPLAY_MANAGER_DISPLAY_PARAM_HELPER_H
 #define POWERMGR_DISPLAY_MANAGER_DISPLAY_PARAM_HELPER_H
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
@@ -29,10 +30,19 @@ public:
     static uint32_t GetDefaultBrightness();
     static uint32_t GetMaxBrightness();
     static uint32_t GetMinBrightness();
+    // Drop the cached values so that the next Get reads the parameters again
+    static void InvalidateCache();
     typedef void (* BootCompletedCallback)();
     static void RegisterBootCompletedCallback(BootCompletedCallback&);
 
 private:
+    static uint32_t GetCachedIntValue(std::atomic<int64_t>& cache, const char* key, int32_t def);
+
+    static constexpr int64_t PARAM_NOT_CACHED = -1;
+    static inline std::atomic<int64_t> defaultBrightness_{PARAM_NOT_CACHED};
+    static inline std::atomic<int64_t> maxBrightness_{PARAM_NOT_CACHED};
+    static inline std::atomic<int64_t> minBrightness_{PARAM_NOT_CACHED};
+
     static constexpr const char* KEY_DEFAULT_BRIGHTNESS {"const.display.brightness.default"};
     static constexpr const char* KEY_MAX_BRIGHTNESS {"const.display.brightness.max"};
     static constexpr const char* KEY_MIN_BRIGHTNESS {"const.display.brightness.min"};
@@ -30,17 +30,23 @@
 #ifdef ENABLE_SENSOR_PART
 #include "sensor_agent_type.h"
 #endif
+#include "callback_mailbox.h"
 #include "idisplay_power_callback.h"
 #include "display_power_info.h"
+#include "display_api_metrics.h"
 #include "display_common.h"
+#include "display_off_delay_scheduler.h"
 #include "display_power_mgr_stub.h"
+#include "display_power_snapshot.h"
 #include "display_xcollie.h"
 #include "screen_controller.h"
+#include "screen_controller_registry.h"
 #include "brightness_manager.h"
 #include "ffrt_utils.h"
 #include "imulti_screen_display_state_callback.h"
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
 #include "multi_screen_display_state_callback_manager.h"
+#include "screen_manager_lite.h"
 #endif
 
 namespace OHOS {
@@ -69,6 +75,12 @@ public:
     ErrCode GetDefaultBrightness(uint32_t& defaultBrightness) override;
     ErrCode GetMaxBrightness(uint32_t& maxBrightness) override;
     ErrCode GetMinBrightness(uint32_t& minBrightness) override;
+    ErrCode GetBrightnessLimits(uint32_t& maxBrightness, uint32_t& minBrightness, uint32_t& defaultBrightness,
+        uint32_t& mainDisplayId) override;
+    ErrCode GetPowerSnapshot(int& fd) override;
+    ErrCode ExecuteBrightnessCommands(const std::vector<BrightnessCommand>& commands,
+        std::vector<BrightnessCommandResult>& results) override;
+    ErrCode SetBrightnessAsync(uint32_t value, uint32_t displayId, bool continuous) override;
     ErrCode AdjustBrightness(uint32_t id, int32_t value, uint32_t duration, bool& result) override;
     ErrCode AutoAdjustBrightness(bool enable, bool& result) override;
     ErrCode IsAutoAdjustBrightness(bool& result) override;
@@ -102,6 +114,8 @@ public:
         uint64_t screenId, int32_t& retCode) override;
     ErrCode UnregisterMultiScreenDisplayStateCallback(const sptr<IMultiScreenDisplayStateCallback>& callback,
         uint64_t screenId, int32_t& retCode) override;
+    ErrCode SetMultiScreenDisplayStates(const std::vector<MultiScreenStateRequest>& requests,
+        std::vector<MultiScreenStateResult>& results, int32_t& retCode) override;
 private:
     bool SetDisplayStateInner(uint32_t id, DisplayState state, uint32_t reason);
     void UndoSetDisplayStateInner(uint32_t id, DisplayState curState, uint32_t reason);
@@ -114,8 +128,13 @@ private:
         uint64_t screenId);
     DisplayErrors UnregisterMultiScreenDisplayStateCallbackInner(sptr<IMultiScreenDisplayStateCallback> callback,
         uint64_t screenId);
+    DisplayErrors SetMultiScreenDisplayStatesInner(const std::vector<MultiScreenStateRequest>& requests,
+        std::vector<MultiScreenStateResult>& results);
+    DisplayErrors CheckMultiScreenState(const std::string& screenName, DisplayState state);
+    std::shared_ptr<ScreenController> GetMultiScreenController(uint64_t screenId);
 #endif
     void UnregisterCallbackInner();
+    bool UnregisterCallbackInner(const sptr<IRemoteObject>& remote);
     std::vector<uint32_t> GetDisplayIdsInner();
     uint32_t GetMainDisplayIdInner();
     bool SetBrightnessInner(uint32_t value, uint32_t displayId, bool continuous = false);
@@ -139,6 +158,16 @@ private:
     bool CancelBoostBrightnessInner(uint32_t displayId);
     uint32_t GetDeviceBrightnessInner(uint32_t displayId, bool useHbm);
     bool SetCoordinatedInner(bool coordinated, uint32_t displayId);
+    std::vector<BrightnessCommandResult> ExecuteBrightnessCommandsInner(
+        const std::vector<BrightnessCommand>& commands);
+    BrightnessCommandResult ExecuteBrightnessCommand(const BrightnessCommand& command);
+    bool SetBrightnessInternal(uint32_t brightness, uint32_t displayId);
+    bool DiscountBrightnessInternal(double discount, uint32_t displayId);
+    bool OverrideBrightnessInternal(uint32_t brightness, uint32_t displayId, uint32_t duration);
+    bool RestoreBrightnessInternal(uint32_t displayId, uint32_t duration);
+    bool BoostBrightnessInternal(int32_t timeoutMs, uint32_t displayId);
+    bool CancelBoostBrightnessInternal(uint32_t displayId);
+    bool SetCoordinatedInternal(bool coordinated, uint32_t displayId);
     uint32_t SetLightBrightnessThresholdInner(
         std::vector<int32_t> threshold, sptr<IDisplayBrightnessCallback> callback);
     int NotifyScreenPowerStatusInner(uint32_t displayId, uint32_t displayPowerStatus);
@@ -190,11 +219,34 @@ private:
     };
 #endif
 
+    // The main display follows the fold display mode, clients cache it until the power snapshot says otherwise
+    class MainDisplayListener : public Rosen::DisplayManagerLite::IDisplayModeListener {
+    public:
+        MainDisplayListener() = default;
+        virtual ~MainDisplayListener() = default;
+        void OnDisplayModeChanged(Rosen::FoldDisplayMode displayMode) override;
+    };
+
+#ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
+    // A screen driven through the multi-screen interface gives its brightness pipeline up once disconnected
+    class ScreenDisconnectListener : public Rosen::ScreenManagerLite::IScreenListener {
+    public:
+        ScreenDisconnectListener() = default;
+        virtual ~ScreenDisconnectListener() = default;
+        void OnConnect(Rosen::ScreenId screenId) override {}
+        void OnDisconnect(Rosen::ScreenId screenId) override;
+        void OnChange(Rosen::ScreenId screenId) override {}
+    };
+#endif
+
     static const size_t MAX_PARAMS_LENGTH = 4096;
+    static const size_t MAX_BRIGHTNESS_COMMANDS = 32;
+    static const size_t MAX_MULTI_SCREEN_REQUESTS = 16;
+    // Screens powered at the same time by SetMultiScreenDisplayStates, each one holds a thread in a display
+    // manager IPC
+    static const size_t MAX_MULTI_SCREEN_PARALLEL = 4;
+    static const uint32_t CONTINUOUS_BRIGHTNESS_INTERVAL_MS = 16;
     static const uint32_t BRIGHTNESS_OFF = 0;
-    static const uint32_t BRIGHTNESS_MIN;
-    static const uint32_t BRIGHTNESS_DEFAULT;
-    static const uint32_t BRIGHTNESS_MAX;
     static const uint32_t DELAY_TIME_UNSET = 0;
     static constexpr const double DISCOUNT_MIN = 0.01;
     static constexpr const double DISCOUNT_MAX = 1.00;
@@ -209,32 +261,71 @@ private:
     void UnregisterSettingObservers();
     void AutoBrightnessSettingUpdateFunc();
     void ScreenOffDelay(uint32_t id, DisplayState state, uint32_t reason);
+    // Moves the display off delay armed for the main display to id once id has become the main display
+    void FollowMainDisplayOffDelay(uint32_t id);
     bool IsSupportLightSensor();
     std::string GetCallerIdWithPid(const std::string& callerId);
+    // Keeps the error for GetError and counts it for the IPC handler being measured
+    void SetLastError(DisplayErrors error);
+    // Handles the commands of the "display_service" domain, returns false for any other domain
+    bool RunServiceJsonCommand(const std::string& request, std::string& result);
+    void InitPowerSnapshot();
+    void PublishPowerSnapshot();
+    bool SetContinuousBrightness(uint32_t brightness, uint32_t displayId);
+    bool ScheduleContinuousBrightnessDrain();
+    void DrainContinuousBrightness();
 
     static constexpr const char* SETTING_AUTO_ADJUST_BRIGHTNESS_KEY {"settings.display.auto_screen_brightness"};
-    std::map<uint64_t, std::shared_ptr<ScreenController>> controllerMap_;
-    sptr<IDisplayPowerCallback> callback_;
+    ScreenControllerRegistry controllers_;
+    // Display state change of an IDisplayPowerCallback, a lagging subscriber only gets the latest one per display
+    struct DisplayStateChange {
+        uint32_t displayId {0};
+        DisplayState state {DisplayState::DISPLAY_UNKNOWN};
+        uint32_t reason {0};
+    };
+    using DisplayStateMailbox = CallbackMailbox<DisplayStateChange>;
+    static constexpr size_t MAX_STATE_CALLBACKS = 32;
+    void AppendStateCallbacksDump(std::string& result);
+    // Drops a subscriber whose mailbox was quarantined for missing the delivery deadline
+    void RemoveQuarantinedCallback(const sptr<IRemoteObject>& remote);
+
+    // Registered IDisplayPowerCallback subscribers keyed by remote object, protected by mutex_
+    std::map<sptr<IRemoteObject>, std::shared_ptr<DisplayStateMailbox>> stateCallbacks_;
+    std::shared_ptr<DeliveryTracker> stateCallbackTracker_ {std::make_shared<DeliveryTracker>()};
+    // Copied into the mailbox of each new subscriber, protected by mutex_
+    DeliveryPolicy stateCallbackPolicy_;
     sptr<CallbackDeathRecipient> cbDeathRecipient_;
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
-    ffrt::mutex controllerMapMutex_;  // Protects concurrent find/emplace access to controllerMap_
     std::shared_ptr<MultiScreenDisplayStateCallbackManager> multiScreenCallbackMgr_;
+    sptr<ScreenDisconnectListener> screenDisconnectListener_;
 #endif
 
+    // Read-only view of display state and brightness shared with clients, see GetPowerSnapshot
+    DisplayPowerSnapshotWriter snapshotWriter_;
+    std::mutex snapshotPublishMutex_;
+    sptr<MainDisplayListener> mainDisplayListener_;
+    std::mutex brightnessBatchMutex_;
+    // Continuous brightness requests arriving within one interval are coalesced, only the newest value
+    // per display is applied when the interval ends. The apply mutex keeps a final non-continuous value
+    // from being overtaken by a drained one.
+    std::mutex continuousBrightnessMutex_;
+    std::mutex continuousBrightnessApplyMutex_;
+    std::map<uint32_t, uint32_t> pendingContinuousBrightness_;
+    bool isContinuousBrightnessScheduled_ {false};
+    std::atomic<uint64_t> continuousBrightnessApplied_ {0};
+    std::atomic<uint64_t> continuousBrightnessDropped_ {0};
     std::atomic_int32_t lastError_ {static_cast<int32_t>(DisplayErrors::ERR_OK)};
     std::mutex mutex_;
     static std::atomic_bool isBootCompleted_;
-    uint32_t displayOffDelayMs_ {0};
-    bool isDisplayDelayOff_ = false;
-    uint32_t displayId_ {0};
-    DisplayState displayState_ {DisplayState::DISPLAY_UNKNOWN};
-    uint32_t displayReason_ {0};
+    // Delayed display off of OverrideDisplayOffDelay, armed and pending per display
+    DisplayOffDelayScheduler offDelayScheduler_;
+    // The main display when OverrideDisplayOffDelay armed it, a fold may change the main display since
+    std::atomic<uint32_t> offDelayMainDisplayId_ {0};
     std::shared_ptr<PowerMgr::FFRTQueue> queue_;
     ffrt::mutex autoBrightnessMutex_;
     PowerMgr::FFRTTimer autoBrightnessQueue_ {"auto_brightness_queue"};
     bool isInTestMode_ {false};
     std::once_flag initFlag_;
-    ffrt::mutex screenOffDelayTaskMutex_;
 };
 } // namespace DisplayPowerMgr
 } // namespace OHOS
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISPLAYMGR_DISPLAY_STATE_MACHINE_H
+#define DISPLAYMGR_DISPLAY_STATE_MACHINE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "display_power_info.h"
+#include "power_state_machine_info.h"
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+enum class DisplayTransitionAction : uint8_t {
+    KEEP,                     // Already in the target state or not allowed, succeeds without any change
+    COMMIT,                   // Only the state changes, the panel power stays as it is
+    POWER_COMMIT,             // The panel is powered to the target state, then the state changes
+    POWER_ONLY,               // The panel is powered but the state is left to the next request, fails
+    INTERRUPT,                // Nothing changes and the request fails, the next request completes it
+};
+
+// Reasons that change how a transition is carried out
+enum class DisplayReasonClass : uint8_t {
+    NORMAL,
+    PRE_BRIGHT,            // The panel is lit ahead of authentication, the state follows on success
+    PRE_BRIGHT_AUTH_FAIL,  // Authentication failed after pre-bright, the panel goes off even if the state is OFF
+};
+
+// Display state transitions of ScreenController::UpdateState and DisplayPowerMgrService::SetDisplayStateInner,
+// indexed by current state, target state and reason class
+class DisplayStateMachine {
+public:
+    static constexpr size_t STATE_COUNT = static_cast<size_t>(DisplayState::DISPLAY_UNKNOWN) + 1;
+    static constexpr size_t REASON_CLASS_COUNT = 3;
+
+    // Out of range states are looked up as DISPLAY_UNKNOWN
+    static constexpr size_t GetIndex(DisplayState state)
+    {
+        auto index = static_cast<size_t>(state);
+        return index < STATE_COUNT ? index : STATE_COUNT - 1;
+    }
+
+    static constexpr DisplayReasonClass GetReasonClass(uint32_t reason)
+    {
+        if (reason == static_cast<uint32_t>(PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT)) {
+            return DisplayReasonClass::PRE_BRIGHT;
+        }
+        if (reason == static_cast<uint32_t>(
+            PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT_AUTH_FAIL_SCREEN_OFF)) {
+            return DisplayReasonClass::PRE_BRIGHT_AUTH_FAIL;
+        }
+        return DisplayReasonClass::NORMAL;
+    }
+
+    static constexpr DisplayTransitionAction GetAction(DisplayState current, DisplayState target,
+        DisplayReasonClass reasonClass)
+    {
+        return TABLE[static_cast<size_t>(reasonClass)][GetIndex(current)][GetIndex(target)];
+    }
+
+    static constexpr DisplayTransitionAction GetAction(DisplayState current, DisplayState target, uint32_t reason)
+    {
+        return GetAction(current, target, GetReasonClass(reason));
+    }
+
+    static constexpr bool IsPowerAction(DisplayTransitionAction action)
+    {
+        return action == DisplayTransitionAction::POWER_COMMIT || action == DisplayTransitionAction::POWER_ONLY;
+    }
+
+    // Whether a request for target is held back while a display off delay is overridden. This does not depend
+    // on the current state or the reason: every OFF and DOZE request is deferred, pre-bright ones included,
+    // and is looked up in the table only once the delay expires.
+    static constexpr bool IsDeferrable(DisplayState target)
+    {
+        return target == DisplayState::DISPLAY_OFF || target == DisplayState::DISPLAY_DOZE;
+    }
+
+private:
+    static constexpr DisplayTransitionAction K = DisplayTransitionAction::KEEP;
+    static constexpr DisplayTransitionAction C = DisplayTransitionAction::COMMIT;
+    static constexpr DisplayTransitionAction P = DisplayTransitionAction::POWER_COMMIT;
+    static constexpr DisplayTransitionAction O = DisplayTransitionAction::POWER_ONLY;
+    static constexpr DisplayTransitionAction I = DisplayTransitionAction::INTERRUPT;
+    using Row = std::array<DisplayTransitionAction, STATE_COUNT>;
+    using Table = std::array<std::array<Row, STATE_COUNT>, REASON_CLASS_COUNT>;
+
+    // Rows are the current state, columns the target state, in DisplayState order:
+    // OFF, DIM, ON, SUSPEND, DELAY_OFF, DOZE, DOZE_SUSPEND, UNKNOWN.
+    // The panel is powered for OFF, DOZE, DOZE_SUSPEND and ON, except ON from DIM where it is still lit.
+    // DIM from OFF is not allowed. Pre-bright never commits the state, and after an authentication
+    // failure the request is carried out even if the display is already in the target state.
+    static constexpr Table TABLE {{
+        {{  // NORMAL
+            Row {K, K, P, C, C, P, P, C},
+            Row {P, K, C, C, C, P, P, C},
+            Row {P, C, K, C, C, P, P, C},
+            Row {P, C, P, K, C, P, P, C},
+            Row {P, C, P, C, K, P, P, C},
+            Row {P, C, P, C, C, K, P, C},
+            Row {P, C, P, C, C, P, K, C},
+            Row {P, C, P, C, C, P, P, K},
+        }},
+        {{  // PRE_BRIGHT
+            Row {K, K, O, I, I, O, O, I},
+            Row {O, K, I, I, I, O, O, I},
+            Row {O, I, K, I, I, O, O, I},
+            Row {O, I, O, K, I, O, O, I},
+            Row {O, I, O, I, K, O, O, I},
+            Row {O, I, O, I, I, K, O, I},
+            Row {O, I, O, I, I, O, K, I},
+            Row {O, I, O, I, I, O, O, K},
+        }},
+        {{  // PRE_BRIGHT_AUTH_FAIL
+            Row {O, K, O, I, I, O, O, I},
+            Row {O, I, I, I, I, O, O, I},
+            Row {O, I, O, I, I, O, O, I},
+            Row {O, I, O, I, I, O, O, I},
+            Row {O, I, O, I, I, O, O, I},
+            Row {O, I, O, I, I, O, O, I},
+            Row {O, I, O, I, I, O, O, I},
+            Row {O, I, O, I, I, O, O, I},
+        }},
+    }};
+};
+
+static_assert(DisplayStateMachine::GetAction(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_DIM,
+    DisplayReasonClass::NORMAL) == DisplayTransitionAction::KEEP, "DIM is not allowed from OFF");
+static_assert(DisplayStateMachine::GetAction(DisplayState::DISPLAY_DIM, DisplayState::DISPLAY_ON,
+    DisplayReasonClass::NORMAL) == DisplayTransitionAction::COMMIT, "the panel is still lit in DIM");
+static_assert(DisplayStateMachine::GetAction(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_OFF,
+    DisplayReasonClass::PRE_BRIGHT_AUTH_FAIL) == DisplayTransitionAction::POWER_ONLY,
+    "the panel lit by pre-bright goes off although the state is OFF");
+static_assert(DisplayStateMachine::IsDeferrable(DisplayState::DISPLAY_DOZE) &&
+    !DisplayStateMachine::IsDeferrable(DisplayState::DISPLAY_DOZE_SUSPEND), "only OFF and DOZE are deferred");
+
+// Count and latency of each transition of one display. Latencies are in power of two buckets:
+// <1ms, <2ms, <4ms ... >=1024ms. Only relaxed atomics are used, Record never blocks.
+class DisplayTransitionMetrics {
+public:
+    static constexpr size_t BUCKET_COUNT = 12;
+
+    void Record(DisplayState from, DisplayState to, int64_t costMs, bool isSuccess)
+    {
+        Entry& entry = entries_[DisplayStateMachine::GetIndex(from)][DisplayStateMachine::GetIndex(to)];
+        if (!isSuccess) {
+            entry.failed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        uint64_t cost = costMs > 0 ? static_cast<uint64_t>(costMs) : 0;
+        entry.count.fetch_add(1, std::memory_order_relaxed);
+        entry.totalMs.fetch_add(cost, std::memory_order_relaxed);
+        uint64_t maxMs = entry.maxMs.load(std::memory_order_relaxed);
+        while (cost > maxMs && !entry.maxMs.compare_exchange_weak(maxMs, cost, std::memory_order_relaxed)) {}
+        entry.buckets[GetBucket(cost)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t GetCount(DisplayState from, DisplayState to) const
+    {
+        return entries_[DisplayStateMachine::GetIndex(from)][DisplayStateMachine::GetIndex(to)].count.load(
+            std::memory_order_relaxed);
+    }
+
+    void Dump(std::string& result) const
+    {
+        for (size_t from = 0; from < DisplayStateMachine::STATE_COUNT; from++) {
+            for (size_t to = 0; to < DisplayStateMachine::STATE_COUNT; to++) {
+                DumpEntry(from, to, result);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> count {0};
+        std::atomic<uint64_t> failed {0};
+        std::atomic<uint64_t> totalMs {0};
+        std::atomic<uint64_t> maxMs {0};
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets {};
+    };
+
+    static size_t GetBucket(uint64_t costMs)
+    {
+        size_t bucket = 0;
+        while (costMs > 0 && bucket < BUCKET_COUNT - 1) {
+            costMs >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    void DumpEntry(size_t from, size_t to, std::string& result) const
+    {
+        const Entry& entry = entries_[from][to];
+        uint64_t count = entry.count.load(std::memory_order_relaxed);
+        uint64_t failed = entry.failed.load(std::memory_order_relaxed);
+        if (count == 0 && failed == 0) {
+            return;
+        }
+        result.append("  Transition ").append(std::to_string(from)).append("->").append(std::to_string(to));
+        result.append(" Count=").append(std::to_string(count));
+        result.append(" Failed=").append(std::to_string(failed));
+        if (count > 0) {
+            result.append(" AvgMs=").append(std::to_string(entry.totalMs.load(std::memory_order_relaxed) / count));
+            result.append(" MaxMs=").append(std::to_string(entry.maxMs.load(std::memory_order_relaxed)));
+            result.append(" Hist=");
+            bool isFirst = true;
+            for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+                uint64_t value = entry.buckets[bucket].load(std::memory_order_relaxed);
+                if (value == 0) {
+                    continue;
+                }
+                result.append(isFirst ? "" : ",");
+                result.append(bucket + 1 < BUCKET_COUNT ? "<" : ">=");
+                result.append(std::to_string(1ULL << (bucket + 1 < BUCKET_COUNT ? bucket : bucket - 1)));
+                result.append("ms:").append(std::to_string(value));
+                isFirst = false;
+            }
+        }
+        result.append("\n");
+    }
+
+    std::array<std::array<Entry, DisplayStateMachine::STATE_COUNT>, DisplayStateMachine::STATE_COUNT> entries_;
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // DISPLAYMGR_DISPLAY_STATE_MACHINE_H
@@ -18,12 +18,15 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <mutex>
-#include <utility>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <iremote_object.h>
 
+#include "callback_mailbox.h"
 #include "display_log.h"
 #include "display_power_info.h"
 #include "ffrt_utils.h"
@@ -32,7 +35,8 @@
 namespace OHOS {
 namespace DisplayPowerMgr {
 
-class MultiScreenDisplayStateCallbackManager {
+class MultiScreenDisplayStateCallbackManager
+    : public std::enable_shared_from_this<MultiScreenDisplayStateCallbackManager> {
 public:
     MultiScreenDisplayStateCallbackManager() = default;
     ~MultiScreenDisplayStateCallbackManager() = default;
@@ -40,10 +44,42 @@ public:
     bool Register(const sptr<IRemoteObject>& callback, uint64_t screenId);
     bool Unregister(const sptr<IRemoteObject>& callback, uint64_t screenId);
     bool RemoveAll(const sptr<IRemoteObject>& callback);
+    // Queues the change to every subscriber of screenId and of all screens, and returns without waiting.
+    // Subscribers are called in parallel, each one receives its changes in order. A subscriber that keeps
+    // missing the delivery deadline is quarantined and removed, see CallbackMailbox.
     void Notify(uint64_t screenId, const std::string& screenName, DisplayState state, uint32_t reason);
     void PublishCommonEvent(uint64_t screenId, const std::string& screenName, DisplayState state, uint32_t reason);
+    // Returns false if deliveries are still running after timeoutMs
+    bool WaitForDeliveries(uint32_t timeoutMs);
+    void Dump(std::string& result);
 
 private:
+    struct Notification {
+        uint64_t screenId {0};
+        std::string screenName;
+        DisplayState state {DisplayState::DISPLAY_UNKNOWN};
+        uint32_t reason {0};
+    };
+
+    // One registered remote object, whatever the number of screens it subscribed to
+    struct Subscriber {
+        const sptr<IRemoteObject> remote;
+        const int32_t pid;
+        const int32_t uid;
+        const std::shared_ptr<CallbackMailbox<Notification>> mailbox;
+    };
+    using SubscriberList = std::vector<std::shared_ptr<Subscriber>>;
+
+    // Immutable subscriber lookup of Notify, rebuilt and swapped whenever a registration changes
+    struct SubscriberIndex {
+        std::unordered_map<uint64_t, SubscriberList> screens;
+        SubscriberList allScreens;
+    };
+
+    std::shared_ptr<Subscriber> CreateSubscriber(const sptr<IRemoteObject>& callback, int32_t pid, int32_t uid);
+    void RebuildIndexLocked();
+    void DetachLocked(const sptr<IRemoteObject>& callback);
+
     class CallbackDeathRecipient : public IRemoteObject::DeathRecipient {
     public:
         explicit CallbackDeathRecipient(MultiScreenDisplayStateCallbackManager& manager) : manager_(manager) {}
@@ -63,8 +99,13 @@ private:
 
     std::multimap<sptr<IRemoteObject>, uint64_t> callbacks_;
     std::map<sptr<IRemoteObject>, sptr<CallbackDeathRecipient>> deathRecipients_;
-    std::map<sptr<IRemoteObject>, std::pair<int32_t, int32_t>> callbackPidUidMap_;
-    ffrt::mutex mutex_;  // Protects callbacks_, deathRecipients_ and callbackPidUidMap_
+    std::map<sptr<IRemoteObject>, std::shared_ptr<Subscriber>> subscribers_;
+    ffrt::mutex mutex_;  // Protects callbacks_, deathRecipients_ and subscribers_, serializes index rebuilds
+    std::mutex indexMutex_;  // Only guards the index_ pointer swap, never held while calling out
+    std::shared_ptr<const SubscriberIndex> index_ {std::make_shared<SubscriberIndex>()};
+    std::shared_ptr<DeliveryTracker> tracker_ {std::make_shared<DeliveryTracker>()};
+    // Copied into the mailbox of each new subscriber, protected by mutex_
+    DeliveryPolicy deliveryPolicy_;
 };
 
 } // namespace DisplayPowerMgr
@@ -17,11 +17,13 @@
 #define DISPLAYMGR_SCREEN_CONTROLLER_H
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <cstdint>
 
 #include "display_power_info.h"
+#include "display_state_machine.h"
 #include "ffrt_utils.h"
 #include "gradual_animator.h"
 #include "screen_action.h"
@@ -49,11 +51,16 @@ public:
     DisplayState GetState();
     DisplayState SetDelayOffState();
     DisplayState SetOnState();
+    // Carries out the transition of DisplayStateMachine from the current state to state
     bool UpdateState(DisplayState state, uint32_t reason);
     void UpdateCachedState(DisplayState state);
     bool IsScreenOn();
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
     bool UpdateMultiScreenState(DisplayState state, uint32_t reason, const std::string& screenName);
+    // The two halves of UpdateMultiScreenState: powering the panel through the display manager,
+    // which may run concurrently with other screens, then brightness, notification and state update
+    bool ApplyMultiScreenPower(DisplayState state, uint32_t reason);
+    bool CommitMultiScreenState(DisplayState state, uint32_t reason, const std::string& screenName);
     ffrt::mutex& GetScreenLock();
 #endif
 
@@ -73,12 +80,14 @@ public:
 
     uint32_t GetScreenOnBrightness() const;
 
-    void RegisterSettingBrightnessObserver();
+    // observer receives every setting brightness change, including those this controller does not apply
+    void RegisterSettingBrightnessObserver(std::function<void(uint32_t)> observer = nullptr);
     void UnregisterSettingBrightnessObserver();
     double GetDiscount() const;
 
     uint32_t GetAnimationUpdateTime() const;
     void SetCoordinated(bool coordinated);
+    void DumpTransitions(std::string& result) const;
 private:
     void OnStateChanged(DisplayState state, uint32_t reason);
 
@@ -86,11 +95,10 @@ private:
     bool CanDiscountBrightness();
     bool CanOverrideBrightness();
     bool CanBoostBrightness();
-    bool IsNeedSkipNextProc(uint32_t reason);
     bool UpdateBrightness(uint32_t value, uint32_t gradualDuration = 0, bool updateSetting = false);
     void SetSettingBrightness(uint32_t value);
     uint32_t GetSettingBrightness(const std::string& key = SETTING_BRIGHTNESS_KEY) const;
-    void BrightnessSettingUpdateFunc(const std::string& key);
+    void BrightnessSettingUpdateFunc(const std::string& key, const std::function<void(uint32_t)>& observer);
     bool SkipNotify(DisplayState targetState);
 
     static const constexpr char* SETTING_BRIGHTNESS_KEY {"settings.display.screen_brightness_status"};
@@ -109,6 +117,7 @@ private:
     std::shared_ptr<ScreenAction> action_ {nullptr};
     std::shared_ptr<AnimateCallback> animateCallback_ {nullptr};
     std::shared_ptr<GradualAnimator> animator_;
+    DisplayTransitionMetrics transitionMetrics_;
 };
 } // namespace DisplayPowerMgr
 } // namespace OHOS
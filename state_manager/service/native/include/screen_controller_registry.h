@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_DISPLAY_MANAGER_SCREEN_CONTROLLER_REGISTRY_H
+#define POWERMGR_DISPLAY_MANAGER_SCREEN_CONTROLLER_REGISTRY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+class ScreenController;
+
+// Screen id to controller table read by every IPC handler and changed only on screen hotplug.
+// Readers look up an immutable vector sorted by id without taking a lock. Writers are serialized,
+// publish a modified copy and free the previous one once no reader can still be using it.
+template<typename Controller>
+class ControllerRegistry {
+public:
+    using Entry = std::pair<uint64_t, std::shared_ptr<Controller>>;
+    using Entries = std::vector<Entry>;
+
+    ControllerRegistry() : current_(new Entries()) {}
+    ControllerRegistry(const ControllerRegistry&) = delete;
+    ControllerRegistry& operator=(const ControllerRegistry&) = delete;
+    ~ControllerRegistry()
+    {
+        delete current_.load();
+    }
+
+    std::shared_ptr<Controller> Find(uint64_t id) const
+    {
+        ReadGuard guard(*this);
+        const Entries& entries = *guard.entries;
+        auto iter = LowerBound(entries, id);
+        return (iter != entries.end() && iter->first == id) ? iter->second : nullptr;
+    }
+
+    bool Contains(uint64_t id) const
+    {
+        return Find(id) != nullptr;
+    }
+
+    // Copy of all entries in ascending id order
+    Entries GetAll() const
+    {
+        ReadGuard guard(*this);
+        return *guard.entries;
+    }
+
+    std::vector<uint64_t> GetIds() const
+    {
+        ReadGuard guard(*this);
+        std::vector<uint64_t> ids;
+        ids.reserve(guard.entries->size());
+        for (const auto& entry : *guard.entries) {
+            ids.push_back(entry.first);
+        }
+        return ids;
+    }
+
+    size_t Size() const
+    {
+        ReadGuard guard(*this);
+        return guard.entries->size();
+    }
+
+    // Returns false if a controller is already registered for id
+    bool Emplace(uint64_t id, std::shared_ptr<Controller> controller)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        const Entries& entries = *current_.load();
+        auto iter = LowerBound(entries, id);
+        if (iter != entries.end() && iter->first == id) {
+            return false;
+        }
+        auto next = new Entries(entries);
+        next->insert(next->begin() + (iter - entries.begin()), Entry(id, std::move(controller)));
+        Publish(next);
+        return true;
+    }
+
+    // Returns the registered controller, creating and registering one if there is none yet
+    std::shared_ptr<Controller> FindOrEmplace(uint64_t id, const std::function<std::shared_ptr<Controller>()>& create)
+    {
+        if (auto controller = Find(id); controller != nullptr) {
+            return controller;
+        }
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        const Entries& entries = *current_.load();
+        auto iter = LowerBound(entries, id);
+        if (iter != entries.end() && iter->first == id) {
+            return iter->second;
+        }
+        auto controller = create();
+        auto next = new Entries(entries);
+        next->insert(next->begin() + (iter - entries.begin()), Entry(id, controller));
+        Publish(next);
+        return controller;
+    }
+
+    bool Erase(uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        const Entries& entries = *current_.load();
+        auto iter = LowerBound(entries, id);
+        if (iter == entries.end() || iter->first != id) {
+            return false;
+        }
+        auto next = new Entries(entries);
+        next->erase(next->begin() + (iter - entries.begin()));
+        Publish(next);
+        return true;
+    }
+
+    // Replaces all entries, used to restore a copy taken with GetAll
+    void Reset(Entries entries = {})
+    {
+        std::sort(entries.begin(), entries.end(),
+            [](const Entry& lhs, const Entry& rhs) { return lhs.first < rhs.first; });
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Publish(new Entries(std::move(entries)));
+    }
+
+private:
+    // Reader counters are striped over cache lines so that binder threads do not contend on one line
+    static constexpr int32_t PHASE_COUNT = 2;
+    static constexpr size_t READER_STRIPES = 16;
+    struct alignas(64) ReaderCounter {
+        std::atomic<uint32_t> count {0};
+    };
+
+    static size_t GetReaderStripe()
+    {
+        static std::atomic<size_t> nextStripe {0};
+        thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % READER_STRIPES;
+        return stripe;
+    }
+
+    // A reader registers on a counter of the current phase before loading the entries, so a writer
+    // that has swapped the entries only has to wait for the counters of both phases to drain once
+    struct ReadGuard {
+        explicit ReadGuard(const ControllerRegistry& registry)
+            : counter(registry.readers_[registry.phase_.load()][GetReaderStripe()].count)
+        {
+            counter.fetch_add(1);
+            entries = registry.current_.load();
+        }
+        ~ReadGuard()
+        {
+            counter.fetch_sub(1);
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        std::atomic<uint32_t>& counter;
+        const Entries* entries {nullptr};
+    };
+
+    static typename Entries::const_iterator LowerBound(const Entries& entries, uint64_t id)
+    {
+        return std::lower_bound(entries.begin(), entries.end(), id,
+            [](const Entry& entry, uint64_t key) { return entry.first < key; });
+    }
+
+    // Called with writeMutex_ held
+    void Publish(Entries* next)
+    {
+        Entries* previous = current_.exchange(next);
+        // Readers that loaded the previous entries are counted in one of the two phases. New readers
+        // go to the other phase after each flip, so each wait only drains readers already inside.
+        for (int32_t i = 0; i < PHASE_COUNT; i++) {
+            uint32_t phase = phase_.load();
+            phase_.store(phase ^ 1U);
+            for (auto& reader : readers_[phase]) {
+                while (reader.count.load() != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        delete previous;
+    }
+
+    std::atomic<Entries*> current_;
+    std::atomic<uint32_t> phase_ {0};
+    mutable ReaderCounter readers_[PHASE_COUNT][READER_STRIPES];
+    std::mutex writeMutex_;
+};
+
+using ScreenControllerRegistry = ControllerRegistry<ScreenController>;
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // POWERMGR_DISPLAY_MANAGER_SCREEN_CONTROLLER_REGISTRY_H
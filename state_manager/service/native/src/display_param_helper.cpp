@@ -21,25 +21,37 @@
 namespace OHOS {
 namespace DisplayPowerMgr {
 using namespace OHOS::PowerMgr;
-uint32_t DisplayParamHelper::GetDefaultBrightness()
+uint32_t DisplayParamHelper::GetCachedIntValue(std::atomic<int64_t>& cache, const char* key, int32_t def)
 {
-    int32_t value = SysParam::GetIntValue(KEY_DEFAULT_BRIGHTNESS, BRIGHTNESS_DEFAULT);
-    DISPLAY_HILOGD(FEAT_STATE, "GetDefaultBrightness value=%{public}d", value);
+    int64_t value = cache.load(std::memory_order_acquire);
+    if (value == PARAM_NOT_CACHED) {
+        value = SysParam::GetIntValue(key, def);
+        DISPLAY_HILOGD(FEAT_STATE, "read param %{public}s value=%{public}d", key, static_cast<int32_t>(value));
+        cache.store(value, std::memory_order_release);
+    }
     return static_cast<uint32_t>(value);
 }
 
+uint32_t DisplayParamHelper::GetDefaultBrightness()
+{
+    return GetCachedIntValue(defaultBrightness_, KEY_DEFAULT_BRIGHTNESS, BRIGHTNESS_DEFAULT);
+}
+
 uint32_t DisplayParamHelper::GetMaxBrightness()
 {
-    int32_t value = SysParam::GetIntValue(KEY_MAX_BRIGHTNESS, BRIGHTNESS_MAX);
-    DISPLAY_HILOGD(FEAT_STATE, "GetMaxBrightness value=%{public}d", value);
-    return static_cast<uint32_t>(value);
+    return GetCachedIntValue(maxBrightness_, KEY_MAX_BRIGHTNESS, BRIGHTNESS_MAX);
 }
 
 uint32_t DisplayParamHelper::GetMinBrightness()
 {
-    int32_t value = SysParam::GetIntValue(KEY_MIN_BRIGHTNESS, BRIGHTNESS_MIN);
-    DISPLAY_HILOGD(FEAT_STATE, "GetMinBrightness value=%{public}d", value);
-    return static_cast<uint32_t>(value);
+    return GetCachedIntValue(minBrightness_, KEY_MIN_BRIGHTNESS, BRIGHTNESS_MIN);
+}
+
+void DisplayParamHelper::InvalidateCache()
+{
+    defaultBrightness_.store(PARAM_NOT_CACHED, std::memory_order_release);
+    maxBrightness_.store(PARAM_NOT_CACHED, std::memory_order_release);
+    minBrightness_.store(PARAM_NOT_CACHED, std::memory_order_release);
 }
 
 void DisplayParamHelper::RegisterBootCompletedCallback(BootCompletedCallback& callback)
@@ -14,6 +14,9 @@
  */
 
 #include "display_power_mgr_service.h"
+#include <cerrno>
+#include <cstring>
+#include <cJSON.h>
 #ifdef HAS_HIVIEWDFX_HISYSEVENT_PART
 #include <hisysevent.h>
 #endif
@@ -25,16 +28,25 @@
 #include "new"
 #include "screen_action.h"
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
+#include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
 #include <mutex>
+#include <set>
 #endif
 #ifdef ENABLE_SENSOR_PART
 #include "sensor_agent.h"
 #endif
 #include "xcollie/watchdog.h"
 #include "display_log.h"
+#include "brightness_data_listener_registry.h"
+#include "brightness_setting_cache.h"
+#include "brightness_threshold_monitor.h"
+#include "display_api_metrics.h"
 #include "display_auto_brightness.h"
 #include "display_setting_helper.h"
+#include "display_trace_recorder.h"
+#include "brightness_param_helper.h"
 #include "display_param_helper.h"
 #include "permission.h"
 #include "power_state_machine_info.h"
@@ -50,7 +62,6 @@ using namespace OHOS::PowerMgr;
 using namespace Rosen;
 namespace {
 DisplayParamHelper::BootCompletedCallback g_bootCompletedCallback;
-FFRTHandle g_screenOffDelayTaskHandle;
 const uint32_t GET_DISPLAY_ID_DELAY_MS = 50;
 const uint32_t US_PER_MS = 1000;
 const uint32_t GET_DISPLAY_ID_RETRY_COUNT = 3;
@@ -59,24 +70,56 @@ const uint32_t TEST_MODE = 1;
 const uint32_t NORMAL_MODE = 2;
 const uint32_t BOOTED_COMPLETE_DELAY_TIME = 2000;
 const int32_t ERR_OK = 0;
+const std::u16string DUMP_TRACE_ARG = u"--trace";
+const std::u16string DUMP_TRACE_BINARY_ARG = u"--trace-binary";
 
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
 constexpr uint32_t MAX_SCREEN_NAME_LENGTH = 100;
+
+// Runs task(0) to task(count - 1) on at most maxParallel threads, the calling one included,
+// and returns once all of them have completed
+void RunInParallel(size_t count, size_t maxParallel, const std::function<void(size_t)>& task)
+{
+    std::atomic<size_t> next {0};
+    auto worker = [&next, count, &task] {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            task(i);
+        }
+    };
+    size_t helpers = (count > 1 && maxParallel > 1) ? std::min(count, maxParallel) - 1 : 0;
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t running = helpers;
+    for (size_t i = 0; i < helpers; i++) {
+        FFRTUtils::SubmitTask([&worker, &mutex, &done, &running] {
+            worker();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) {
+                done.notify_all();
+            }
+        });
+    }
+    worker();
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&running] { return running == 0; });
+}
 #endif
 
-#define CHECK_PARAM_WITH_RET(value, lower, upper, ret) \
-    RETURN_IF_WITH_RET(IS_OUT_RANGE(value, lower, upper), ret)
-#define CHECK_PARAM_DURATION_WITH_RET(value, ret) \
-    RETURN_IF_WITH_RET(IS_OUT_RANGE(value, 0, 60 * 1000), ret)
+// Only used in members, the rejected parameter is reported as the last error
+#define CHECK_PARAM_WITH_RET(value, lower, upper, ret)            \
+    do {                                                          \
+        if (IS_OUT_RANGE(value, lower, upper)) {                  \
+            SetLastError(DisplayErrors::ERR_PARAM_INVALID);       \
+            return (ret);                                         \
+        }                                                         \
+    } while (0)
+#define CHECK_PARAM_DURATION_WITH_RET(value, ret) CHECK_PARAM_WITH_RET(value, 0, 60 * 1000, ret)
 }
 namespace {
 const uint32_t ID_AUTO_SWITCH_CALLBACK = 0;
 const uint32_t ID_AUTO_SWITCH_UPDATE = 1;
 }
 
-const uint32_t DisplayPowerMgrService::BRIGHTNESS_MIN = DisplayParamHelper::GetMinBrightness();
-const uint32_t DisplayPowerMgrService::BRIGHTNESS_DEFAULT = DisplayParamHelper::GetDefaultBrightness();
-const uint32_t DisplayPowerMgrService::BRIGHTNESS_MAX = DisplayParamHelper::GetMaxBrightness();
 std::atomic_bool DisplayPowerMgrService::isBootCompleted_ = false;
 DisplayPowerMgrService::DisplayPowerMgrService() = default;
 
@@ -99,18 +142,24 @@ void DisplayPowerMgrService::Init()
         }
     }
 #ifndef FUZZ_COV_TEST
-    BrightnessManager::Get().Init(BRIGHTNESS_MAX, BRIGHTNESS_MIN);
+    BrightnessManager::Get().Init(DisplayParamHelper::GetMaxBrightness(), DisplayParamHelper::GetMinBrightness());
 #endif
     for (const auto& id: displayIds) {
         DISPLAY_HILOGI(COMP_SVC, "find display, id=%{public}u", id);
-        controllerMap_.emplace(id, std::make_shared<ScreenController>(id));
+        controllers_.Emplace(id, std::make_shared<ScreenController>(id));
         BrightnessManager::Get().SetDisplayId(id);
     }
+    InitPowerSnapshot();
 
-    callback_ = nullptr;
     cbDeathRecipient_ = nullptr;
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
     multiScreenCallbackMgr_ = std::make_shared<MultiScreenDisplayStateCallbackManager>();
+    screenDisconnectListener_ = new ScreenDisconnectListener();
+    if (Rosen::ScreenManagerLite::GetInstance().RegisterScreenListener(screenDisconnectListener_) !=
+        Rosen::DMError::DM_OK) {
+        DISPLAY_HILOGW(COMP_SVC, "register screen listener failed");
+        screenDisconnectListener_ = nullptr;
+    }
 #endif
     RegisterBootCompletedCallback();
 }
@@ -118,6 +167,12 @@ void DisplayPowerMgrService::Init()
 void DisplayPowerMgrService::RegisterBootCompletedCallback()
 {
     g_bootCompletedCallback = []() {
+        // Parameters may still be written during boot, re-read them once it completes
+        DisplayParamHelper::InvalidateCache();
+        BrightnessParamHelper::InvalidateCache();
+        if (auto pms = DelayedSpSingleton<DisplayPowerMgrService>::GetInstance(); pms != nullptr) {
+            pms->snapshotWriter_.InvalidateLimits();
+        }
         isBootCompleted_ = true;
     };
     DisplayParamHelper::RegisterBootCompletedCallback(g_bootCompletedCallback);
@@ -125,8 +180,21 @@ void DisplayPowerMgrService::RegisterBootCompletedCallback()
 
 void DisplayPowerMgrService::Deinit()
 {
+    if (mainDisplayListener_ != nullptr) {
+        Rosen::DisplayManagerLite::GetInstance().UnregisterDisplayModeListener(mainDisplayListener_);
+        mainDisplayListener_ = nullptr;
+    }
+#ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
+    if (screenDisconnectListener_ != nullptr) {
+        Rosen::ScreenManagerLite::GetInstance().UnregisterScreenListener(screenDisconnectListener_);
+        screenDisconnectListener_ = nullptr;
+    }
+#endif
     UnregisterSettingObservers();
+    BrightnessManager::Get().SetChangeObserver(nullptr);
     BrightnessManager::Get().DeInit();
+    // After the brightness manager, whose pending setting writes still update the cache
+    BrightnessSettingCache::Get().DeInit();
     isBootCompleted_ = false;
 }
 
@@ -135,8 +203,7 @@ void DisplayPowerMgrService::Reset()
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "reset begin");
     if (queue_) {
         queue_.reset();
-        std::lock_guard<ffrt::mutex> lock(screenOffDelayTaskMutex_);
-        g_screenOffDelayTaskHandle = nullptr;
+        offDelayScheduler_.CancelAll();
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "destruct display_power_queue");
     }
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "reset end");
@@ -144,7 +211,7 @@ void DisplayPowerMgrService::Reset()
 
 void DisplayPowerMgrService::HandleBootBrightness()
 {
-    BrightnessManager::Get().Init(BRIGHTNESS_MAX, BRIGHTNESS_MIN);
+    BrightnessManager::Get().Init(DisplayParamHelper::GetMaxBrightness(), DisplayParamHelper::GetMinBrightness());
     std::call_once(initFlag_, [this] {
         SetBootCompletedBrightness();
         FFRTTask task = []() {
@@ -168,15 +235,85 @@ void DisplayPowerMgrService::SetBootCompletedBrightness()
     BrightnessManager::Get().SetDisplayId(currentDisplayId);
     BrightnessManager::Get().SetDisplayState(currentDisplayId, state, 0);
     SetBrightnessInner(brightness, mainDisplayId, false);
+    BrightnessManager::Get().SetObservedSettingBrightness(brightness);
+    PublishPowerSnapshot();
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetBootCompletedBrightness currentDisplayId=%{public}d", currentDisplayId);
 }
 
+void DisplayPowerMgrService::InitPowerSnapshot()
+{
+    if (!snapshotWriter_.Create()) {
+        DISPLAY_HILOGW(COMP_SVC, "create power snapshot failed, errno=%{public}d", errno);
+        return;
+    }
+    // Brightness is only published when the built-in brightness service reports its writes
+    bool ret = BrightnessManager::Get().SetChangeObserver([this] { PublishPowerSnapshot(); });
+    // Lets other services reuse the ambient light estimates instead of subscribing to the light sensor again
+    bool isLuxObserved = BrightnessManager::Get().SetLuxObserver(
+        [this](bool isValid, float lux, float filteredLux, float smoothedLux) {
+            DisplayLuxSnapshotData data;
+            data.lux = lux;
+            data.filteredLux = filteredLux;
+            data.smoothedLux = smoothedLux;
+            data.flags = isValid ? SNAPSHOT_LUX_VALID : 0;
+            snapshotWriter_.PublishLux(data);
+        });
+    mainDisplayListener_ = new MainDisplayListener();
+    if (Rosen::DisplayManagerLite::GetInstance().RegisterDisplayModeListener(mainDisplayListener_) !=
+        Rosen::DMError::DM_OK) {
+        DISPLAY_HILOGW(COMP_SVC, "register display mode listener failed");
+        mainDisplayListener_ = nullptr;
+    }
+    DISPLAY_HILOGI(COMP_SVC, "power snapshot created, brightness observed=%{public}d, lux observed=%{public}d",
+        ret, isLuxObserved);
+    PublishPowerSnapshot();
+}
+
+void DisplayPowerMgrService::MainDisplayListener::OnDisplayModeChanged(Rosen::FoldDisplayMode displayMode)
+{
+    DISPLAY_HILOGI(COMP_SVC, "OnDisplayModeChanged displayMode=%{public}u", displayMode);
+    if (auto pms = DelayedSpSingleton<DisplayPowerMgrService>::GetInstance(); pms != nullptr) {
+        pms->snapshotWriter_.InvalidateLimits();
+        // The fold may have made another display the main one, its off delay then moves along at once
+        pms->FollowMainDisplayOffDelay(pms->GetMainDisplayIdInner());
+    }
+}
+
+void DisplayPowerMgrService::PublishPowerSnapshot()
+{
+    auto controllers = controllers_.GetAll();
+    // Publishers read and write under one lock, so that a slow one cannot overwrite newer values
+    std::lock_guard<std::mutex> lock(snapshotPublishMutex_);
+    for (const auto& [id, controller] : controllers) {
+        if (controller == nullptr) {
+            continue;
+        }
+        // Each display is published from its own pipeline, or from the default one if it has none
+        auto state = BrightnessManager::Get().GetDisplayPublishedState(static_cast<uint32_t>(id));
+        DisplayPowerSnapshotData data;
+        data.displayId = static_cast<uint32_t>(id);
+        data.state = static_cast<int32_t>(controller->GetState());
+        data.brightness = state.settingBrightness;
+        data.deviceBrightness = state.deviceBrightness;
+        data.deviceBrightnessHbm = state.deviceBrightnessHbm;
+        data.discount = state.discount;
+        data.flags = SNAPSHOT_STATE_VALID | SNAPSHOT_AUTO_ADJUST_VALID;
+        data.flags |= state.isSettingBrightnessValid ? SNAPSHOT_BRIGHTNESS_VALID : 0;
+        data.flags |= state.isDeviceBrightnessValid ? SNAPSHOT_DEVICE_BRIGHTNESS_VALID : 0;
+        data.flags |= state.isAutoBrightnessEnabled ? SNAPSHOT_AUTO_ADJUST : 0;
+        data.flags |= state.isBrightnessOverridden ? SNAPSHOT_OVERRIDDEN : 0;
+        data.flags |= state.isBrightnessBoosted ? SNAPSHOT_BOOSTED : 0;
+        snapshotWriter_.Publish(data);
+    }
+}
+
 void DisplayPowerMgrService::RegisterSettingObservers()
 {
     uint32_t mainDisplayId = GetMainDisplayIdInner();
-    auto iter = controllerMap_.find(mainDisplayId);
-    if (iter != controllerMap_.end()) {
-        iter->second->RegisterSettingBrightnessObserver();
+    if (auto controller = controllers_.Find(mainDisplayId); controller != nullptr) {
+        // Changes made outside this service, e.g. by the settings app, are published as well
+        controller->RegisterSettingBrightnessObserver(
+            [](uint32_t value) { BrightnessManager::Get().SetObservedSettingBrightness(value); });
     }
     // The callback may be fired immediately when the observer is registered
     DisplaySettingHelper::RegisterSettingAutoBrightnessObserver([](const std::string& key) {
@@ -196,9 +333,8 @@ void DisplayPowerMgrService::RegisterSettingObservers()
 void DisplayPowerMgrService::UnregisterSettingObservers()
 {
     uint32_t mainDisplayId = GetMainDisplayIdInner();
-    auto iter = controllerMap_.find(mainDisplayId);
-    if (iter != controllerMap_.end()) {
-        iter->second->UnregisterSettingBrightnessObserver();
+    if (auto controller = controllers_.Find(mainDisplayId); controller != nullptr) {
+        controller->UnregisterSettingBrightnessObserver();
     }
     DisplaySettingHelper::UnregisterSettingAutoBrightnessObserver();
 }
@@ -221,6 +357,7 @@ void DisplayPowerMgrService::AutoBrightnessSettingUpdateFunc()
 bool DisplayPowerMgrService::SetScreenOnBrightnessInner()
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     BrightnessManager::Get().SetScreenOnBrightness();
@@ -230,15 +367,15 @@ bool DisplayPowerMgrService::SetScreenOnBrightnessInner()
 bool DisplayPowerMgrService::UpdateScreenPowerStateInner(bool isScreenOn)
 {
     DisplayState displayState = isScreenOn ? DisplayState::DISPLAY_ON : DisplayState::DISPLAY_OFF;
-    auto iterator = controllerMap_.find(DEFALUT_DISPLAY_ID);
-    if (iterator == controllerMap_.end()) {
-        iterator = controllerMap_.find(GetMainDisplayIdInner());
-        if (iterator == controllerMap_.end()) {
+    auto controller = controllers_.Find(DEFALUT_DISPLAY_ID);
+    if (controller == nullptr) {
+        controller = controllers_.Find(GetMainDisplayIdInner());
+        if (controller == nullptr) {
             DISPLAY_HILOGE(COMP_SVC, "UpdateScreenPowerState failed, no controller found");
             return false;
         }
     }
-    iterator->second->UpdateCachedState(displayState);
+    controller->UpdateCachedState(displayState);
     return true;
 }
 
@@ -249,64 +386,72 @@ void DisplayPowerMgrService::ClearOffset()
 
 void DisplayPowerMgrService::ScreenOffDelay(uint32_t id, DisplayState state, uint32_t reason)
 {
-    isDisplayDelayOff_ = false;
     DISPLAY_HILOGI(COMP_SVC, "ScreenOffDelay %{public}d, %{public}d,  %{public}d", id, state, reason);
-    auto iterator = controllerMap_.find(id);
-    if (iterator == controllerMap_.end()) {
+    auto controller = controllers_.Find(id);
+    if (controller == nullptr) {
         return;
     }
-    iterator->second->UpdateState(state, reason);
+    controller->UpdateState(state, reason);
 }
 
 bool DisplayPowerMgrService::SetDisplayStateInner(uint32_t id, DisplayState state, uint32_t reason)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     uint32_t ffrtId = ffrt::this_task::get_id();
     DISPLAY_HILOGI(COMP_SVC, "[UL_POWER] SetDisplayState %{public}d, %{public}d, %{public}u, ffrtId=%{public}u",
         id, state, reason, ffrtId);
-    auto iterator = controllerMap_.find(id);
-    if (iterator == controllerMap_.end()) {
+    auto controller = controllers_.Find(id);
+    if (controller == nullptr) {
         if (id != DEFALUT_DISPLAY_ID) {
+            SetLastError(DisplayErrors::ERR_PARAM_INVALID);
             return false;
         }
         id = GetMainDisplayIdInner();
-        iterator = controllerMap_.find(id);
-        if (iterator == controllerMap_.end()) {
+        controller = controllers_.Find(id);
+        if (controller == nullptr) {
+            SetLastError(DisplayErrors::ERR_PARAM_INVALID);
             return false;
         }
+        DisplayTraceRecorder::Get().JoinTransaction(id, DisplayTraceRecorder::Get().GetTransaction(DEFALUT_DISPLAY_ID));
     }
     BrightnessManager::Get().SetDisplayState(id, state, reason);
 
-    if (state == DisplayState::DISPLAY_OFF || state == DisplayState::DISPLAY_DOZE) {
-        if (!isDisplayDelayOff_) {
-            DISPLAY_HILOGI(COMP_SVC, "screen off immediately");
-            bool ret = iterator->second->UpdateState(state, reason);
-            if (!ret) {
-                UndoSetDisplayStateInner(id, iterator->second->GetState(), reason);
-            }
-            return ret;
-        }
-        displayId_ = id;
-        displayState_ = state;
-        displayReason_ = reason;
-        FFRTTask task = [this]() { ScreenOffDelay(displayId_, displayState_, displayReason_); };
-        std::lock_guard<ffrt::mutex> lock(screenOffDelayTaskMutex_);
-        g_screenOffDelayTaskHandle = FFRTUtils::SubmitDelayTask(task, displayOffDelayMs_, queue_);
-        iterator->second->SetDelayOffState();
-        return true;
-    } else if (state == DisplayState::DISPLAY_ON) {
-        if (isDisplayDelayOff_) {
-            DISPLAY_HILOGI(COMP_SVC, "need remove delay task");
-            std::lock_guard<ffrt::mutex> lock(screenOffDelayTaskMutex_);
-            FFRTUtils::CancelTask(g_screenOffDelayTaskHandle, queue_);
-            isDisplayDelayOff_ = false;
-            iterator->second->SetOnState();
+    FollowMainDisplayOffDelay(id);
+    if (DisplayStateMachine::IsDeferrable(state)) {
+        auto onExpired = [this](uint32_t displayId, DisplayState displayState, uint32_t displayReason) {
+            ScreenOffDelay(displayId, displayState, displayReason);
+        };
+        if (offDelayScheduler_.Schedule(id, state, reason, onExpired)) {
+            controller->SetDelayOffState();
             return true;
         }
     }
-    return iterator->second->UpdateState(state, reason);
+    if (state == DisplayState::DISPLAY_ON && offDelayScheduler_.CancelForOn(id)) {
+        DISPLAY_HILOGI(COMP_SVC, "remove delay task of display %{public}u", id);
+        controller->SetOnState();
+        return true;
+    }
+    bool ret = controller->UpdateState(state, reason);
+    if (!ret && (state == DisplayState::DISPLAY_OFF || state == DisplayState::DISPLAY_DOZE)) {
+        UndoSetDisplayStateInner(id, controller->GetState(), reason);
+    }
+    return ret;
+}
+
+void DisplayPowerMgrService::FollowMainDisplayOffDelay(uint32_t id)
+{
+    uint32_t armedId = offDelayMainDisplayId_.load();
+    // Most state changes find nothing armed, the main display id is only queried when there is an arm to move
+    if (id == armedId || !offDelayScheduler_.IsArmed(armedId) || id != GetMainDisplayIdInner()) {
+        return;
+    }
+    if (offDelayScheduler_.MoveArm(armedId, id)) {
+        DISPLAY_HILOGI(COMP_SVC, "display off delay follows the main display %{public}u -> %{public}u", armedId, id);
+        offDelayMainDisplayId_.store(id);
+    }
 }
 
 void DisplayPowerMgrService::UndoSetDisplayStateInner(uint32_t id, DisplayState curState, uint32_t reason)
@@ -314,32 +459,32 @@ void DisplayPowerMgrService::UndoSetDisplayStateInner(uint32_t id, DisplayState
     DISPLAY_HILOGI(COMP_SVC, "[UL_POWER]undo brightness SetDisplayState:%{public}u", curState);
     BrightnessManager::Get().SetDisplayState(id, curState, reason);
     if (curState == DisplayState::DISPLAY_ON || curState == DisplayState::DISPLAY_DIM) {
-        BrightnessManager::Get().SetScreenOnBrightness();
+        BrightnessManager::Get().SetDisplayScreenOnBrightness(id);
     }
 }
 
 DisplayState DisplayPowerMgrService::GetDisplayStateInner(uint32_t id)
 {
     DISPLAY_HILOGD(COMP_SVC, "GetDisplayState %{public}d", id);
-    auto iterator = controllerMap_.find(id);
-    if (iterator == controllerMap_.end()) {
+    auto controller = controllers_.Find(id);
+    if (controller == nullptr) {
         if (id != DEFALUT_DISPLAY_ID) {
             return DisplayState::DISPLAY_UNKNOWN;
         }
         id = GetMainDisplayIdInner();
-        iterator = controllerMap_.find(id);
-        if (iterator == controllerMap_.end()) {
+        controller = controllers_.Find(id);
+        if (controller == nullptr) {
             return DisplayState::DISPLAY_UNKNOWN;
         }
     }
-    return iterator->second->GetState();
+    return controller->GetState();
 }
 
 std::vector<uint32_t> DisplayPowerMgrService::GetDisplayIdsInner()
 {
     std::vector<uint32_t> ids;
-    for (auto& iter: controllerMap_) {
-        ids.push_back(iter.first);
+    for (auto id : controllers_.GetIds()) {
+        ids.push_back(static_cast<uint32_t>(id));
     }
     return ids;
 }
@@ -354,121 +499,229 @@ uint32_t DisplayPowerMgrService::GetMainDisplayIdInner()
 bool DisplayPowerMgrService::SetBrightnessInner(uint32_t value, uint32_t displayId, bool continuous)
 {
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
 
     auto brightness = GetSafeBrightness(value);
+    if (continuous) {
+        return SetContinuousBrightness(brightness, displayId);
+    }
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "SetBrightness displayId=%{public}u, value=%{public}u, continuous=%{public}d",
         displayId, brightness, continuous);
-    return BrightnessManager::Get().SetBrightness(brightness, 0, continuous);
+    std::lock_guard batchLock(brightnessBatchMutex_);
+    return SetBrightnessInternal(brightness, displayId);
+}
+
+// The *Internal helpers below skip the permission check and logging of their *Inner caller,
+// ExecuteBrightnessCommands checks the caller once for the whole batch
+bool DisplayPowerMgrService::SetBrightnessInternal(uint32_t brightness, uint32_t displayId)
+{
+    // Called with brightnessBatchMutex_ held. A continuous value still pending for the display is older than
+    // this one, it is dropped under the apply lock so that it can not be applied after this value.
+    std::lock_guard applyLock(continuousBrightnessApplyMutex_);
+    {
+        std::lock_guard lock(continuousBrightnessMutex_);
+        pendingContinuousBrightness_.erase(displayId);
+    }
+    return BrightnessManager::Get().SetDisplayBrightness(displayId, brightness, 0, false);
+}
+
+// A coalesced value returns true once queued, it is applied when the interval ends unless a newer one replaces it
+bool DisplayPowerMgrService::SetContinuousBrightness(uint32_t brightness, uint32_t displayId)
+{
+    {
+        std::lock_guard lock(continuousBrightnessMutex_);
+        auto [iter, isInserted] = pendingContinuousBrightness_.insert_or_assign(displayId, brightness);
+        if (isContinuousBrightnessScheduled_) {
+            if (!isInserted) {
+                continuousBrightnessDropped_++;
+            }
+            return true;
+        }
+        // The first value of a drag is applied at once and opens an interval for the following ones
+        isContinuousBrightnessScheduled_ = ScheduleContinuousBrightnessDrain();
+    }
+    // Same locks as every other brightness write. The value waits in the pending map until they are held, so a
+    // non-continuous SetBrightness or a batch that got them first drops it instead of being overtaken by it.
+    std::lock_guard batchLock(brightnessBatchMutex_);
+    std::lock_guard applyLock(continuousBrightnessApplyMutex_);
+    {
+        std::lock_guard lock(continuousBrightnessMutex_);
+        auto iter = pendingContinuousBrightness_.find(displayId);
+        if (iter == pendingContinuousBrightness_.end()) {
+            return true;
+        }
+        // A newer value of the same drag may have replaced it meanwhile, the latest one is applied
+        brightness = iter->second;
+        pendingContinuousBrightness_.erase(iter);
+    }
+    DISPLAY_HILOGD(FEAT_BRIGHTNESS, "SetBrightness displayId=%{public}u, value=%{public}u, continuous=1",
+        displayId, brightness);
+    continuousBrightnessApplied_++;
+    return BrightnessManager::Get().SetDisplayBrightness(displayId, brightness, 0, true);
+}
+
+bool DisplayPowerMgrService::ScheduleContinuousBrightnessDrain()
+{
+    if (queue_ == nullptr) {
+        return false;
+    }
+    FFRTTask task = [this]() { DrainContinuousBrightness(); };
+    FFRTUtils::SubmitDelayTask(task, CONTINUOUS_BRIGHTNESS_INTERVAL_MS, queue_);
+    return true;
+}
+
+void DisplayPowerMgrService::DrainContinuousBrightness()
+{
+    std::lock_guard batchLock(brightnessBatchMutex_);
+    std::lock_guard applyLock(continuousBrightnessApplyMutex_);
+    std::map<uint32_t, uint32_t> pending;
+    {
+        std::lock_guard lock(continuousBrightnessMutex_);
+        pending.swap(pendingContinuousBrightness_);
+        // Keep the interval open while the drag goes on, close it after an idle one
+        isContinuousBrightnessScheduled_ = !pending.empty() && ScheduleContinuousBrightnessDrain();
+    }
+    for (const auto& [displayId, brightness] : pending) {
+        DISPLAY_HILOGD(FEAT_BRIGHTNESS, "SetBrightness displayId=%{public}u, value=%{public}u, coalesced",
+            displayId, brightness);
+        continuousBrightnessApplied_++;
+        BrightnessManager::Get().SetDisplayBrightness(displayId, brightness, 0, true);
+    }
 }
 
 bool DisplayPowerMgrService::DiscountBrightnessInner(double discount, uint32_t displayId)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
+    return DiscountBrightnessInternal(discount, displayId);
+}
+
+bool DisplayPowerMgrService::DiscountBrightnessInternal(double discount, uint32_t displayId)
+{
     CHECK_PARAM_WITH_RET(discount, 0.0, 1.0, false);
-    auto iter = controllerMap_.find(displayId);
-    if (iter == controllerMap_.end()) {
+    auto controller = controllers_.Find(displayId);
+    if (controller == nullptr) {
         return false;
     }
-    return BrightnessManager::Get().DiscountBrightness(discount);
+    return BrightnessManager::Get().DiscountDisplayBrightness(displayId, discount);
 }
 
 bool DisplayPowerMgrService::OverrideBrightnessInner(uint32_t brightness, uint32_t displayId, uint32_t duration)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     DISPLAY_HILOGI(COMP_SVC, "OverrideBrightness displayId=%{public}u, value=%{public}u, duration=%{public}d",
         displayId, brightness, duration);
+    return OverrideBrightnessInternal(brightness, displayId, duration);
+}
+
+bool DisplayPowerMgrService::OverrideBrightnessInternal(uint32_t brightness, uint32_t displayId, uint32_t duration)
+{
     CHECK_PARAM_DURATION_WITH_RET(duration, false);
-    auto iter = controllerMap_.find(displayId);
-    if (iter == controllerMap_.end()) {
+    auto controller = controllers_.Find(displayId);
+    if (controller == nullptr) {
         return false;
     }
-    return BrightnessManager::Get().OverrideBrightness(brightness, duration);
+    return BrightnessManager::Get().OverrideDisplayBrightness(displayId, brightness, duration);
 }
 
 bool DisplayPowerMgrService::OverrideDisplayOffDelayInner(uint32_t delayMs)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
-    if (GetDisplayStateInner(GetMainDisplayIdInner()) != DisplayState::DISPLAY_ON || delayMs == DELAY_TIME_UNSET) {
-        isDisplayDelayOff_ = false;
-        return isDisplayDelayOff_;
+    uint32_t mainDisplayId = GetMainDisplayIdInner();
+    if (GetDisplayStateInner(mainDisplayId) != DisplayState::DISPLAY_ON || delayMs == DELAY_TIME_UNSET) {
+        offDelayScheduler_.Disarm(offDelayMainDisplayId_.load());
+        offDelayScheduler_.Disarm(mainDisplayId);
+        return false;
     }
-    DISPLAY_HILOGI(COMP_SVC, "OverrideDisplayOffDelay delayMs=%{public}u", delayMs);
-    isDisplayDelayOff_ = true;
-    displayOffDelayMs_ = delayMs;
-
-    return isDisplayDelayOff_;
+    DISPLAY_HILOGI(COMP_SVC, "OverrideDisplayOffDelay displayId=%{public}u, delayMs=%{public}u",
+        mainDisplayId, delayMs);
+    // An arm left on the previous main display would otherwise outlive the fold that replaced it
+    uint32_t previousId = offDelayMainDisplayId_.exchange(mainDisplayId);
+    if (previousId != mainDisplayId) {
+        offDelayScheduler_.Disarm(previousId);
+    }
+    offDelayScheduler_.Arm(mainDisplayId, delayMs);
+    return true;
 }
 
 bool DisplayPowerMgrService::RestoreBrightnessInner(uint32_t displayId, uint32_t duration)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     DISPLAY_HILOGI(COMP_SVC, "RestoreBrightness displayId=%{public}u, duration=%{public}d",
         displayId, duration);
+    return RestoreBrightnessInternal(displayId, duration);
+}
+
+bool DisplayPowerMgrService::RestoreBrightnessInternal(uint32_t displayId, uint32_t duration)
+{
     CHECK_PARAM_DURATION_WITH_RET(duration, false);
-    auto iter = controllerMap_.find(displayId);
-    if (iter == controllerMap_.end()) {
+    auto controller = controllers_.Find(displayId);
+    if (controller == nullptr) {
         return false;
     }
-    bool ret = BrightnessManager::Get().RestoreBrightness(duration);
+    bool ret = BrightnessManager::Get().RestoreDisplayBrightness(displayId, duration);
     if (ret) {
         return true;
     }
-    return iter->second->RestoreBrightness();
+    return controller->RestoreBrightness();
 }
 
 uint32_t DisplayPowerMgrService::GetBrightnessInner(uint32_t displayId)
 {
     DISPLAY_HILOGD(FEAT_BRIGHTNESS, "GetBrightness displayId=%{public}u", displayId);
-    auto iter = controllerMap_.find(displayId);
-    if (iter == controllerMap_.end()) {
+    auto controller = controllers_.Find(displayId);
+    if (controller == nullptr) {
         return BRIGHTNESS_OFF;
     }
-    return BrightnessManager::Get().GetBrightness();
+    return BrightnessManager::Get().GetDisplayBrightness(displayId);
 }
 
 uint32_t DisplayPowerMgrService::GetDefaultBrightnessInner()
 {
-    return BRIGHTNESS_DEFAULT;
+    return DisplayParamHelper::GetDefaultBrightness();
 }
 
 uint32_t DisplayPowerMgrService::GetMaxBrightnessInner()
 {
-    return BRIGHTNESS_MAX;
+    return DisplayParamHelper::GetMaxBrightness();
 }
 
 uint32_t DisplayPowerMgrService::GetMinBrightnessInner()
 {
-    return BRIGHTNESS_MIN;
+    return DisplayParamHelper::GetMinBrightness();
 }
 
 bool DisplayPowerMgrService::AdjustBrightnessInner(uint32_t id, int32_t value, uint32_t duration)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     DISPLAY_HILOGI(FEAT_BRIGHTNESS, "AdjustBrightness %{public}d, %{public}d, %{public}d",
                    id, value, duration);
     CHECK_PARAM_DURATION_WITH_RET(duration, false);
-    auto iterator = controllerMap_.find(id);
-    if (iterator == controllerMap_.end()) {
+    auto controller = controllers_.Find(id);
+    if (controller == nullptr) {
         return false;
     }
     bool ret = BrightnessManager::Get().SetBrightness(value, duration);
     if (ret) {
         return true;
     }
-    return iterator->second->SetBrightness(value, duration);
+    return controller->SetBrightness(value, duration);
 }
 
 bool DisplayPowerMgrService::IsSupportLightSensor()
@@ -484,6 +737,7 @@ bool DisplayPowerMgrService::IsAutoAdjustBrightnessInner()
 bool DisplayPowerMgrService::AutoAdjustBrightnessInner(bool enable, bool updateSetting)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     // Use mutex to synchronize BrightnessManager::AutoAdjustBrightness + autoBrightnessQueue_ operations,
@@ -491,6 +745,9 @@ bool DisplayPowerMgrService::AutoAdjustBrightnessInner(bool enable, bool updateS
     std::lock_guard lock(autoBrightnessMutex_);
     DISPLAY_HILOGD(FEAT_BRIGHTNESS, "AutoAdjustBrightness start, enable: %{public}d", enable);
     auto ret = BrightnessManager::Get().AutoAdjustBrightness(enable);
+    if (ret) {
+        PublishPowerSnapshot();
+    }
     if (!ret || !updateSetting) {
         return ret;
     }
@@ -510,80 +767,202 @@ bool DisplayPowerMgrService::AutoAdjustBrightnessInner(bool enable, bool updateS
 bool DisplayPowerMgrService::RegisterCallbackInner(sptr<IDisplayPowerCallback> callback)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
-    std::lock_guard lock(mutex_);
-    DISPLAY_HILOGI(COMP_SVC, "RegisterCallback");
-    if (callback_ != nullptr) {
-        DISPLAY_HILOGI(COMP_SVC, "Callback function exist");
+    if (callback == nullptr || callback->AsObject() == nullptr) {
+        DISPLAY_HILOGE(COMP_SVC, "RegisterCallback callback is nullptr");
         return false;
     }
-    callback_ = callback;
-    sptr<IRemoteObject> remote = callback_->AsObject();
+    sptr<IRemoteObject> remote = callback->AsObject();
     if (!remote->IsProxyObject()) {
         DISPLAY_HILOGE(COMP_FWK, "Callback is not proxy");
         return false;
     }
+    int32_t pid = IPCSkeleton::GetCallingPid();
+    int32_t uid = IPCSkeleton::GetCallingUid();
+    std::lock_guard lock(mutex_);
+    if (stateCallbacks_.count(remote) != 0) {
+        DISPLAY_HILOGI(COMP_SVC, "Callback function exist, pid=%{public}d", pid);
+        return false;
+    }
+    if (stateCallbacks_.size() >= MAX_STATE_CALLBACKS) {
+        DISPLAY_HILOGE(COMP_SVC, "Too many callbacks, reject pid=%{public}d", pid);
+        return false;
+    }
     if (cbDeathRecipient_ == nullptr) {
         cbDeathRecipient_ = new CallbackDeathRecipient();
     }
     remote->AddDeathRecipient(cbDeathRecipient_);
+    std::string label = "DisplayPowerCallback Pid=" + std::to_string(pid) + " Uid=" + std::to_string(uid);
+    auto deliver = [callback](const DisplayStateChange& change) {
+        callback->OnDisplayStateChanged(change.displayId, change.state, change.reason);
+    };
+    auto key = [](const DisplayStateChange& change) { return static_cast<uint64_t>(change.displayId); };
+    auto onQuarantine = [weakRemote = wptr<IRemoteObject>(remote)] {
+        auto pms = DelayedSpSingleton<DisplayPowerMgrService>::GetInstance();
+        auto object = weakRemote.promote();
+        if (pms != nullptr && object != nullptr) {
+            pms->RemoveQuarantinedCallback(object);
+        }
+    };
+    stateCallbacks_.emplace(remote, std::make_shared<DisplayStateMailbox>(std::move(label), std::move(deliver),
+        std::move(key), stateCallbackTracker_, std::move(onQuarantine), stateCallbackPolicy_));
+    DISPLAY_HILOGI(COMP_SVC, "RegisterCallback pid=%{public}d, total=%{public}zu", pid, stateCallbacks_.size());
     return true;
 }
 
 bool DisplayPowerMgrService::BoostBrightnessInner(int32_t timeoutMs, uint32_t displayId)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Timing boost brightness: %{public}d, id: %{public}d", timeoutMs, displayId);
+    return BoostBrightnessInternal(timeoutMs, displayId);
+}
+
+bool DisplayPowerMgrService::BoostBrightnessInternal(int32_t timeoutMs, uint32_t displayId)
+{
     RETURN_IF_WITH_RET(timeoutMs <= 0, false);
-    auto iter = controllerMap_.find(displayId);
-    RETURN_IF_WITH_RET(iter == controllerMap_.end(), false);
-    return BrightnessManager::Get().BoostBrightness(timeoutMs);
+    auto controller = controllers_.Find(displayId);
+    RETURN_IF_WITH_RET(controller == nullptr, false);
+    return BrightnessManager::Get().BoostDisplayBrightness(displayId, timeoutMs);
 }
 
 bool DisplayPowerMgrService::CancelBoostBrightnessInner(uint32_t displayId)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     DISPLAY_HILOGD(FEAT_BRIGHTNESS, "Cancel boost brightness, id: %{public}d", displayId);
-    auto iter = controllerMap_.find(displayId);
-    RETURN_IF_WITH_RET(iter == controllerMap_.end(), false);
-    bool ret = BrightnessManager::Get().CancelBoostBrightness();
+    return CancelBoostBrightnessInternal(displayId);
+}
+
+bool DisplayPowerMgrService::CancelBoostBrightnessInternal(uint32_t displayId)
+{
+    auto controller = controllers_.Find(displayId);
+    RETURN_IF_WITH_RET(controller == nullptr, false);
+    bool ret = BrightnessManager::Get().CancelBoostDisplayBrightness(displayId);
     if (ret) {
         return true;
     }
-    return iter->second->CancelBoostBrightness();
+    return controller->CancelBoostBrightness();
 }
 
 uint32_t DisplayPowerMgrService::GetDeviceBrightnessInner(uint32_t displayId, bool useHbm)
 {
     DISPLAY_HILOGD(FEAT_BRIGHTNESS, "GetDeviceBrightness displayId=%{public}u useHbm=%{public}d", displayId, useHbm);
-    auto iter = controllerMap_.find(displayId);
-    if (iter == controllerMap_.end()) {
+    auto controller = controllers_.Find(displayId);
+    if (controller == nullptr) {
         return BRIGHTNESS_OFF;
     }
-    return BrightnessManager::Get().GetDeviceBrightness(useHbm);
+    return BrightnessManager::Get().GetDisplayDeviceBrightness(displayId, useHbm);
 }
 
 bool DisplayPowerMgrService::SetCoordinatedInner(bool coordinated, uint32_t displayId)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return false;
     }
     DISPLAY_HILOGD(FEAT_STATE, "Set coordinated=%{public}d, displayId=%{public}u", coordinated, displayId);
-    auto iter = controllerMap_.find(displayId);
-    RETURN_IF_WITH_RET(iter == controllerMap_.end(), false);
-    iter->second->SetCoordinated(coordinated);
+    return SetCoordinatedInternal(coordinated, displayId);
+}
+
+bool DisplayPowerMgrService::SetCoordinatedInternal(bool coordinated, uint32_t displayId)
+{
+    auto controller = controllers_.Find(displayId);
+    RETURN_IF_WITH_RET(controller == nullptr, false);
+    controller->SetCoordinated(coordinated);
     return true;
 }
 
+std::vector<BrightnessCommandResult> DisplayPowerMgrService::ExecuteBrightnessCommandsInner(
+    const std::vector<BrightnessCommand>& commands)
+{
+    // The caller was checked once by ExecuteBrightnessCommands, a non-system caller gets no command executed
+    std::vector<BrightnessCommandResult> results;
+    results.reserve(commands.size());
+    DISPLAY_HILOGI(FEAT_BRIGHTNESS, "ExecuteBrightnessCommands, size=%{public}zu", commands.size());
+    // Writes of the whole batch reach the panel once, with the state left by the last command
+    std::lock_guard lock(brightnessBatchMutex_);
+    BrightnessManager::Get().BeginBrightnessBatch();
+    for (const auto& command : commands) {
+        results.push_back(ExecuteBrightnessCommand(command));
+    }
+    if (!BrightnessManager::Get().EndBrightnessBatch()) {
+        DISPLAY_HILOGW(FEAT_BRIGHTNESS, "ExecuteBrightnessCommands, apply brightness failed");
+        for (size_t i = 0; i < commands.size(); i++) {
+            if (commands[i].type < BrightnessCommandType::GET_BRIGHTNESS) {
+                results[i].result = false;
+            }
+        }
+    }
+    return results;
+}
+
+BrightnessCommandResult DisplayPowerMgrService::ExecuteBrightnessCommand(const BrightnessCommand& command)
+{
+    BrightnessCommandResult result {static_cast<int32_t>(DisplayErrors::ERR_OK), true, 0};
+    uint32_t id = command.displayId;
+    if (command.value < 0.0 || command.value > static_cast<double>(UINT32_MAX)) {
+        result.retCode = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        result.result = false;
+        return result;
+    }
+    uint32_t value = static_cast<uint32_t>(command.value);
+    switch (command.type) {
+        case BrightnessCommandType::SET_BRIGHTNESS:
+            result.result = SetBrightnessInternal(GetSafeBrightness(value), id);
+            break;
+        case BrightnessCommandType::DISCOUNT_BRIGHTNESS:
+            result.result = DiscountBrightnessInternal(command.value, id);
+            break;
+        case BrightnessCommandType::OVERRIDE_BRIGHTNESS:
+            result.result = OverrideBrightnessInternal(value, id, command.duration);
+            break;
+        case BrightnessCommandType::RESTORE_BRIGHTNESS:
+            result.result = RestoreBrightnessInternal(id, command.duration);
+            break;
+        case BrightnessCommandType::BOOST_BRIGHTNESS:
+            result.result = value <= INT32_MAX && BoostBrightnessInternal(static_cast<int32_t>(value), id);
+            break;
+        case BrightnessCommandType::CANCEL_BOOST_BRIGHTNESS:
+            result.result = CancelBoostBrightnessInternal(id);
+            break;
+        case BrightnessCommandType::SET_COORDINATED:
+            result.result = SetCoordinatedInternal(value != 0, id);
+            break;
+        case BrightnessCommandType::GET_BRIGHTNESS:
+            result.value = GetBrightnessInner(id);
+            break;
+        case BrightnessCommandType::GET_DEVICE_BRIGHTNESS:
+            result.value = GetDeviceBrightnessInner(id, value != 0);
+            break;
+        case BrightnessCommandType::GET_MAX_BRIGHTNESS:
+            result.value = GetMaxBrightnessInner();
+            break;
+        case BrightnessCommandType::GET_MIN_BRIGHTNESS:
+            result.value = GetMinBrightnessInner();
+            break;
+        case BrightnessCommandType::GET_DEFAULT_BRIGHTNESS:
+            result.value = GetDefaultBrightnessInner();
+            break;
+        default:
+            result.retCode = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+            result.result = false;
+            break;
+    }
+    return result;
+}
+
 uint32_t DisplayPowerMgrService::SetLightBrightnessThresholdInner(
     std::vector<int32_t> threshold, sptr<IDisplayBrightnessCallback> callback)
 {
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_PERMISSION_DENIED);
         return static_cast<uint32_t>(ERR_PERMISSION_DENIED);
     }
     return BrightnessManager::Get().SetLightBrightnessThreshold(threshold, callback);
@@ -591,9 +970,12 @@ uint32_t DisplayPowerMgrService::SetLightBrightnessThresholdInner(
 
 void DisplayPowerMgrService::NotifyStateChangeCallback(uint32_t displayId, DisplayState state, uint32_t reason)
 {
+    PublishPowerSnapshot();
+    // Each subscriber is called oneway on its own FFRT task, so that a slow one does not hold up the state change
+    // and one that keeps missing the deadline is dropped
     std::lock_guard lock(mutex_);
-    if (callback_ != nullptr) {
-        callback_->OnDisplayStateChanged(displayId, state, reason);
+    for (const auto& [remote, mailbox] : stateCallbacks_) {
+        mailbox->Post({displayId, state, reason});
     }
 }
 
@@ -614,32 +996,18 @@ DisplayErrors DisplayPowerMgrService::SetMultiScreenDisplayStateInner(uint64_t s
             "SetMultiScreenDisplayStateInner failed, The caller does not have the permission");
         return DisplayErrors::ERR_PERMISSION_DENIED;
     }
-    if (state != DisplayState::DISPLAY_ON && state != DisplayState::DISPLAY_OFF) {
-        DISPLAY_HILOGE(COMP_SVC, "invalid state=%{public}u for multi-screen, only ON/OFF supported",
-            static_cast<uint32_t>(state));
-        return DisplayErrors::ERR_PARAM_INVALID;
-    }
-    if (screenName.length() > MAX_SCREEN_NAME_LENGTH) {
-        DISPLAY_HILOGE(COMP_SVC, "invalid screenName length=%{public}zu, max=%{public}u",
-            screenName.length(), MAX_SCREEN_NAME_LENGTH);
-        return DisplayErrors::ERR_PARAM_INVALID;
-    }
-    std::shared_ptr<ScreenController> controller;
-    {
-        std::lock_guard<ffrt::mutex> lock(controllerMapMutex_);
-        auto it = controllerMap_.find(screenId);
-        if (it == controllerMap_.end()) {
-            DISPLAY_HILOGI(COMP_SVC, "screenId=%{public}" PRIu64 " not in map, creating dynamically", screenId);
-            it = controllerMap_.emplace(screenId,
-                std::make_shared<ScreenController>(static_cast<uint32_t>(screenId))).first;
-        }
-        controller = it->second;
+    DisplayErrors err = CheckMultiScreenState(screenName, state);
+    if (err != DisplayErrors::ERR_OK) {
+        return err;
     }
+    auto controller = GetMultiScreenController(screenId);
     std::lock_guard<ffrt::mutex> lock(controller->GetScreenLock());
     if (controller->GetState() == state) {
         DISPLAY_HILOGI(COMP_SVC, "same state=%{public}u, skip", static_cast<uint32_t>(state));
         return DisplayErrors::ERR_OK;
     }
+    // Screens driven through the multi-screen interface dim and brighten independently of the main one
+    BrightnessManager::Get().AddDisplayPipeline(static_cast<uint32_t>(screenId));
     BrightnessManager::Get().SetDisplayState(static_cast<uint32_t>(screenId), state, reason);
     bool ret = controller->UpdateMultiScreenState(state, reason, screenName);
     if (!ret) {
@@ -650,6 +1018,112 @@ DisplayErrors DisplayPowerMgrService::SetMultiScreenDisplayStateInner(uint64_t s
     return DisplayErrors::ERR_OK;
 }
 
+DisplayErrors DisplayPowerMgrService::SetMultiScreenDisplayStatesInner(
+    const std::vector<MultiScreenStateRequest>& requests, std::vector<MultiScreenStateResult>& results)
+{
+    DISPLAY_HILOGI(COMP_SVC, "[UL_POWER_IVI] SetMultiScreenDisplayStatesInner count=%{public}zu", requests.size());
+    if (!Permission::IsSystem()) {
+        DISPLAY_HILOGI(COMP_SVC, "SetMultiScreenDisplayStatesInner failed, System permission intercept");
+        return DisplayErrors::ERR_SYSTEM_API_DENIED;
+    }
+    if (!Permission::IsNativePermissionGranted("ohos.permission.MULTI_SCREEN_MANAGER")) {
+        DISPLAY_HILOGI(COMP_SVC,
+            "SetMultiScreenDisplayStatesInner failed, The caller does not have the permission");
+        return DisplayErrors::ERR_PERMISSION_DENIED;
+    }
+    if (requests.empty() || requests.size() > MAX_MULTI_SCREEN_REQUESTS) {
+        DISPLAY_HILOGE(COMP_SVC, "SetMultiScreenDisplayStatesInner, invalid size=%{public}zu", requests.size());
+        return DisplayErrors::ERR_PARAM_INVALID;
+    }
+    struct Transition {
+        size_t index {0};
+        std::shared_ptr<ScreenController> controller;
+        bool isPowered {false};
+    };
+    std::vector<Transition> transitions;
+    std::set<uint64_t> screenIds;
+    results.clear();
+    for (size_t i = 0; i < requests.size(); i++) {
+        const auto& request = requests[i];
+        DisplayErrors err = CheckMultiScreenState(request.screenName, static_cast<DisplayState>(request.state));
+        if (err == DisplayErrors::ERR_OK && !screenIds.insert(request.screenId).second) {
+            DISPLAY_HILOGE(COMP_SVC, "duplicate screenId=%{public}" PRIu64, request.screenId);
+            err = DisplayErrors::ERR_PARAM_INVALID;
+        }
+        results.push_back({request.screenId, static_cast<int32_t>(err)});
+        if (err == DisplayErrors::ERR_OK) {
+            transitions.push_back({i, GetMultiScreenController(request.screenId)});
+        }
+    }
+    // Screen locks are taken in ascending screen id order, so that batches sharing screens cannot deadlock
+    std::sort(transitions.begin(), transitions.end(), [&requests](const Transition& lhs, const Transition& rhs) {
+        return requests[lhs.index].screenId < requests[rhs.index].screenId;
+    });
+    std::vector<std::unique_lock<ffrt::mutex>> locks;
+    for (auto iter = transitions.begin(); iter != transitions.end();) {
+        locks.emplace_back(iter->controller->GetScreenLock());
+        if (iter->controller->GetState() == static_cast<DisplayState>(requests[iter->index].state)) {
+            DISPLAY_HILOGI(COMP_SVC, "same state, skip screenId=%{public}" PRIu64, requests[iter->index].screenId);
+            iter = transitions.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    for (const auto& transition : transitions) {
+        const auto& request = requests[transition.index];
+        BrightnessManager::Get().AddDisplayPipeline(static_cast<uint32_t>(request.screenId));
+        BrightnessManager::Get().SetDisplayState(static_cast<uint32_t>(request.screenId),
+            static_cast<DisplayState>(request.state), request.reason);
+    }
+    // The display manager IPCs of a screen stay in order, those of different screens overlap
+    RunInParallel(transitions.size(), MAX_MULTI_SCREEN_PARALLEL, [&transitions, &requests](size_t i) {
+        const auto& request = requests[transitions[i].index];
+        transitions[i].isPowered = transitions[i].controller->ApplyMultiScreenPower(
+            static_cast<DisplayState>(request.state), request.reason);
+    });
+    for (const auto& transition : transitions) {
+        const auto& request = requests[transition.index];
+        if (transition.isPowered && transition.controller->CommitMultiScreenState(
+            static_cast<DisplayState>(request.state), request.reason, request.screenName)) {
+            continue;
+        }
+        DISPLAY_HILOGE(COMP_SVC, "[UL_POWER_IVI] undo brightness, screenId=%{public}" PRIu64, request.screenId);
+        UndoSetDisplayStateInner(static_cast<uint32_t>(request.screenId), transition.controller->GetState(),
+            request.reason);
+        results[transition.index].retCode = static_cast<int32_t>(DisplayErrors::ERR_STATE_CHANGE_FAILED);
+    }
+    return DisplayErrors::ERR_OK;
+}
+
+DisplayErrors DisplayPowerMgrService::CheckMultiScreenState(const std::string& screenName, DisplayState state)
+{
+    if (state != DisplayState::DISPLAY_ON && state != DisplayState::DISPLAY_OFF) {
+        DISPLAY_HILOGE(COMP_SVC, "invalid state=%{public}u for multi-screen, only ON/OFF supported",
+            static_cast<uint32_t>(state));
+        return DisplayErrors::ERR_PARAM_INVALID;
+    }
+    if (screenName.length() > MAX_SCREEN_NAME_LENGTH) {
+        DISPLAY_HILOGE(COMP_SVC, "invalid screenName length=%{public}zu, max=%{public}u",
+            screenName.length(), MAX_SCREEN_NAME_LENGTH);
+        return DisplayErrors::ERR_PARAM_INVALID;
+    }
+    return DisplayErrors::ERR_OK;
+}
+
+void DisplayPowerMgrService::ScreenDisconnectListener::OnDisconnect(Rosen::ScreenId screenId)
+{
+    DISPLAY_HILOGI(COMP_SVC, "screen disconnected, screenId=%{public}" PRIu64, static_cast<uint64_t>(screenId));
+    BrightnessManager::Get().RemoveDisplayPipeline(static_cast<uint32_t>(screenId));
+}
+
+std::shared_ptr<ScreenController> DisplayPowerMgrService::GetMultiScreenController(uint64_t screenId)
+{
+    return controllers_.FindOrEmplace(screenId, [screenId]() {
+        DISPLAY_HILOGI(COMP_SVC, "screenId=%{public}" PRIu64 " not in map, creating dynamically", screenId);
+        return std::make_shared<ScreenController>(static_cast<uint32_t>(screenId));
+    });
+}
+
 DisplayErrors DisplayPowerMgrService::GetMultiScreenDisplayStateInner(uint64_t screenId, DisplayState& state)
 {
     DISPLAY_HILOGI(COMP_SVC, "GetMultiScreenDisplayStateInner screenId=%{public}" PRIu64, screenId);
@@ -664,17 +1138,10 @@ DisplayErrors DisplayPowerMgrService::GetMultiScreenDisplayStateInner(uint64_t s
         state = DisplayState::DISPLAY_UNKNOWN;
         return DisplayErrors::ERR_PERMISSION_DENIED;
     }
-    std::shared_ptr<ScreenController> controller;
-    {
-        std::lock_guard<ffrt::mutex> lock(controllerMapMutex_);
-        auto it = controllerMap_.find(screenId);
-        if (it == controllerMap_.end()) {
-            DISPLAY_HILOGI(COMP_SVC, "screenId=%{public}" PRIu64 " not in map, creating dynamically", screenId);
-            it = controllerMap_.emplace(screenId,
-                std::make_shared<ScreenController>(static_cast<uint32_t>(screenId))).first;
-        }
-        controller = it->second;
-    }
+    auto controller = controllers_.FindOrEmplace(screenId, [screenId]() {
+        DISPLAY_HILOGI(COMP_SVC, "screenId=%{public}" PRIu64 " not in map, creating dynamically", screenId);
+        return std::make_shared<ScreenController>(static_cast<uint32_t>(screenId));
+    });
     std::lock_guard<ffrt::mutex> lock(controller->GetScreenLock());
     state = controller->GetState();
     return DisplayErrors::ERR_OK;
@@ -739,7 +1206,7 @@ void DisplayPowerMgrService::NotifyMultiScreenStateChanged(uint64_t screenId, co
 
 void DisplayPowerMgrService::SetScreenOnBrightness(uint32_t displayId)
 {
-    BrightnessManager::Get().SetScreenOnBrightness(displayId);
+    BrightnessManager::Get().SetDisplayScreenOnBrightness(displayId);
 }
 #endif
 
@@ -747,10 +1214,12 @@ ErrCode DisplayPowerMgrService::SetMultiScreenDisplayState(uint64_t screenId, co
     uint32_t state, uint32_t reason, int32_t& retCode)
 {
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetMultiScreenDisplayState");
+    DisplayApiScope apiScope(DisplayApi::SET_MULTI_SCREEN_DISPLAY_STATE);
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
     DisplayErrors err = SetMultiScreenDisplayStateInner(screenId, screenName,
         static_cast<DisplayState>(state), reason);
     retCode = static_cast<int32_t>(err);
+    DisplayApiScope::ReportError(err);
 #else
     retCode = static_cast<int32_t>(DisplayErrors::ERR_OK);
 #endif
@@ -761,12 +1230,14 @@ ErrCode DisplayPowerMgrService::GetMultiScreenDisplayState(uint64_t screenId, in
     int32_t& retCode)
 {
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetMultiScreenDisplayState");
+    DisplayApiScope apiScope(DisplayApi::GET_MULTI_SCREEN_DISPLAY_STATE);
     displayState = static_cast<int32_t>(DisplayState::DISPLAY_UNKNOWN);
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
     DisplayState state = DisplayState::DISPLAY_UNKNOWN;
     DisplayErrors err = GetMultiScreenDisplayStateInner(screenId, state);
     displayState = static_cast<int32_t>(state);
     retCode = static_cast<int32_t>(err);
+    DisplayApiScope::ReportError(err);
 #else
     retCode = static_cast<int32_t>(DisplayErrors::ERR_OK);
 #endif
@@ -777,9 +1248,11 @@ ErrCode DisplayPowerMgrService::RegisterMultiScreenDisplayStateCallback(
     const sptr<IMultiScreenDisplayStateCallback>& callback, uint64_t screenId, int32_t& retCode)
 {
     DisplayXCollie displayXCollie("DisplayPowerMgrService::RegisterMultiScreenDisplayStateCallback");
+    DisplayApiScope apiScope(DisplayApi::REGISTER_MULTI_SCREEN_DISPLAY_STATE_CALLBACK);
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
     DisplayErrors err = RegisterMultiScreenDisplayStateCallbackInner(callback, screenId);
     retCode = static_cast<int32_t>(err);
+    DisplayApiScope::ReportError(err);
 #else
     retCode = static_cast<int32_t>(DisplayErrors::ERR_OK);
 #endif
@@ -790,9 +1263,26 @@ ErrCode DisplayPowerMgrService::UnregisterMultiScreenDisplayStateCallback(
     const sptr<IMultiScreenDisplayStateCallback>& callback, uint64_t screenId, int32_t& retCode)
 {
     DisplayXCollie displayXCollie("DisplayPowerMgrService::UnregisterMultiScreenDisplayStateCallback");
+    DisplayApiScope apiScope(DisplayApi::UNREGISTER_MULTI_SCREEN_DISPLAY_STATE_CALLBACK);
 #ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
     DisplayErrors err = UnregisterMultiScreenDisplayStateCallbackInner(callback, screenId);
     retCode = static_cast<int32_t>(err);
+    DisplayApiScope::ReportError(err);
+#else
+    retCode = static_cast<int32_t>(DisplayErrors::ERR_OK);
+#endif
+    return ERR_OK;
+}
+
+ErrCode DisplayPowerMgrService::SetMultiScreenDisplayStates(const std::vector<MultiScreenStateRequest>& requests,
+    std::vector<MultiScreenStateResult>& results, int32_t& retCode)
+{
+    DisplayXCollie displayXCollie("DisplayPowerMgrService::SetMultiScreenDisplayStates");
+    DisplayApiScope apiScope(DisplayApi::SET_MULTI_SCREEN_DISPLAY_STATES);
+#ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
+    DisplayErrors err = SetMultiScreenDisplayStatesInner(requests, results);
+    retCode = static_cast<int32_t>(err);
+    DisplayApiScope::ReportError(err);
 #else
     retCode = static_cast<int32_t>(DisplayErrors::ERR_OK);
 #endif
@@ -801,24 +1291,30 @@ ErrCode DisplayPowerMgrService::UnregisterMultiScreenDisplayStateCallback(
 
 void DisplayPowerMgrService::DumpDisplayInfo(std::string& result)
 {
-    for (auto& iter: controllerMap_) {
+    auto& brightnessManager = BrightnessManager::Get();
+    for (auto& iter: controllers_.GetAll()) {
         auto control = iter.second;
+        uint32_t id = static_cast<uint32_t>(iter.first);
         result.append("Display Id=").append(std::to_string(iter.first));
-        result.append(" State=").append(std::to_string(static_cast<uint32_t>(BrightnessManager::Get().GetState())));
-        result.append(" Discount=").append(std::to_string(BrightnessManager::Get().GetDiscount()));
-        result.append(" Brightness=").append(std::to_string(BrightnessManager::Get().GetBrightness()));
-        if (BrightnessManager::Get().IsBrightnessOverridden()) {
+        result.append(" State=").append(std::to_string(static_cast<uint32_t>(brightnessManager.GetDisplayState(id))));
+        result.append(" Discount=").append(std::to_string(brightnessManager.GetDisplayDiscount(id)));
+        result.append(" Brightness=").append(std::to_string(brightnessManager.GetDisplayBrightness(id)));
+        if (brightnessManager.IsDisplayBrightnessOverridden(id)) {
             result.append(" OverrideBrightness=")
-                .append(std::to_string(BrightnessManager::Get().GetScreenOnBrightness()));
+                .append(std::to_string(brightnessManager.GetDisplayScreenOnBrightness(id)));
         }
-        if (BrightnessManager::Get().IsBrightnessBoosted()) {
+        if (brightnessManager.IsDisplayBrightnessBoosted(id)) {
             result.append(" BoostBrightness=")
-                .append(std::to_string(BrightnessManager::Get().GetScreenOnBrightness()));
+                .append(std::to_string(brightnessManager.GetDisplayScreenOnBrightness(id)));
         }
         result.append("\n");
         result.append("DeviceBrightness=");
-        result.append(std::to_string(BrightnessManager::Get().GetDeviceBrightness())).append("\n");
+        result.append(std::to_string(brightnessManager.GetDisplayDeviceBrightness(id))).append("\n");
+        if (control != nullptr) {
+            control->DumpTransitions(result);
+        }
     }
+    offDelayScheduler_.Dump(result);
 }
 
 int32_t DisplayPowerMgrService::Dump(int32_t fd, const std::vector<std::u16string>& args)
@@ -829,6 +1325,19 @@ int32_t DisplayPowerMgrService::Dump(int32_t fd, const std::vector<std::u16strin
     if (!Permission::IsSystem()) {
         return ERR_PERMISSION_DENIED;
     }
+    bool isTraceBinary = std::find(args.begin(), args.end(), DUMP_TRACE_BINARY_ARG) != args.end();
+    if (isTraceBinary || std::find(args.begin(), args.end(), DUMP_TRACE_ARG) != args.end()) {
+        std::string trace;
+        if (isTraceBinary) {
+            DisplayTraceRecorder::Get().DumpBinary(trace);
+        } else {
+            DisplayTraceRecorder::Get().DumpText(trace);
+        }
+        if (!SaveStringToFd(fd, trace)) {
+            DISPLAY_HILOGE(COMP_SVC, "Failed to save display trace to fd");
+        }
+        return ERR_OK;
+    }
     std::string result("DISPLAY POWER MANAGER DUMP:\n");
     DumpDisplayInfo(result);
 #ifdef ENABLE_SENSOR_PART
@@ -845,6 +1354,21 @@ int32_t DisplayPowerMgrService::Dump(int32_t fd, const std::vector<std::u16strin
     result.append("Min=" + std::to_string(GetMinBrightnessInner()) + " ");
     result.append("Default=" + std::to_string(GetDefaultBrightnessInner())).append("\n");
 
+    result.append("Continuous Brightness: ").append("Applied=" + std::to_string(continuousBrightnessApplied_) + " ");
+    result.append("Dropped=" + std::to_string(continuousBrightnessDropped_)).append("\n");
+    AppendStateCallbacksDump(result);
+    BrightnessDataListenerRegistry::Get().Dump(result);
+    BrightnessThresholdMonitor::Get().Dump(result);
+    // The timeline itself is dumped with --trace as text or --trace-binary as DisplayTraceRecord
+    DisplayTraceRecorder::Get().AppendSummary(result);
+    // Reset with {"domain":"display_service","handler":"ResetApiMetrics"} through RunJsonCommand
+    DisplayApiMetrics::Get().Dump(result);
+#ifdef DISPLAY_MANAGER_ENABLE_MULTI_SCREEN_STATE
+    if (multiScreenCallbackMgr_ != nullptr) {
+        multiScreenCallbackMgr_->Dump(result);
+    }
+#endif
+
     if (!SaveStringToFd(fd, result)) {
         DISPLAY_HILOGE(COMP_SVC, "Failed to save dump info to fd");
     }
@@ -854,13 +1378,15 @@ int32_t DisplayPowerMgrService::Dump(int32_t fd, const std::vector<std::u16strin
 uint32_t DisplayPowerMgrService::GetSafeBrightness(uint32_t value)
 {
     auto brightnessValue = value;
-    if (brightnessValue > BRIGHTNESS_MAX) {
+    uint32_t brightnessMax = DisplayParamHelper::GetMaxBrightness();
+    uint32_t brightnessMin = DisplayParamHelper::GetMinBrightness();
+    if (brightnessValue > brightnessMax) {
         DISPLAY_HILOGD(FEAT_BRIGHTNESS, "brightness value is greater than max, value=%{public}u", value);
-        brightnessValue = BRIGHTNESS_MAX;
+        brightnessValue = brightnessMax;
     }
-    if (brightnessValue < BRIGHTNESS_MIN) {
+    if (brightnessValue < brightnessMin) {
         DISPLAY_HILOGD(FEAT_BRIGHTNESS, "brightness value is less than min, value=%{public}u", value);
-        brightnessValue = BRIGHTNESS_MIN;
+        brightnessValue = brightnessMin;
     }
     return brightnessValue;
 }
@@ -876,10 +1402,11 @@ double DisplayPowerMgrService::GetSafeDiscount(double discount, uint32_t brightn
         DISPLAY_HILOGD(COMP_SVC, "discount value is less than min, discount=%{public}lf", discount);
         safeDiscount = DISCOUNT_MIN;
     }
-    if (static_cast<uint32_t>(BRIGHTNESS_MIN / safeDiscount) > BRIGHTNESS_MAX) {
+    uint32_t brightnessMin = DisplayParamHelper::GetMinBrightness();
+    if (static_cast<uint32_t>(brightnessMin / safeDiscount) > DisplayParamHelper::GetMaxBrightness()) {
         DISPLAY_HILOGD(COMP_SVC, "brightness than max, brightness=%{public}u, discount=%{public}lf",
-                       static_cast<uint32_t>(BRIGHTNESS_MIN / safeDiscount), discount);
-        safeDiscount = static_cast<double>(BRIGHTNESS_MIN / static_cast<double>(brightness));
+                       static_cast<uint32_t>(brightnessMin / safeDiscount), discount);
+        safeDiscount = static_cast<double>(brightnessMin / static_cast<double>(brightness));
     }
 
     return safeDiscount;
@@ -895,7 +1422,55 @@ DisplayErrors DisplayPowerMgrService::GetError()
 void DisplayPowerMgrService::UnregisterCallbackInner()
 {
     std::lock_guard lock(mutex_);
-    callback_ = nullptr;
+    for (const auto& [remote, mailbox] : stateCallbacks_) {
+        if (cbDeathRecipient_ != nullptr) {
+            remote->RemoveDeathRecipient(cbDeathRecipient_);
+        }
+        mailbox->Close();
+    }
+    stateCallbacks_.clear();
+}
+
+bool DisplayPowerMgrService::UnregisterCallbackInner(const sptr<IRemoteObject>& remote)
+{
+    std::lock_guard lock(mutex_);
+    auto iter = stateCallbacks_.find(remote);
+    if (iter == stateCallbacks_.end()) {
+        return false;
+    }
+    if (cbDeathRecipient_ != nullptr) {
+        remote->RemoveDeathRecipient(cbDeathRecipient_);
+    }
+    // A delivery already running completes, the queued ones are discarded
+    iter->second->Close();
+    stateCallbacks_.erase(iter);
+    DISPLAY_HILOGI(COMP_SVC, "UnregisterCallback, remaining=%{public}zu", stateCallbacks_.size());
+    return true;
+}
+
+void DisplayPowerMgrService::RemoveQuarantinedCallback(const sptr<IRemoteObject>& remote)
+{
+    std::lock_guard lock(mutex_);
+    auto iter = stateCallbacks_.find(remote);
+    // The remote may have registered again since, with a fresh mailbox
+    if (iter == stateCallbacks_.end() || !iter->second->GetStats().isQuarantined) {
+        return;
+    }
+    if (cbDeathRecipient_ != nullptr) {
+        remote->RemoveDeathRecipient(cbDeathRecipient_);
+    }
+    DISPLAY_HILOGW(COMP_SVC, "Drop quarantined %{public}s", iter->second->GetLabel().c_str());
+    stateCallbacks_.erase(iter);
+}
+
+void DisplayPowerMgrService::AppendStateCallbacksDump(std::string& result)
+{
+    std::lock_guard lock(mutex_);
+    result.append("Display State Callbacks: ").append(std::to_string(stateCallbacks_.size())).append("\n");
+    for (const auto& [remote, mailbox] : stateCallbacks_) {
+        result.append("  ").append(mailbox->GetLabel());
+        AppendDeliveryStats(mailbox->GetStats(), result);
+    }
 }
 
 void DisplayPowerMgrService::CallbackDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& remote)
@@ -906,8 +1481,10 @@ void DisplayPowerMgrService::CallbackDeathRecipient::OnRemoteDied(const wptr<IRe
         DISPLAY_HILOGI(COMP_SVC, "OnRemoteDied no service");
         return;
     }
-
-    pms->UnregisterCallbackInner();
+    auto object = remote.promote();
+    if (object != nullptr) {
+        pms->UnregisterCallbackInner(object);
+    }
 }
 
 #ifdef ENABLE_SCREEN_POWER_OFF_STRATEGY
@@ -944,7 +1521,7 @@ void DisplayPowerMgrService::InvokerDeathRecipient::OnRemoteDied(const wptr<IRem
 bool DisplayPowerMgrService::SetMaxBrightnessInner(double value, uint32_t mode)
 {
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         DISPLAY_HILOGE(COMP_SVC, "SetMaxBrightness Permission Error!");
         return false;
     }
@@ -976,7 +1553,7 @@ bool DisplayPowerMgrService::SetMaxBrightnessInner(double value, uint32_t mode)
 bool DisplayPowerMgrService::SetMaxBrightnessNitInner(uint32_t maxNit, uint32_t mode)
 {
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         DISPLAY_HILOGE(COMP_SVC, "SetMaxBrightness Permission Error!");
         return false;
     }
@@ -1000,7 +1577,7 @@ bool DisplayPowerMgrService::SetMaxBrightnessNitInner(uint32_t maxNit, uint32_t
 int DisplayPowerMgrService::NotifyScreenPowerStatusInner(uint32_t displayId, uint32_t displayPowerStatus)
 {
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return -1; // -1 means failed
     }
     DISPLAY_HILOGI(COMP_SVC, "[UL_POWER]NotifyScreenPowerStatus displayId=%{public}u, Status=%{public}u", displayId,
@@ -1021,6 +1598,7 @@ int32_t DisplayPowerMgrService::SetScreenPowerOffStrategyInner(PowerOffStrategy
                 PowerMgr::StateChangeReason::STATE_CHANGE_REASON_UNKNOWN);
         });
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     localMutex_.lock();
@@ -1048,7 +1626,9 @@ ErrCode DisplayPowerMgrService::SetScreenDisplayState(uint64_t screenId, uint32_
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetScreenDisplayState");
+    DisplayApiScope apiScope(DisplayApi::SET_SCREEN_DISPLAY_STATE);
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     Rosen::ScreenPowerState status = Rosen::ScreenPowerState::POWER_ON;
@@ -1057,6 +1637,7 @@ ErrCode DisplayPowerMgrService::SetScreenDisplayState(uint64_t screenId, uint32_
     } else if (state == static_cast<uint32_t>(DisplayState::DISPLAY_OFF)) {
         status = Rosen::ScreenPowerState::POWER_OFF;
     } else {
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     bool ret = Rosen::DisplayManagerLite::GetInstance().SetScreenPowerById(static_cast<Rosen::ScreenId>(screenId),
@@ -1065,10 +1646,11 @@ ErrCode DisplayPowerMgrService::SetScreenDisplayState(uint64_t screenId, uint32_
         "SetScreenDisplayState, screenId: %{public}u, status: %{public}u, reason: %{public}u, ret: %{public}u",
         static_cast<uint32_t>(screenId), status, reason, ret);
     if (ret == false) {
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     if (state == static_cast<uint32_t>(DisplayState::DISPLAY_ON)) {
-        BrightnessManager::Get().SetScreenOnBrightness();
+        BrightnessManager::Get().SetDisplayScreenOnBrightness(static_cast<uint32_t>(screenId));
     }
     return ERR_OK;
 }
@@ -1077,7 +1659,11 @@ ErrCode DisplayPowerMgrService::SetDisplayState(uint32_t id, uint32_t state, uin
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetDisplayState");
+    DisplayApiScope apiScope(DisplayApi::SET_DISPLAY_STATE);
+    DisplayTraceRecorder::Get().BeginTransaction(id, DisplayTraceEvent::SET_DISPLAY_STATE, state, reason);
     result = SetDisplayStateInner(id, static_cast<DisplayState>(state), reason);
+    DisplayTraceRecorder::Get().Record(id, DisplayTraceEvent::SET_DISPLAY_STATE_RETURN, state, result);
+    PublishPowerSnapshot();
     return ERR_OK;
 }
 
@@ -1085,6 +1671,7 @@ ErrCode DisplayPowerMgrService::GetDisplayState(uint32_t id, int32_t& displaySta
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetDisplayState");
+    DisplayApiScope apiScope(DisplayApi::GET_DISPLAY_STATE);
     displayState = static_cast<int32_t>(GetDisplayStateInner(id));
     return ERR_OK;
 }
@@ -1093,6 +1680,7 @@ ErrCode DisplayPowerMgrService::GetDisplayIds(std::vector<uint32_t>& ids)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetDisplayIds");
+    DisplayApiScope apiScope(DisplayApi::GET_DISPLAY_IDS);
     auto idsTemp = GetDisplayIdsInner();
     ids = std::move(idsTemp);
     return ERR_OK;
@@ -1102,6 +1690,7 @@ ErrCode DisplayPowerMgrService::GetMainDisplayId(uint32_t& id)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetMainDisplayId");
+    DisplayApiScope apiScope(DisplayApi::GET_MAIN_DISPLAY_ID);
     id = GetMainDisplayIdInner();
     return ERR_OK;
 }
@@ -1111,8 +1700,9 @@ ErrCode DisplayPowerMgrService::SetForcedBrightness(double value, uint32_t displ
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetForcedBrightness");
+    DisplayApiScope apiScope(DisplayApi::SET_FORCED_BRIGHTNESS);
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     int MAX_NITS = 1000 * 1000;
@@ -1123,7 +1713,7 @@ ErrCode DisplayPowerMgrService::SetForcedBrightness(double value, uint32_t displ
     if (valueType < BrightnessValueType::DEFAULT || valueType >= BrightnessValueType::MAX) {
         DISPLAY_HILOGE(COMP_SVC, "SetForcedBrightness: invalid valueType=%{public}d",
             static_cast<int>(valueType));
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     result = BrightnessManager::Get().SetForcedBrightness(value, duration, valueType);
@@ -1135,16 +1725,29 @@ ErrCode DisplayPowerMgrService::SetBrightness(uint32_t value, uint32_t displayId
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetBrightness");
+    DisplayApiScope apiScope(DisplayApi::SET_BRIGHTNESS);
     result = SetBrightnessInner(value, displayId, continuous);
     displayError = static_cast<int32_t>(GetError());
     return ERR_OK;
 }
 
+ErrCode DisplayPowerMgrService::SetBrightnessAsync(uint32_t value, uint32_t displayId, bool continuous)
+{
+    NoCoroutineSwitchGuard threadIdGuard;
+    DisplayXCollie displayXCollie("DisplayPowerMgrService::SetBrightnessAsync");
+    DisplayApiScope apiScope(DisplayApi::SET_BRIGHTNESS_ASYNC);
+    bool result = SetBrightnessInner(value, displayId, continuous);
+    DISPLAY_HILOGD(FEAT_BRIGHTNESS, "SetBrightnessAsync result=%{public}d", result);
+    return ERR_OK;
+}
+
 ErrCode DisplayPowerMgrService::DiscountBrightness(double discount, uint32_t displayId, bool& result)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::DiscountBrightness");
+    DisplayApiScope apiScope(DisplayApi::DISCOUNT_BRIGHTNESS);
     result = DiscountBrightnessInner(discount, displayId);
+    PublishPowerSnapshot();
     return ERR_OK;
 }
 
@@ -1153,7 +1756,9 @@ ErrCode DisplayPowerMgrService::OverrideBrightness(uint32_t brightness, uint32_t
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::OverrideBrightness");
+    DisplayApiScope apiScope(DisplayApi::OVERRIDE_BRIGHTNESS);
     result = OverrideBrightnessInner(brightness, displayId, duration);
+    PublishPowerSnapshot();
     return ERR_OK;
 }
 
@@ -1161,6 +1766,7 @@ ErrCode DisplayPowerMgrService::OverrideDisplayOffDelay(uint32_t delayMs, bool&
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::OverrideDisplayOffDelay");
+    DisplayApiScope apiScope(DisplayApi::OVERRIDE_DISPLAY_OFF_DELAY);
     result = OverrideDisplayOffDelayInner(delayMs);
     return ERR_OK;
 }
@@ -1169,7 +1775,9 @@ ErrCode DisplayPowerMgrService::RestoreBrightness(uint32_t displayId, uint32_t d
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::RestoreBrightness");
+    DisplayApiScope apiScope(DisplayApi::RESTORE_BRIGHTNESS);
     result = RestoreBrightnessInner(displayId, duration);
+    PublishPowerSnapshot();
     return ERR_OK;
 }
 
@@ -1177,6 +1785,7 @@ ErrCode DisplayPowerMgrService::GetBrightness(uint32_t displayId, uint32_t& brig
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetBrightness");
+    DisplayApiScope apiScope(DisplayApi::GET_BRIGHTNESS);
     brightness = GetBrightnessInner(displayId);
     return ERR_OK;
 }
@@ -1185,6 +1794,7 @@ ErrCode DisplayPowerMgrService::GetDefaultBrightness(uint32_t& defaultBrightness
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetDefaultBrightness");
+    DisplayApiScope apiScope(DisplayApi::GET_DEFAULT_BRIGHTNESS);
     defaultBrightness = GetDefaultBrightnessInner();
     return ERR_OK;
 }
@@ -1193,6 +1803,7 @@ ErrCode DisplayPowerMgrService::GetMaxBrightness(uint32_t& maxBrightness)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetMaxBrightness");
+    DisplayApiScope apiScope(DisplayApi::GET_MAX_BRIGHTNESS);
     maxBrightness = GetMaxBrightnessInner();
     return ERR_OK;
 }
@@ -1201,7 +1812,59 @@ ErrCode DisplayPowerMgrService::GetMinBrightness(uint32_t& minBrightness)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetMinBrightness");
+    DisplayApiScope apiScope(DisplayApi::GET_MIN_BRIGHTNESS);
+    minBrightness = GetMinBrightnessInner();
+    return ERR_OK;
+}
+
+ErrCode DisplayPowerMgrService::GetBrightnessLimits(uint32_t& maxBrightness, uint32_t& minBrightness,
+    uint32_t& defaultBrightness, uint32_t& mainDisplayId)
+{
+    NoCoroutineSwitchGuard threadIdGuard;
+    DisplayXCollie displayXCollie("DisplayPowerMgrService::GetBrightnessLimits");
+    DisplayApiScope apiScope(DisplayApi::GET_BRIGHTNESS_LIMITS);
+    maxBrightness = GetMaxBrightnessInner();
     minBrightness = GetMinBrightnessInner();
+    defaultBrightness = GetDefaultBrightnessInner();
+    mainDisplayId = GetMainDisplayIdInner();
+    return ERR_OK;
+}
+
+ErrCode DisplayPowerMgrService::GetPowerSnapshot(int& fd)
+{
+    NoCoroutineSwitchGuard threadIdGuard;
+    DisplayXCollie displayXCollie("DisplayPowerMgrService::GetPowerSnapshot");
+    DisplayApiScope apiScope(DisplayApi::GET_POWER_SNAPSHOT);
+    if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+    }
+    fd = snapshotWriter_.DupFd();
+    if (fd < 0) {
+        // Not a DisplayErrors value, counted with the other codes
+        DisplayApiScope::ReportError(static_cast<DisplayErrors>(ERR_NO_INIT));
+        return ERR_NO_INIT;
+    }
+    return ERR_OK;
+}
+
+ErrCode DisplayPowerMgrService::ExecuteBrightnessCommands(const std::vector<BrightnessCommand>& commands,
+    std::vector<BrightnessCommandResult>& results)
+{
+    NoCoroutineSwitchGuard threadIdGuard;
+    DisplayXCollie displayXCollie("DisplayPowerMgrService::ExecuteBrightnessCommands");
+    DisplayApiScope apiScope(DisplayApi::EXECUTE_BRIGHTNESS_COMMANDS);
+    if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+    }
+    if (commands.empty() || commands.size() > MAX_BRIGHTNESS_COMMANDS) {
+        DISPLAY_HILOGE(COMP_SVC, "ExecuteBrightnessCommands, invalid size=%{public}zu", commands.size());
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
+        return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
+    }
+    results = ExecuteBrightnessCommandsInner(commands);
+    PublishPowerSnapshot();
     return ERR_OK;
 }
 
@@ -1209,6 +1872,7 @@ ErrCode DisplayPowerMgrService::AdjustBrightness(uint32_t id, int32_t value, uin
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::AdjustBrightness");
+    DisplayApiScope apiScope(DisplayApi::ADJUST_BRIGHTNESS);
     result = AdjustBrightnessInner(id, value, duration);
     return ERR_OK;
 }
@@ -1217,6 +1881,7 @@ ErrCode DisplayPowerMgrService::AutoAdjustBrightness(bool enable, bool& result)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::AutoAdjustBrightness");
+    DisplayApiScope apiScope(DisplayApi::AUTO_ADJUST_BRIGHTNESS);
     result = AutoAdjustBrightnessInner(enable, true);
     return ERR_OK;
 }
@@ -1225,6 +1890,7 @@ ErrCode DisplayPowerMgrService::IsAutoAdjustBrightness(bool& result)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::IsAutoAdjustBrightness");
+    DisplayApiScope apiScope(DisplayApi::IS_AUTO_ADJUST_BRIGHTNESS);
     result = IsAutoAdjustBrightnessInner();
     return ERR_OK;
 }
@@ -1233,6 +1899,7 @@ ErrCode DisplayPowerMgrService::RegisterCallback(const sptr<IDisplayPowerCallbac
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::RegisterCallback");
+    DisplayApiScope apiScope(DisplayApi::REGISTER_CALLBACK);
     result = RegisterCallbackInner(callback);
     return ERR_OK;
 }
@@ -1241,7 +1908,9 @@ ErrCode DisplayPowerMgrService::BoostBrightness(int32_t timeoutMs, uint32_t disp
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::BoostBrightness");
+    DisplayApiScope apiScope(DisplayApi::BOOST_BRIGHTNESS);
     result = BoostBrightnessInner(timeoutMs, displayId);
+    PublishPowerSnapshot();
     return ERR_OK;
 }
 
@@ -1249,7 +1918,9 @@ ErrCode DisplayPowerMgrService::CancelBoostBrightness(uint32_t displayId, bool&
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::CancelBoostBrightness");
+    DisplayApiScope apiScope(DisplayApi::CANCEL_BOOST_BRIGHTNESS);
     result = CancelBoostBrightnessInner(displayId);
+    PublishPowerSnapshot();
     return ERR_OK;
 }
 
@@ -1257,6 +1928,7 @@ ErrCode DisplayPowerMgrService::GetDeviceBrightness(uint32_t displayId, bool use
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetDeviceBrightness");
+    DisplayApiScope apiScope(DisplayApi::GET_DEVICE_BRIGHTNESS);
     deviceBrightness = GetDeviceBrightnessInner(displayId, useHbm);
     return ERR_OK;
 }
@@ -1265,6 +1937,7 @@ ErrCode DisplayPowerMgrService::SetCoordinated(bool coordinated, uint32_t displa
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetCoordinated");
+    DisplayApiScope apiScope(DisplayApi::SET_COORDINATED);
     result = SetCoordinatedInner(coordinated, displayId);
     return ERR_OK;
 }
@@ -1274,6 +1947,7 @@ ErrCode DisplayPowerMgrService::SetLightBrightnessThreshold(const std::vector<in
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetLightBrightnessThreshold");
+    DisplayApiScope apiScope(DisplayApi::SET_LIGHT_BRIGHTNESS_THRESHOLD);
     result = SetLightBrightnessThresholdInner(threshold, callback);
     return ERR_OK;
 }
@@ -1282,6 +1956,7 @@ ErrCode DisplayPowerMgrService::SetMaxBrightness(double value, uint32_t mode, bo
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetMaxBrightness");
+    DisplayApiScope apiScope(DisplayApi::SET_MAX_BRIGHTNESS);
     result = SetMaxBrightnessInner(value, mode);
     displayError = static_cast<int32_t>(GetError());
     return ERR_OK;
@@ -1292,6 +1967,7 @@ ErrCode DisplayPowerMgrService::SetMaxBrightnessNit(uint32_t maxNit, uint32_t mo
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetMaxBrightnessNit");
+    DisplayApiScope apiScope(DisplayApi::SET_MAX_BRIGHTNESS_NIT);
     result = SetMaxBrightnessNitInner(maxNit, mode);
     displayError = static_cast<int32_t>(GetError());
     return ERR_OK;
@@ -1301,6 +1977,7 @@ ErrCode DisplayPowerMgrService::SetScreenOnBrightness(bool& result)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetScreenOnBrightness");
+    DisplayApiScope apiScope(DisplayApi::SET_SCREEN_ON_BRIGHTNESS);
     result = SetScreenOnBrightnessInner();
     return ERR_OK;
 }
@@ -1309,7 +1986,9 @@ ErrCode DisplayPowerMgrService::UpdateScreenPowerState(bool isScreenOn, bool& re
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::UpdateScreenPowerState");
+    DisplayApiScope apiScope(DisplayApi::UPDATE_SCREEN_POWER_STATE);
     if (!Permission::IsSystem()) {
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     result = UpdateScreenPowerStateInner(isScreenOn);
@@ -1321,6 +2000,7 @@ ErrCode DisplayPowerMgrService::NotifyScreenPowerStatus(uint32_t displayId, uint
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::NotifyScreenPowerStatus");
+    DisplayApiScope apiScope(DisplayApi::NOTIFY_SCREEN_POWER_STATUS);
     result = NotifyScreenPowerStatusInner(displayId, displayPowerStatus);
     return ERR_OK;
 }
@@ -1329,8 +2009,9 @@ ErrCode DisplayPowerMgrService::WaitDimmingDone()
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::WaitDimmingDone");
+    DisplayApiScope apiScope(DisplayApi::WAIT_DIMMING_DONE);
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     BrightnessManager::Get().WaitDimmingDone();
@@ -1341,15 +2022,16 @@ ErrCode DisplayPowerMgrService::GetFeatureSupport(BrightnessFeatureType feature,
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::GetFeatureSupport");
+    DisplayApiScope apiScope(DisplayApi::GET_FEATURE_SUPPORT);
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     DISPLAY_HILOGI(COMP_SVC, "GetFeatureSupport feature=%{public}d", static_cast<int>(feature));
     if (feature < BrightnessFeatureType::DEFAULT || feature >= BrightnessFeatureType::MAX) {
         DISPLAY_HILOGE(COMP_SVC, "GetFeatureSupport: invalid feature=%{public}d",
             static_cast<int>(feature));
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     result = BrightnessManager::Get().GetFeatureSupport(feature);
@@ -1360,45 +2042,83 @@ ErrCode DisplayPowerMgrService::RunJsonCommand(const std::string& request, std::
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::RunJsonCommand");
+    DisplayApiScope apiScope(DisplayApi::RUN_JSON_COMMAND);
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     if (request.length() > MAX_PARAMS_LENGTH) {
         DISPLAY_HILOGE(COMP_SVC, "RunJsonCommand, params too long: %{public}zu", request.length());
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
+    if (RunServiceJsonCommand(request, result)) {
+        return ERR_OK;
+    }
     result = BrightnessManager::Get().RunJsonCommand(request);
     return ERR_OK;
 }
 
+bool DisplayPowerMgrService::RunServiceJsonCommand(const std::string& request, std::string& result)
+{
+    cJSON* root = cJSON_Parse(request.c_str());
+    if (root == nullptr) {
+        return false;
+    }
+    cJSON* domain = cJSON_GetObjectItemCaseSensitive(root, "domain");
+    if (!cJSON_IsString(domain) || domain->valuestring == nullptr ||
+        strcmp(domain->valuestring, "display_service") != 0) {
+        cJSON_Delete(root);
+        return false;
+    }
+    cJSON* handler = cJSON_GetObjectItemCaseSensitive(root, "handler");
+    std::string name = (cJSON_IsString(handler) && handler->valuestring != nullptr) ? handler->valuestring : "";
+    cJSON_Delete(root);
+    if (name == "QueryApiMetrics") {
+        result = DisplayApiMetrics::Get().ToJson();
+    } else if (name == "ResetApiMetrics") {
+        DisplayApiMetrics::Get().Reset();
+        result = R"({"ret": 0})";
+    } else {
+        DISPLAY_HILOGW(COMP_SVC, "RunServiceJsonCommand, unknown handler: %{public}s", name.c_str());
+        result = R"({"ret": -1, "error": "unknown handler"})";
+    }
+    return true;
+}
+
 std::string DisplayPowerMgrService::GetCallerIdWithPid(const std::string& callerId)
 {
     return std::to_string(IPCSkeleton::GetCallingPid()) + "_" + callerId;
 }
 
+void DisplayPowerMgrService::SetLastError(DisplayErrors error)
+{
+    lastError_ = static_cast<int32_t>(error);
+    DisplayApiScope::ReportError(error);
+}
+
 ErrCode DisplayPowerMgrService::RegisterDataChangeListener(const sptr<IDisplayBrightnessListener>& listener,
     DisplayDataChangeListenerType listenerType, const std::string& callerId, const std::string& params,
     int32_t& result)
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::RegisterDataChangeListener");
+    DisplayApiScope apiScope(DisplayApi::REGISTER_DATA_CHANGE_LISTENER);
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     if (callerId.length() > MAX_PARAMS_LENGTH || params.length() > MAX_PARAMS_LENGTH) {
         DISPLAY_HILOGE(COMP_SVC, "RegisterDataChangeListener, params too long: %{public}zu, %{public}zu",
             callerId.length(), params.length());
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     auto id = GetCallerIdWithPid(callerId);
     if (listenerType < DisplayDataChangeListenerType::DEFAULT || listenerType >= DisplayDataChangeListenerType::MAX) {
         DISPLAY_HILOGE(COMP_SVC, "RegisterDataChangeListener: invalid listenerType=%{public}d",
             static_cast<int>(listenerType));
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     result = BrightnessManager::Get().RegisterDataChangeListener(listener, listenerType, id, params);
@@ -1410,19 +2130,20 @@ ErrCode DisplayPowerMgrService::UnregisterDataChangeListener(
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::UnregisterDataChangeListener");
+    DisplayApiScope apiScope(DisplayApi::UNREGISTER_DATA_CHANGE_LISTENER);
     if (!Permission::IsSystem()) {
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     if (callerId.length() > MAX_PARAMS_LENGTH) {
         DISPLAY_HILOGE(COMP_SVC, "UnregisterDataChangeListener, params too long: %{public}zu", callerId.length());
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     if (listenerType < DisplayDataChangeListenerType::DEFAULT || listenerType >= DisplayDataChangeListenerType::MAX) {
         DISPLAY_HILOGE(COMP_SVC, "UnregisterDataChangeListener: invalid listenerType=%{public}d",
             static_cast<int>(listenerType));
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     result = BrightnessManager::Get().UnregisterDataChangeListener(listenerType, GetCallerIdWithPid(callerId));
@@ -1435,6 +2156,7 @@ ErrCode DisplayPowerMgrService::SetScreenPowerOffStrategy(uint32_t strategy, uin
 #ifdef ENABLE_SCREEN_POWER_OFF_STRATEGY
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SpecificScreenPowerStrategy");
+    DisplayApiScope apiScope(DisplayApi::SET_SCREEN_POWER_OFF_STRATEGY);
     result = SetScreenPowerOffStrategyInner(static_cast<PowerOffStrategy>(strategy),
         static_cast<PowerMgr::StateChangeReason>(reason), token);
 #endif
@@ -1445,23 +2167,24 @@ ErrCode DisplayPowerMgrService::SetSceneMode(uint32_t id, SceneModeType type, bo
 {
     NoCoroutineSwitchGuard threadIdGuard;
     DisplayXCollie displayXCollie("DisplayPowerMgrService::SetSceneMode");
+    DisplayApiScope apiScope(DisplayApi::SET_SCENE_MODE);
     if (!Permission::IsSystem()) {
         result = false;
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_SYSTEM_API_DENIED);
+        SetLastError(DisplayErrors::ERR_SYSTEM_API_DENIED);
         return static_cast<ErrCode>(DisplayErrors::ERR_SYSTEM_API_DENIED);
     }
     if (type < SceneModeType::DEFAULT || type >= SceneModeType::MAX) {
         DISPLAY_HILOGE(COMP_SVC, "SetSceneMode: invalid type=%{public}d", static_cast<int>(type));
         result = false;
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     DISPLAY_HILOGI(COMP_SVC, "SetSceneMode id=%{public}u type=%{public}d enable=%{public}d",
         id, static_cast<int>(type), enable);
-    auto iterator = controllerMap_.find(id);
-    if (iterator == controllerMap_.end()) {
+    auto controller = controllers_.Find(id);
+    if (controller == nullptr) {
         result = false;
-        lastError_ = static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID);
+        SetLastError(DisplayErrors::ERR_PARAM_INVALID);
         return static_cast<ErrCode>(DisplayErrors::ERR_PARAM_INVALID);
     }
     result = BrightnessManager::Get().SetSceneMode(type, enable);
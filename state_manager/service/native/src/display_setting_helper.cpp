@@ -14,6 +14,7 @@
  */
 #include "display_setting_helper.h"
 
+#include "brightness_setting_cache.h"
 #include "display_log.h"
 #include "ffrt_inner.h"
 #include "setting_provider.h"
@@ -75,14 +76,14 @@ void DisplaySettingHelper::SetSettingBrightness(uint32_t value)
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "set setting brightness failed, ret=%{public}d", ret);
         return;
     }
+    BrightnessSettingCache::Get().UpdateIntValue(SETTING_BRIGHTNESS_KEY, static_cast<int32_t>(value));
     DISPLAY_HILOGD(FEAT_BRIGHTNESS, "set setting brightness=%{public}u", value);
 }
 
 ErrCode DisplaySettingHelper::GetSettingBrightness(uint32_t& brightness, const std::string& key)
 {
-    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
     int32_t value;
-    ErrCode ret = provider.GetIntValue(key, value);
+    ErrCode ret = BrightnessSettingCache::Get().GetIntValue(key, value);
     if (ret != ERR_OK) {
         DISPLAY_HILOGW(FEAT_BRIGHTNESS, "get setting brightness failed, ret=%{public}d", ret);
         return ret;
@@ -131,15 +132,16 @@ void DisplaySettingHelper::SetSettingAutoBrightness(bool enable)
     if (ret != ERR_OK) {
         DISPLAY_HILOGW(
             FEAT_BRIGHTNESS, "set setting auto brightness failed, enable=%{public}d, ret=%{public}d", enable, ret);
+        return;
     }
+    BrightnessSettingCache::Get().UpdateIntValue(SETTING_AUTO_ADJUST_BRIGHTNESS_KEY, value);
 }
 
 bool DisplaySettingHelper::GetSettingAutoBrightness(const std::string& key)
 {
-    SettingProvider& provider = SettingProvider::GetInstance(DISPLAY_MANAGER_SERVICE_ID);
     int32_t value = AUTO_BRIGHTNESS_DISABLE;
     for (int i = 0; i < 10; i++) { // 10 is max retry cnt
-        ErrCode ret = provider.GetIntValue(key, value);
+        ErrCode ret = BrightnessSettingCache::Get().GetIntValue(key, value);
         if (ret != ERR_OK) {
             DISPLAY_HILOGW(FEAT_BRIGHTNESS,
                 "get setting auto brightness failed key=%{public}s, ret=%{public}d, i=%{public}d", key.c_str(), ret, i);
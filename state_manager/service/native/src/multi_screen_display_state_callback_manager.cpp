@@ -27,6 +27,8 @@
 #include "display_log.h"
 #include "want.h"
 
+using namespace OHOS::PowerMgr;
+
 namespace OHOS {
 namespace DisplayPowerMgr {
 namespace {
@@ -60,10 +62,11 @@ bool MultiScreenDisplayStateCallbackManager::Register(const sptr<IRemoteObject>&
         sptr<CallbackDeathRecipient> deathRecipient(new CallbackDeathRecipient(*this));
         callback->AddDeathRecipient(deathRecipient);
         deathRecipients_[callback] = deathRecipient;
-        callbackPidUidMap_.emplace(callback,
-            std::make_pair(IPCSkeleton::GetCallingPid(), IPCSkeleton::GetCallingUid()));
+        subscribers_[callback] = CreateSubscriber(callback, IPCSkeleton::GetCallingPid(),
+            IPCSkeleton::GetCallingUid());
     }
     callbacks_.emplace(callback, screenId);
+    RebuildIndexLocked();
     DISPLAY_HILOGI(COMP_SVC, "callback for screenId=%{public}" PRIu64 ", total=%{public}zu",
         screenId, callbacks_.size());
     return true;
@@ -92,8 +95,9 @@ bool MultiScreenDisplayStateCallbackManager::Unregister(const sptr<IRemoteObject
                 callback->RemoveDeathRecipient(drIt->second);
                 deathRecipients_.erase(drIt);
             }
-            callbackPidUidMap_.erase(callback);
+            DetachLocked(callback);
         }
+        RebuildIndexLocked();
         return true;
     }
     DISPLAY_HILOGW(COMP_SVC, "callback not found for screenId=%{public}" PRIu64, screenId);
@@ -113,7 +117,8 @@ bool MultiScreenDisplayStateCallbackManager::RemoveAll(const sptr<IRemoteObject>
             callback->RemoveDeathRecipient(drIt->second);
             deathRecipients_.erase(drIt);
         }
-        callbackPidUidMap_.erase(callback);
+        DetachLocked(callback);
+        RebuildIndexLocked();
         DISPLAY_HILOGI(COMP_SVC, "RemoveAll removed %{public}zu callbacks", count);
     } else {
         DISPLAY_HILOGI(COMP_SVC, "callback not registered");
@@ -121,36 +126,110 @@ bool MultiScreenDisplayStateCallbackManager::RemoveAll(const sptr<IRemoteObject>
     return true;
 }
 
+auto MultiScreenDisplayStateCallbackManager::CreateSubscriber(const sptr<IRemoteObject>& callback, int32_t pid,
+    int32_t uid) -> std::shared_ptr<Subscriber>
+{
+    std::string label = "MultiScreenCallback Pid=" + std::to_string(pid) + " Uid=" + std::to_string(uid);
+    auto deliver = [proxy = iface_cast<IMultiScreenDisplayStateCallback>(callback), pid, uid](
+        const Notification& notification) {
+        if (proxy == nullptr) {
+            return;
+        }
+        DISPLAY_HILOGI(COMP_SVC, "MultiScreenCallback begin Pid=%{public}d Uid=%{public}d screenId=%{public}" PRIu64,
+            pid, uid, notification.screenId);
+        int64_t start = GetTickCount();
+        proxy->OnMultiScreenDisplayStateChanged(notification.screenId, notification.screenName, notification.state,
+            static_cast<MultiScreenStateChangeReason>(notification.reason));
+        DISPLAY_HILOGI(COMP_SVC, "MultiScreenCallback end Pid=%{public}d Uid=%{public}d costTime=%{public}" PRId64,
+            pid, uid, GetTickCount() - start);
+    };
+    // While the subscriber lags behind, a queued change of a screen is replaced by the newer change of that screen
+    auto key = [](const Notification& notification) { return notification.screenId; };
+    // A subscriber that keeps missing the deadline is dropped, as if it had died
+    auto onQuarantine = [weakManager = weak_from_this(), weakCallback = wptr<IRemoteObject>(callback), pid, uid] {
+        DISPLAY_HILOGE(COMP_SVC, "MultiScreenCallback quarantined Pid=%{public}d Uid=%{public}d", pid, uid);
+        auto manager = weakManager.lock();
+        auto object = weakCallback.promote();
+        if (manager != nullptr && object != nullptr) {
+            manager->RemoveAll(object);
+        }
+    };
+    auto mailbox = std::make_shared<CallbackMailbox<Notification>>(std::move(label), std::move(deliver),
+        std::move(key), tracker_, std::move(onQuarantine), deliveryPolicy_);
+    return std::make_shared<Subscriber>(Subscriber {callback, pid, uid, std::move(mailbox)});
+}
+
+void MultiScreenDisplayStateCallbackManager::RebuildIndexLocked()
+{
+    auto index = std::make_shared<SubscriberIndex>();
+    for (const auto& [callback, screenId] : callbacks_) {
+        auto& subscriber = subscribers_[callback];
+        if (subscriber == nullptr) {
+            subscriber = CreateSubscriber(callback, 0, 0);
+        }
+        if (screenId == SCREEN_ID_ALL) {
+            index->allScreens.push_back(subscriber);
+        } else {
+            index->screens[screenId].push_back(subscriber);
+        }
+    }
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    index_ = std::move(index);
+}
+
+void MultiScreenDisplayStateCallbackManager::DetachLocked(const sptr<IRemoteObject>& callback)
+{
+    auto iter = subscribers_.find(callback);
+    if (iter == subscribers_.end()) {
+        return;
+    }
+    // A delivery already running completes, the queued ones are discarded
+    iter->second->mailbox->Close();
+    subscribers_.erase(iter);
+}
+
 void MultiScreenDisplayStateCallbackManager::Notify(uint64_t screenId, const std::string& screenName,
     DisplayState state, uint32_t reason)
 {
     DISPLAY_HILOGI(COMP_SVC,
         "Notify screenId=%{public}" PRIu64 ", screenName=%{public}s, state=%{public}u, reason=%{public}u",
         screenId, screenName.c_str(), static_cast<uint32_t>(state), reason);
-    std::vector<std::pair<sptr<IRemoteObject>, uint64_t>> callbacks;
+    std::shared_ptr<const SubscriberIndex> index;
     {
-        std::lock_guard<ffrt::mutex> lock(mutex_);
-        callbacks.assign(callbacks_.begin(), callbacks_.end());
+        std::lock_guard<std::mutex> lock(indexMutex_);
+        index = index_;
     }
-    for (const auto& entry : callbacks) {
-        uint64_t registeredId = entry.second;
-        if (registeredId == screenId || registeredId == SCREEN_ID_ALL) {
-            auto proxy = iface_cast<IMultiScreenDisplayStateCallback>(entry.first);
-            if (proxy != nullptr) {
-                auto pidUidIt = callbackPidUidMap_.find(entry.first);
-                auto pidUid = (pidUidIt != callbackPidUidMap_.end()) ? pidUidIt->second : std::make_pair(0, 0);
-                DISPLAY_HILOGI(COMP_SVC,
-                    "MultiScreenCallback begin Pid=%{public}d Uid=%{public}d screenId=%{public}" PRIu64,
-                    pidUid.first, pidUid.second, screenId);
-                int64_t start = GetTickCount();
-                proxy->OnMultiScreenDisplayStateChanged(screenId, screenName, state,
-                    static_cast<MultiScreenStateChangeReason>(reason));
-                int64_t cost = GetTickCount() - start;
-                DISPLAY_HILOGI(COMP_SVC,
-                    "MultiScreenCallback end Pid=%{public}d Uid=%{public}d costTime=%{public}" PRId64,
-                    pidUid.first, pidUid.second, cost);
-            }
+    Notification notification {screenId, screenName, state, reason};
+    auto iter = index->screens.find(screenId);
+    if (iter != index->screens.end()) {
+        for (const auto& subscriber : iter->second) {
+            subscriber->mailbox->Post(notification);
+        }
+    }
+    for (const auto& subscriber : index->allScreens) {
+        subscriber->mailbox->Post(notification);
+    }
+}
+
+bool MultiScreenDisplayStateCallbackManager::WaitForDeliveries(uint32_t timeoutMs)
+{
+    return tracker_->Wait(timeoutMs);
+}
+
+void MultiScreenDisplayStateCallbackManager::Dump(std::string& result)
+{
+    std::lock_guard<ffrt::mutex> lock(mutex_);
+    result.append("Multi Screen Callbacks: ").append(std::to_string(subscribers_.size())).append("\n");
+    for (const auto& [callback, subscriber] : subscribers_) {
+        result.append("  Pid=").append(std::to_string(subscriber->pid));
+        result.append(" Uid=").append(std::to_string(subscriber->uid));
+        result.append(" Screens=");
+        auto range = callbacks_.equal_range(callback);
+        for (auto it = range.first; it != range.second; ++it) {
+            result.append(it == range.first ? "" : ",");
+            result.append(it->second == SCREEN_ID_ALL ? "all" : std::to_string(it->second));
         }
+        AppendDeliveryStats(subscriber->mailbox->GetStats(), result);
     }
 }
 
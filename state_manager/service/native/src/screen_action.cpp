@@ -21,6 +21,7 @@
 #include <ipc_skeleton.h>
 
 #include "display_log.h"
+#include "display_trace_recorder.h"
 #include "screen_manager_lite.h"
 #include "ffrt.h"
 #ifdef ENABLE_SCREEN_POWER_OFF_STRATEGY
@@ -146,9 +147,13 @@ bool ScreenAction::SetDisplayState(DisplayState state, const std::function<void(
     DISPLAY_HILOGI(FEAT_STATE, "[UL_POWER] SetDisplayState displayId=%{public}u, state=%{public}u, ffrtId=%{public}u",
         displayId_, static_cast<uint32_t>(state), ffrtId);
     Rosen::DisplayState rds = ParseDisplayState(state);
+    // The callback may come after another request of the display began its own transaction
+    uint32_t transactionId = DisplayTraceRecorder::Get().GetTransaction(displayId_);
+    DisplayTraceRecorder::Get().RecordIn(transactionId, displayId_, DisplayTraceEvent::SCREEN_SET_DISPLAY_STATE,
+        static_cast<uint32_t>(state));
     std::string identity = IPCSkeleton::ResetCallingIdentity();
     bool ret = Rosen::DisplayManagerLite::GetInstance().SetDisplayState(rds,
-        [callback, state, beginTimeMs, this](Rosen::DisplayState rosenState) {
+        [callback, state, beginTimeMs, transactionId, this](Rosen::DisplayState rosenState) {
         DISPLAY_HILOGI(FEAT_STATE, "[UL_POWER] SetDisplayState Callback:%{public}d", static_cast<uint32_t>(rosenState));
         DisplayState state;
         switch (rosenState) {
@@ -170,10 +175,14 @@ bool ScreenAction::SetDisplayState(DisplayState state, const std::function<void(
             default:
                 return;
         }
+        DisplayTraceRecorder::Get().RecordIn(transactionId, displayId_,
+            DisplayTraceEvent::SCREEN_DISPLAY_STATE_CALLBACK, static_cast<uint32_t>(state));
         WriteHiSysEvent(state, beginTimeMs);
         callback(state);
     });
     IPCSkeleton::SetCallingIdentity(identity);
+    DisplayTraceRecorder::Get().RecordIn(transactionId, displayId_, DisplayTraceEvent::SCREEN_SET_DISPLAY_STATE_RETURN,
+        static_cast<uint32_t>(state), ret);
     // Notify screen state change event to battery statistics
 #ifdef HAS_HIVIEWDFX_HISYSEVENT_PART
     HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::DISPLAY, "SCREEN_STATE",
@@ -292,6 +301,7 @@ bool ScreenAction::SetBrightness(uint32_t value)
     Rosen::DmsScreenBrightnessData brightnessData(displayId_, value);
     bool isSucc = Rosen::DisplayManagerLite::GetInstance().SetScreenBrightness(brightnessData);
     IPCSkeleton::SetCallingIdentity(identity);
+    DisplayTraceRecorder::Get().RecordOnce(displayId_, DisplayTraceEvent::SET_SCREEN_BRIGHTNESS, value, isSucc);
     std::lock_guard lock(mutexBrightness_);
     brightness_ = isSucc ? value : brightness_;
     return isSucc;
@@ -15,6 +15,8 @@
 
 #include "screen_controller.h"
 
+#include <datetime_ex.h>
+
 #include "delayed_sp_singleton.h"
 #include "display_common.h"
 #include "display_log.h"
@@ -84,14 +86,15 @@ DisplayState ScreenController::GetState()
 DisplayState ScreenController::SetDelayOffState()
 {
     DISPLAY_HILOGI(COMP_SVC, "Set the display state is DELAY OFF when overriding display off delay");
-    state_ = DisplayState::DISPLAY_DELAY_OFF;
+    transitionMetrics_.Record(state_.exchange(DisplayState::DISPLAY_DELAY_OFF), DisplayState::DISPLAY_DELAY_OFF, 0,
+        true);
     return state_.load();
 }
 
 DisplayState ScreenController::SetOnState()
 {
     DISPLAY_HILOGI(COMP_SVC, "Set the display state is ON after overriding display on delay");
-    state_ = DisplayState::DISPLAY_ON;
+    transitionMetrics_.Record(state_.exchange(DisplayState::DISPLAY_ON), DisplayState::DISPLAY_ON, 0, true);
     return state_.load();
 }
 
@@ -101,45 +104,31 @@ bool ScreenController::UpdateState(DisplayState state, uint32_t reason)
     DISPLAY_HILOGI(FEAT_STATE,
         "[UL_POWER] UpdateState, state=%{public}u, current state=%{public}u, reason=%{public}u, ffrtId=%{public}u",
         static_cast<uint32_t>(state), static_cast<uint32_t>(state_.load()), reason, ffrtId);
-    if (reason != static_cast<uint32_t>
-        (PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT_AUTH_FAIL_SCREEN_OFF)) {
-        RETURN_IF_WITH_RET(state == state_.load(), true);
-    }
-    if (state == DisplayState::DISPLAY_DIM && state_.load() == DisplayState::DISPLAY_OFF) {
-        DISPLAY_HILOGI(FEAT_STATE, "Not allowed to set DIM state.");
+    DisplayState current = state_.load();
+    DisplayTransitionAction action = DisplayStateMachine::GetAction(current, state, reason);
+    if (action == DisplayTransitionAction::KEEP) {
+        DISPLAY_HILOGI(FEAT_STATE, "No need to update state");
         return true;
     }
-    switch (state) {
-        case DisplayState::DISPLAY_ON:
-            if (state_.load() == DisplayState::DISPLAY_DIM) {
-                break;
+    int64_t start = GetTickCount();
+    if (DisplayStateMachine::IsPowerAction(action)) {
+        if (action_->EnableSkipSetDisplayState(reason)) {
+            OnStateChanged(state, reason);
+        } else {
+            function<void(DisplayState)> callback =
+                bind(&ScreenController::OnStateChanged, this, placeholders::_1, reason);
+            bool ret = action_->SetDisplayState(state, callback);
+            if (!ret) {
+                ffrtId = ffrt::this_task::get_id();
+                DISPLAY_HILOGW(FEAT_STATE, "Update display state failed, state=%{public}d, ffrtId=%{public}u",
+                    state, ffrtId);
+                transitionMetrics_.Record(current, state, GetTickCount() - start, false);
+                return ret;
             }
-            [[fallthrough]];
-        case DisplayState::DISPLAY_DOZE_SUSPEND:
-        case DisplayState::DISPLAY_DOZE:
-        case DisplayState::DISPLAY_OFF: {
-            if (action_->EnableSkipSetDisplayState(reason)) {
-                OnStateChanged(state, reason);
-            } else {
-                function<void(DisplayState)> callback =
-                    bind(&ScreenController::OnStateChanged, this, placeholders::_1, reason);
-                bool ret = action_->SetDisplayState(state, callback);
-                if (!ret) {
-                    ffrtId = ffrt::this_task::get_id();
-                    DISPLAY_HILOGW(FEAT_STATE, "Update display state failed, state=%{public}d, ffrtId=%{public}u",
-                        state, ffrtId);
-                    return ret;
-                }
-            }
-            break;
         }
-        case DisplayState::DISPLAY_DIM:
-        case DisplayState::DISPLAY_SUSPEND:
-        default:
-            break;
     }
 
-    if (IsNeedSkipNextProc(reason)) {
+    if (action == DisplayTransitionAction::POWER_ONLY || action == DisplayTransitionAction::INTERRUPT) {
         DISPLAY_HILOGI(FEAT_STATE,
             "Need interrupt next process when updating state because of reason = %{public}d", reason);
         return false;
@@ -148,11 +137,17 @@ bool ScreenController::UpdateState(DisplayState state, uint32_t reason)
     lock_guard lock(mutexState_);
     state_ = state;
     stateChangeReason_ = reason;
+    transitionMetrics_.Record(current, state, GetTickCount() - start, true);
     ffrtId = ffrt::this_task::get_id();
     DISPLAY_HILOGI(FEAT_STATE, "[UL_POWER] Update screen state to %{public}u, ffrtId=%{public}u", state, ffrtId);
     return true;
 }
 
+void ScreenController::DumpTransitions(std::string& result) const
+{
+    transitionMetrics_.Dump(result);
+}
+
 bool ScreenController::IsScreenOn()
 {
     lock_guard lock(mutexState_);
@@ -276,16 +271,6 @@ bool ScreenController::IsBrightnessBoosted() const
     return isBrightnessBoosted_;
 }
 
-bool ScreenController::IsNeedSkipNextProc(uint32_t reason)
-{
-    if (reason == static_cast<uint32_t>(PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT) ||
-        reason == static_cast<uint32_t>(
-            PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT_AUTH_FAIL_SCREEN_OFF)) {
-        return true;
-    }
-    return false;
-}
-
 void ScreenController::OnStateChanged(DisplayState state, uint32_t reason)
 {
     auto pms = DelayedSpSingleton<DisplayPowerMgrService>::GetInstance();
@@ -331,11 +316,14 @@ bool ScreenController::UpdateMultiScreenState(DisplayState state, uint32_t reaso
         "[UL_POWER_IVI] UpdateMultiScreenState, screenId=%{public}u, state=%{public}u, current state=%{public}u,"
         " reason=%{public}u",
         action_->GetDisplayId(), static_cast<uint32_t>(state), static_cast<uint32_t>(state_.load()), reason);
-    auto pms = DelayedSpSingleton<DisplayPowerMgrService>::GetInstance();
-    if (pms == nullptr) {
-        DISPLAY_HILOGW(FEAT_STATE, "pms is nullptr");
+    if (!ApplyMultiScreenPower(state, reason)) {
         return false;
     }
+    return CommitMultiScreenState(state, reason, screenName);
+}
+
+bool ScreenController::ApplyMultiScreenPower(DisplayState state, uint32_t reason)
+{
     if (state == DisplayState::DISPLAY_ON) {
         action_->MultiScreenWakeUpBegin(reason);
     } else {
@@ -353,6 +341,16 @@ bool ScreenController::UpdateMultiScreenState(DisplayState state, uint32_t reaso
             action_->GetDisplayId(), state);
         return false;
     }
+    return true;
+}
+
+bool ScreenController::CommitMultiScreenState(DisplayState state, uint32_t reason, const std::string& screenName)
+{
+    auto pms = DelayedSpSingleton<DisplayPowerMgrService>::GetInstance();
+    if (pms == nullptr) {
+        DISPLAY_HILOGW(FEAT_STATE, "pms is nullptr");
+        return false;
+    }
     if (state == DisplayState::DISPLAY_ON) {
         pms->SetScreenOnBrightness(action_->GetDisplayId());
         DISPLAY_HILOGI(FEAT_BRIGHTNESS, "[UL_POWER_IVI] SetScreenOnBrightness screenId=%{public}u",
@@ -457,18 +455,24 @@ uint32_t ScreenController::GetScreenOnBrightness() const
     }
 }
 
-void ScreenController::RegisterSettingBrightnessObserver()
+void ScreenController::RegisterSettingBrightnessObserver(std::function<void(uint32_t)> observer)
 {
-    SettingObserver::UpdateFunc updateFunc = [&](const std::string& key) { BrightnessSettingUpdateFunc(key); };
+    SettingObserver::UpdateFunc updateFunc = [this, observer](const std::string& key) {
+        BrightnessSettingUpdateFunc(key, observer);
+    };
     DisplaySettingHelper::RegisterSettingBrightnessObserver(updateFunc);
 }
 
-void ScreenController::BrightnessSettingUpdateFunc(const string& key)
+void ScreenController::BrightnessSettingUpdateFunc(const string& key,
+    const std::function<void(uint32_t)>& observer)
 {
+    uint32_t settingBrightness = GetSettingBrightness(key);
+    if (observer) {
+        observer(settingBrightness);
+    }
     if (animator_->IsAnimating() || !CanSetBrightness()) {
         return;
     }
-    uint32_t settingBrightness = GetSettingBrightness(key);
     if (cachedSettingBrightness_ == settingBrightness) {
         DISPLAY_HILOGD(FEAT_BRIGHTNESS, "no need to set setting brightness");
         return;
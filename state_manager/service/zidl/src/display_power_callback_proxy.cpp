@@ -32,7 +32,8 @@ void DisplayPowerCallbackProxy::OnDisplayStateChanged(uint32_t displayId, Displa
 
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    // Oneway, the service does not wait for the subscriber to handle the change
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(DisplayPowerCallbackProxy::GetDescriptor())) {
         DISPLAY_HILOGE(COMP_FWK, "write descriptor failed!");
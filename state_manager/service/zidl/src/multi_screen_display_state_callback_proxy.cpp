@@ -32,7 +32,8 @@ void MultiScreenDisplayStateCallbackProxy::OnMultiScreenDisplayStateChanged(uint
 
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option(MessageOption::TF_SYNC);
+    // Oneway, the service does not wait for the subscriber to handle the change
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(MultiScreenDisplayStateCallbackProxy::GetDescriptor())) {
         DISPLAY_HILOGE(COMP_FWK, "write descriptor failed!");
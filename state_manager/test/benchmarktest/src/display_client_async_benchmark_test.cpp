@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "display_power_mgr_client.h"
+#include "display_power_mgr_proxy.h"
+#include "ipc_object_stub.h"
+
+using namespace OHOS;
+using namespace OHOS::DisplayPowerMgr;
+
+namespace {
+// Service-side cost of the stand-in, in the order of a panel power transition and a brightness write
+constexpr std::chrono::microseconds SET_DISPLAY_STATE_COST {3000};
+constexpr std::chrono::microseconds SET_BRIGHTNESS_COST {300};
+constexpr uint32_t TEST_BRIGHTNESS = 100;
+
+// Local stand-in for the display manager service. Requests with a result block for the service-side cost,
+// the one-way request returns once it is queued, as a binder one-way transaction does.
+class StandInDisplayService : public DisplayPowerMgrProxy {
+public:
+    StandInDisplayService() : DisplayPowerMgrProxy(sptr<IPCObjectStub>::MakeSptr(u"StandInDisplayService")) {}
+    ~StandInDisplayService() override = default;
+
+    ErrCode SetDisplayState(uint32_t id, uint32_t state, uint32_t reason, bool& result) override
+    {
+        std::this_thread::sleep_for(SET_DISPLAY_STATE_COST);
+        result = true;
+        return ERR_OK;
+    }
+
+    ErrCode SetBrightness(uint32_t value, uint32_t displayId, bool continuous, bool& result,
+        int32_t& displayError) override
+    {
+        std::this_thread::sleep_for(SET_BRIGHTNESS_COST);
+        result = true;
+        displayError = ERR_OK;
+        return ERR_OK;
+    }
+
+    ErrCode SetBrightnessAsync(uint32_t value, uint32_t displayId, bool continuous) override
+    {
+        return ERR_OK;
+    }
+};
+
+// Points the client at the stand-in for the lifetime of a benchmark
+class StandInScope {
+public:
+    StandInScope() : client_(DisplayPowerMgrClient::GetInstance())
+    {
+        std::lock_guard lock(client_.mutex_);
+        saved_ = client_.connection_;
+        client_.PublishConnection(std::make_shared<DisplayPowerMgrClient::Connection>(
+            sptr<StandInDisplayService>::MakeSptr()));
+    }
+
+    ~StandInScope()
+    {
+        std::lock_guard lock(client_.mutex_);
+        client_.PublishConnection(saved_);
+    }
+
+private:
+    DisplayPowerMgrClient& client_;
+    std::shared_ptr<DisplayPowerMgrClient::Connection> saved_ {nullptr};
+};
+
+// Caller-side latency: the sync call blocks for the service cost, the async call only for the submission
+void DisplayClientSetDisplayStateSync(benchmark::State& state)
+{
+    StandInScope scope;
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.SetDisplayState(DisplayState::DISPLAY_ON));
+    }
+}
+BENCHMARK(DisplayClientSetDisplayStateSync)->UseRealTime();
+
+void DisplayClientSetDisplayStateAsync(benchmark::State& state)
+{
+    StandInScope scope;
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    std::vector<std::future<bool>> pending;
+    for (auto _ : state) {
+        pending.push_back(client.SetDisplayStateAsync(DisplayState::DISPLAY_ON));
+    }
+    // Completions are drained outside the timed loop so the stand-in outlives every queued request
+    for (auto& future : pending) {
+        future.wait();
+    }
+}
+BENCHMARK(DisplayClientSetDisplayStateAsync)->UseRealTime();
+
+void DisplayClientSetBrightnessSync(benchmark::State& state)
+{
+    StandInScope scope;
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.SetBrightness(TEST_BRIGHTNESS, 0, true));
+    }
+}
+BENCHMARK(DisplayClientSetBrightnessSync)->UseRealTime();
+
+void DisplayClientSetBrightnessAsync(benchmark::State& state)
+{
+    StandInScope scope;
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.SetBrightnessAsync(TEST_BRIGHTNESS, 0, true));
+    }
+}
+BENCHMARK(DisplayClientSetBrightnessAsync)->UseRealTime();
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "display_power_mgr_client.h"
+
+using namespace OHOS;
+using namespace OHOS::DisplayPowerMgr;
+
+namespace {
+constexpr int MAX_THREADS = 8;
+
+// Baseline: the connection copied under mutex_ on every call, as a locked lookup would do
+void DisplayClientGetConnectionLocked(benchmark::State& state)
+{
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    if (client.GetConnection() == nullptr) {
+        state.SkipWithError("display manager service is not available");
+        return;
+    }
+    for (auto _ : state) {
+        std::lock_guard lock(client.mutex_);
+        std::shared_ptr<DisplayPowerMgrClient::Connection> connection = client.connection_;
+        benchmark::DoNotOptimize(connection);
+    }
+}
+BENCHMARK(DisplayClientGetConnectionLocked)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+void DisplayClientGetConnection(benchmark::State& state)
+{
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    if (client.GetConnection() == nullptr) {
+        state.SkipWithError("display manager service is not available");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.GetConnection());
+    }
+}
+BENCHMARK(DisplayClientGetConnection)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+// Served from the cached limits, so the connection lookup and the snapshot read dominate
+void DisplayClientGetMaxBrightness(benchmark::State& state)
+{
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    if (client.GetMainDisplayId() < 0) {
+        state.SkipWithError("display manager service is not available");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.GetMaxBrightness());
+    }
+}
+BENCHMARK(DisplayClientGetMaxBrightness)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+// End-to-end client call throughput, dominated by the IPC itself
+void DisplayClientGetDisplayIds(benchmark::State& state)
+{
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    if (client.GetMainDisplayId() < 0) {
+        state.SkipWithError("display manager service is not available");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.GetDisplayIds());
+    }
+}
+BENCHMARK(DisplayClientGetDisplayIds)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+// Served from the power snapshot without IPC
+void DisplayClientGetBrightness(benchmark::State& state)
+{
+    auto& client = DisplayPowerMgrClient::GetInstance();
+    if (client.GetMainDisplayId() < 0) {
+        state.SkipWithError("display manager service is not available");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.GetBrightness());
+    }
+}
+BENCHMARK(DisplayClientGetBrightness)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "screen_controller_registry.h"
+
+using namespace OHOS::DisplayPowerMgr;
+
+namespace {
+// Many binder threads looking up a handful to a few dozen screens
+constexpr int32_t MIN_BINDER_THREADS = 1;
+constexpr int32_t MAX_BINDER_THREADS = 32;
+constexpr int64_t MIN_SCREENS = 1;
+constexpr int64_t MAX_SCREENS = 64;
+constexpr uint64_t HOTPLUG_SCREEN_ID = 1000;
+
+// Stand-in for ScreenController, the lookup cost does not depend on the controller type
+struct Controller {
+    explicit Controller(uint64_t id) : id(id) {}
+    uint64_t id;
+};
+
+// Previous layout: a map behind a mutex
+class LockedMapRegistry {
+public:
+    std::shared_ptr<Controller> Find(uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = map_.find(id);
+        return (iter != map_.end()) ? iter->second : nullptr;
+    }
+
+    void Emplace(uint64_t id, std::shared_ptr<Controller> controller)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.emplace(id, std::move(controller));
+    }
+
+    void Erase(uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.erase(id);
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<uint64_t, std::shared_ptr<Controller>> map_;
+};
+
+// One registry per screen count, shared by all threads of a run
+template<typename Registry>
+Registry& GetRegistry(uint64_t screens)
+{
+    static std::mutex mutex;
+    static std::map<uint64_t, std::unique_ptr<Registry>> registries;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& registry = registries[screens];
+    if (registry == nullptr) {
+        registry = std::make_unique<Registry>();
+        for (uint64_t id = 0; id < screens; id++) {
+            registry->Emplace(id, std::make_shared<Controller>(id));
+        }
+    }
+    return *registry;
+}
+
+// Every thread looks up screens in turn. With hotplug, thread 0 keeps adding and removing a screen instead.
+template<typename Registry, bool HOTPLUG>
+void RegistryLookup(benchmark::State& state)
+{
+    uint64_t screens = static_cast<uint64_t>(state.range(0));
+    auto& registry = GetRegistry<Registry>(screens);
+    bool isHotplugThread = HOTPLUG && state.thread_index() == 0;
+    uint64_t id = static_cast<uint64_t>(state.thread_index()) % screens;
+    for (auto _ : state) {
+        if (isHotplugThread) {
+            registry.Emplace(HOTPLUG_SCREEN_ID, std::make_shared<Controller>(HOTPLUG_SCREEN_ID));
+            registry.Erase(HOTPLUG_SCREEN_ID);
+            continue;
+        }
+        benchmark::DoNotOptimize(registry.Find(id));
+        id = (id + 1 == screens) ? 0 : id + 1;
+    }
+}
+
+void LockedMapLookup(benchmark::State& state)
+{
+    RegistryLookup<LockedMapRegistry, false>(state);
+}
+
+void RegistryLookupNoHotplug(benchmark::State& state)
+{
+    RegistryLookup<ControllerRegistry<Controller>, false>(state);
+}
+
+void LockedMapLookupWithHotplug(benchmark::State& state)
+{
+    RegistryLookup<LockedMapRegistry, true>(state);
+}
+
+void RegistryLookupWithHotplug(benchmark::State& state)
+{
+    RegistryLookup<ControllerRegistry<Controller>, true>(state);
+}
+
+#define REGISTRY_BENCHMARK(name) \
+    BENCHMARK(name)->RangeMultiplier(4)->Range(MIN_SCREENS, MAX_SCREENS) \
+        ->ThreadRange(MIN_BINDER_THREADS, MAX_BINDER_THREADS)->UseRealTime()
+
+REGISTRY_BENCHMARK(LockedMapLookup);
+REGISTRY_BENCHMARK(RegistryLookupNoHotplug);
+REGISTRY_BENCHMARK(LockedMapLookupWithHotplug);
+REGISTRY_BENCHMARK(RegistryLookupWithHotplug);
+} // namespace
+
+BENCHMARK_MAIN();
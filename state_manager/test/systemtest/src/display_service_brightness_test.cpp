@@ -25,6 +25,7 @@
 #include <memory>
 #include <unistd.h>
 #include "display_brightness_callback_stub.h"
+#include "display_param_helper.h"
 #include "display_power_mgr_service.h"
 #include "screen_manager_lite.h"
 #include "permission.h"
@@ -223,7 +224,7 @@ HWTEST_F(DisplayPowerServiceBrightnessTest, DisplayPowerServiceBrightnessTest007
     EXPECT_TRUE(g_service != nullptr);
     uint32_t brightness = 0;
     g_service->GetDefaultBrightness(brightness);
-    EXPECT_EQ(brightness, DisplayPowerMgrService::BRIGHTNESS_DEFAULT);
+    EXPECT_EQ(brightness, DisplayParamHelper::GetDefaultBrightness());
     DISPLAY_HILOGI(LABEL_TEST, "DisplayPowerServiceBrightnessTest007 function end!");
 }
 
@@ -239,7 +240,7 @@ HWTEST_F(DisplayPowerServiceBrightnessTest, DisplayPowerServiceBrightnessTest008
     EXPECT_TRUE(g_service != nullptr);
     uint32_t brightness = 0;
     g_service->GetMinBrightness(brightness);
-    EXPECT_EQ(brightness, DisplayPowerMgrService::BRIGHTNESS_MIN);
+    EXPECT_EQ(brightness, DisplayParamHelper::GetMinBrightness());
     DISPLAY_HILOGI(LABEL_TEST, "DisplayPowerServiceBrightnessTest008 function end!");
 }
 
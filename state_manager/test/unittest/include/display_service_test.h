@@ -16,6 +16,9 @@
 #ifndef DISPLAY_SERVICE_TEST_H
 #define DISPLAY_SERVICE_TEST_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "display_power_mgr_proxy.h"
@@ -40,6 +43,37 @@ public:
             uint32_t displayId, OHOS::DisplayPowerMgr::DisplayState state, uint32_t reason) override;
     };
 
+    // Keeps a subscriber inside its delivery until released, so that a test sees it as still running
+    class DeliveryGate {
+    public:
+        void Enter();
+        bool WaitEntered(uint32_t timeoutMs);
+        void Release();
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool isEntered_ {false};
+        bool isReleased_ {false};
+    };
+
+    // Accepted by RegisterCallbackInner as a proxy, records the changes it receives. A slow one advances the
+    // delivery clock of the test by costMs instead of sleeping, see SlowDeliveryPolicy.
+    class TestDisplayPowerCallback : public OHOS::DisplayPowerMgr::DisplayPowerCallbackStub {
+    public:
+        explicit TestDisplayPowerCallback(int costMs = 0, DeliveryGate* gate = nullptr)
+            : costMs_(costMs), gate_(gate) {}
+        ~TestDisplayPowerCallback() override = default;
+        bool IsProxyObject() const override { return true; }
+        void OnDisplayStateChanged(
+            uint32_t displayId, OHOS::DisplayPowerMgr::DisplayState state, uint32_t reason) override;
+
+        OHOS::DisplayPowerMgr::DisplayState lastState_ {OHOS::DisplayPowerMgr::DisplayState::DISPLAY_UNKNOWN};
+        std::atomic<int> callCount_ {0};
+    private:
+        int costMs_ {0};
+        DeliveryGate* gate_ {nullptr};
+    };
+
     class BrightnessServiceMock : public OHOS::DisplayPowerMgr::BrightnessService {
     public:
         BrightnessServiceMock() {}
@@ -63,7 +97,7 @@ public:
         std::string lastScreenName_;
         OHOS::DisplayPowerMgr::DisplayState lastState_ {OHOS::DisplayPowerMgr::DisplayState::DISPLAY_UNKNOWN};
         uint32_t lastReason_ {0};
-        int callCount_ {0};
+        std::atomic<int> callCount_ {0};
     private:
         bool isProxy_ {false};
     };
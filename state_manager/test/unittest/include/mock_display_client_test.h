@@ -35,6 +35,6 @@ public:
     };
 
     OHOS::DisplayPowerMgr::DisplayPowerMgrClient& mClient = OHOS::DisplayPowerMgr::DisplayPowerMgrClient::GetInstance();
-    OHOS::sptr<OHOS::DisplayPowerMgr::IDisplayPowerMgr> mProxyBack{nullptr};
+    std::shared_ptr<OHOS::DisplayPowerMgr::DisplayPowerMgrClient::Connection> mConnectionBack{nullptr};
 };
 #endif // DISPLAYMGR_DISPLAY_CLIENT_MOCK_TEST_H
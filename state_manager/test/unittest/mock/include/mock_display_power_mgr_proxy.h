@@ -44,6 +44,12 @@ public:
     int32_t GetDefaultBrightness(uint32_t& defaultBrightness) override;
     int32_t GetMaxBrightness(uint32_t& maxBrightness) override;
     int32_t GetMinBrightness(uint32_t& minBrightness) override;
+    int32_t GetBrightnessLimits(uint32_t& maxBrightness, uint32_t& minBrightness, uint32_t& defaultBrightness,
+        uint32_t& mainDisplayId) override;
+    int32_t GetPowerSnapshot(int& fd) override;
+    int32_t ExecuteBrightnessCommands(const std::vector<BrightnessCommand>& commands,
+        std::vector<BrightnessCommandResult>& results) override;
+    int32_t SetBrightnessAsync(uint32_t value, uint32_t displayId, bool continuous) override;
     int32_t AdjustBrightness(uint32_t id, int32_t value, uint32_t duration, bool& bResult) override;
     int32_t AutoAdjustBrightness(bool enable, bool& bResult) override;
     int32_t IsAutoAdjustBrightness(bool& bResult) override;
@@ -104,6 +104,28 @@ int32_t MockDisplayPowerMgrProxy::GetMinBrightness(uint32_t& minBrightness)
     return ERR_FAIL;
 }
 
+int32_t MockDisplayPowerMgrProxy::GetBrightnessLimits(uint32_t& maxBrightness, uint32_t& minBrightness,
+    uint32_t& defaultBrightness, uint32_t& mainDisplayId)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockDisplayPowerMgrProxy::GetPowerSnapshot(int& fd)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockDisplayPowerMgrProxy::ExecuteBrightnessCommands(const std::vector<BrightnessCommand>& commands,
+    std::vector<BrightnessCommandResult>& results)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockDisplayPowerMgrProxy::SetBrightnessAsync(uint32_t value, uint32_t displayId, bool continuous)
+{
+    return ERR_FAIL;
+}
+
 int32_t MockDisplayPowerMgrProxy::AdjustBrightness(uint32_t id, int32_t value, uint32_t duration, bool& isResult)
 {
     return ERR_FAIL;
@@ -1134,4 +1134,57 @@ HWTEST_F(DisplayPowerMgrBrightnessTest, DisplayPowerMgrSetSceneMode, TestSize.Le
     DisplayPowerMgrClient::GetInstance().SetSceneMode(0, SceneModeType::SCENE_MODE_CONSTANT, true);
     EXPECT_FALSE(DisplayPowerMgrClient::GetInstance().SetSceneMode(0, SceneModeType::MAX, true));
 }
+
+/**
+ * @tc.name: DisplayPowerMgrExecuteBrightnessCommands001
+ * @tc.desc: Test override and discount applied by one batch, with the limits read in the same batch
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayPowerMgrBrightnessTest, DisplayPowerMgrExecuteBrightnessCommands001, TestSize.Level0)
+{
+    const uint32_t OVERRIDE_BRIGHTNESS = 200;
+    const double DISCOUNT_VALUE = 0.5;
+    std::vector<BrightnessCommand> commands = {
+        {BrightnessCommandType::OVERRIDE_BRIGHTNESS, 0, OVERRIDE_BRIGHTNESS, 0},
+        {BrightnessCommandType::DISCOUNT_BRIGHTNESS, 0, DISCOUNT_VALUE, 0},
+        {BrightnessCommandType::GET_MAX_BRIGHTNESS, 0, 0, 0},
+        {BrightnessCommandType::GET_MIN_BRIGHTNESS, 0, 0, 0},
+    };
+    std::vector<BrightnessCommandResult> results;
+    EXPECT_TRUE(DisplayPowerMgrClient::GetInstance().ExecuteBrightnessCommands(commands, results));
+    ASSERT_EQ(results.size(), commands.size());
+    EXPECT_TRUE(results[0].result);
+    EXPECT_TRUE(results[1].result);
+    EXPECT_EQ(results[2].value, DisplayPowerMgrClient::GetInstance().GetMaxBrightness());
+    EXPECT_EQ(results[3].value, DisplayPowerMgrClient::GetInstance().GetMinBrightness());
+    WaitDimmingDone();
+    uint32_t value = DisplayPowerMgrClient::GetInstance().GetDeviceBrightness();
+    EXPECT_EQ(value, static_cast<uint32_t>(OVERRIDE_BRIGHTNESS * DISCOUNT_VALUE));
+}
+
+/**
+ * @tc.name: DisplayPowerMgrExecuteBrightnessCommands002
+ * @tc.desc: Test ExecuteBrightnessCommands with invalid batches and commands
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayPowerMgrBrightnessTest, DisplayPowerMgrExecuteBrightnessCommands002, TestSize.Level0)
+{
+    std::vector<BrightnessCommandResult> results;
+    EXPECT_FALSE(DisplayPowerMgrClient::GetInstance().ExecuteBrightnessCommands({}, results));
+
+    const size_t TOO_MANY_COMMANDS = 100;
+    std::vector<BrightnessCommand> commands(TOO_MANY_COMMANDS,
+        BrightnessCommand {BrightnessCommandType::GET_BRIGHTNESS, 0, 0, 0});
+    EXPECT_FALSE(DisplayPowerMgrClient::GetInstance().ExecuteBrightnessCommands(commands, results));
+
+    commands = {
+        {BrightnessCommandType::MAX, 0, 0, 0},
+        {BrightnessCommandType::SET_BRIGHTNESS, 0, -1.0, 0},
+    };
+    EXPECT_TRUE(DisplayPowerMgrClient::GetInstance().ExecuteBrightnessCommands(commands, results));
+    ASSERT_EQ(results.size(), commands.size());
+    EXPECT_EQ(results[0].retCode, static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID));
+    EXPECT_EQ(results[1].retCode, static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID));
+    EXPECT_FALSE(results[1].result);
+}
 } // namespace
\ No newline at end of file
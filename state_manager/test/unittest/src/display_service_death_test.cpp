@@ -15,6 +15,9 @@
 
 #include "display_service_death_test.h"
 
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include "display_power_mgr_client.h"
 
 using namespace testing::ext;
@@ -40,6 +43,204 @@ HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_001, TestSize.Level0)
     EXPECT_NE(deathRecipient, nullptr);
     wptr<IRemoteObject> remoteObj = nullptr;
     deathRecipient->OnRemoteDied(remoteObj);
-    EXPECT_NE(displayClient.proxy_, nullptr);
+    EXPECT_NE(displayClient.connection_, nullptr);
+}
+
+/**
+ * @tc.name: DisplayServiceDeathTest_002
+ * @tc.desc: test OnRemoteDied function(cached brightness limits are dropped and fetched again)
+ * @tc.type: FUNC
+ */
+HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_002, TestSize.Level0)
+{
+    auto& displayClient = DisplayPowerMgrClient::GetInstance();
+    uint32_t maxBrightness = displayClient.GetMaxBrightness();
+    EXPECT_TRUE(displayClient.isLimitsCached_);
+
+    auto proxy = displayClient.GetProxy();
+    ASSERT_NE(proxy, nullptr);
+    wptr<IRemoteObject> remoteObj = proxy->AsObject();
+    displayClient.OnRemoteDied(remoteObj);
+    EXPECT_EQ(displayClient.connection_, nullptr);
+    EXPECT_FALSE(displayClient.isLimitsCached_);
+
+    EXPECT_EQ(displayClient.GetMaxBrightness(), maxBrightness);
+    EXPECT_TRUE(displayClient.isLimitsCached_);
+}
+
+/**
+ * @tc.name: DisplayServiceDeathTest_003
+ * @tc.desc: test OnRemoteDied function(power snapshot is unmapped and mapped again)
+ * @tc.type: FUNC
+ */
+HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_003, TestSize.Level0)
+{
+    auto& displayClient = DisplayPowerMgrClient::GetInstance();
+    uint32_t mainDisplayId = static_cast<uint32_t>(displayClient.GetMainDisplayId());
+    auto proxy = displayClient.GetProxy();
+    ASSERT_NE(proxy, nullptr);
+    int32_t state = static_cast<int32_t>(DisplayState::DISPLAY_UNKNOWN);
+    EXPECT_EQ(proxy->GetDisplayState(mainDisplayId, state), ERR_OK);
+    EXPECT_EQ(displayClient.GetDisplayState(mainDisplayId), static_cast<DisplayState>(state));
+    auto reader = displayClient.GetSnapshotReader();
+    ASSERT_NE(reader, nullptr);
+
+    wptr<IRemoteObject> remoteObj = proxy->AsObject();
+    displayClient.OnRemoteDied(remoteObj);
+    EXPECT_EQ(displayClient.connection_, nullptr);
+    // The dead connection stays mapped for callers that still hold it
+    DisplayPowerSnapshotData data;
+    EXPECT_TRUE(reader->Read(mainDisplayId, data));
+
+    EXPECT_EQ(displayClient.GetDisplayState(mainDisplayId), static_cast<DisplayState>(state));
+    ASSERT_NE(displayClient.connection_, nullptr);
+    EXPECT_NE(displayClient.connection_->snapshotReader.load(), nullptr);
+    EXPECT_NE(displayClient.connection_->snapshotReader.load(), reader.get());
+}
+
+/**
+ * @tc.name: DisplayServiceDeathTest_004
+ * @tc.desc: test power snapshot publish and read through a read-only mapping
+ * @tc.type: FUNC
+ */
+HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_004, TestSize.Level0)
+{
+    DisplayPowerSnapshotWriter writer;
+    ASSERT_TRUE(writer.Create());
+    DisplayPowerSnapshotReader reader;
+    ASSERT_TRUE(reader.Map(writer.DupFd()));
+
+    DisplayPowerSnapshotData data;
+    EXPECT_FALSE(reader.Read(0, data));
+    DisplayPowerSnapshotData published;
+    published.displayId = 0;
+    published.state = static_cast<int32_t>(DisplayState::DISPLAY_ON);
+    published.brightness = 128;
+    published.discount = 0.5;
+    published.flags = SNAPSHOT_STATE_VALID | SNAPSHOT_BRIGHTNESS_VALID;
+    EXPECT_TRUE(writer.Publish(published));
+    ASSERT_TRUE(reader.Read(0, data));
+    EXPECT_EQ(data.state, published.state);
+    EXPECT_EQ(data.brightness, published.brightness);
+    EXPECT_DOUBLE_EQ(data.discount, published.discount);
+    EXPECT_EQ(data.flags, published.flags);
+    EXPECT_EQ(data.generation, 1U);
+
+    published.brightness = 64;
+    EXPECT_TRUE(writer.Publish(published));
+    ASSERT_TRUE(reader.Read(0, data));
+    EXPECT_EQ(data.brightness, 64U);
+    EXPECT_EQ(data.generation, 2U);
+    EXPECT_FALSE(reader.Read(1, data));
+}
+
+/**
+ * @tc.name: DisplayServiceDeathTest_005
+ * @tc.desc: test lux estimates publish and read through a read-only mapping
+ * @tc.type: FUNC
+ */
+HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_005, TestSize.Level0)
+{
+    DisplayPowerSnapshotWriter writer;
+    ASSERT_TRUE(writer.Create());
+    DisplayPowerSnapshotReader reader;
+    ASSERT_TRUE(reader.Map(writer.DupFd()));
+
+    DisplayLuxSnapshotData data;
+    ASSERT_TRUE(reader.ReadLux(data));
+    EXPECT_EQ(data.flags & SNAPSHOT_LUX_VALID, 0U);
+    DisplayLuxSnapshotData published;
+    published.lux = 310.5f;
+    published.filteredLux = 298.25f;
+    published.smoothedLux = 280.0f;
+    published.flags = SNAPSHOT_LUX_VALID;
+    EXPECT_TRUE(writer.PublishLux(published));
+    ASSERT_TRUE(reader.ReadLux(data));
+    EXPECT_FLOAT_EQ(data.lux, published.lux);
+    EXPECT_FLOAT_EQ(data.filteredLux, published.filteredLux);
+    EXPECT_FLOAT_EQ(data.smoothedLux, published.smoothedLux);
+    EXPECT_EQ(data.flags, SNAPSHOT_LUX_VALID);
+    EXPECT_EQ(data.generation, 1U);
+
+    published.flags = 0;
+    EXPECT_TRUE(writer.PublishLux(published));
+    ASSERT_TRUE(reader.ReadLux(data));
+    EXPECT_EQ(data.flags & SNAPSHOT_LUX_VALID, 0U);
+    EXPECT_EQ(data.generation, 2U);
+    // The per-display slots are not affected
+    DisplayPowerSnapshotData displayData;
+    EXPECT_FALSE(reader.Read(0, displayData));
+}
+
+/**
+ * @tc.name: DisplayServiceDeathTest_006
+ * @tc.desc: test limits generation moves on invalidation, cached limits are fetched again
+ * @tc.type: FUNC
+ */
+HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_006, TestSize.Level0)
+{
+    DisplayPowerSnapshotWriter writer;
+    ASSERT_TRUE(writer.Create());
+    DisplayPowerSnapshotReader reader;
+    ASSERT_TRUE(reader.Map(writer.DupFd()));
+
+    uint32_t generation = UINT32_MAX;
+    ASSERT_TRUE(reader.ReadLimitsGeneration(generation));
+    EXPECT_EQ(generation, 0U);
+    EXPECT_TRUE(writer.InvalidateLimits());
+    ASSERT_TRUE(reader.ReadLimitsGeneration(generation));
+    EXPECT_EQ(generation, 1U);
+    // Limits invalidation does not touch the per-display slots
+    DisplayPowerSnapshotData displayData;
+    EXPECT_FALSE(reader.Read(0, displayData));
+}
+
+/**
+ * @tc.name: DisplayServiceDeathTest_007
+ * @tc.desc: test the descriptor handed to clients cannot be mapped writable
+ * @tc.type: FUNC
+ */
+HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_007, TestSize.Level0)
+{
+    DisplayPowerSnapshotWriter writer;
+    ASSERT_TRUE(writer.Create());
+    int fd = writer.DupFd();
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(fcntl(fd, F_GETFL) & O_ACCMODE, O_RDONLY);
+    void* addr = mmap(nullptr, sizeof(DisplayPowerSnapshotRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    EXPECT_EQ(addr, MAP_FAILED);
+    if (addr != MAP_FAILED) {
+        munmap(addr, sizeof(DisplayPowerSnapshotRegion));
+    }
+    DisplayPowerSnapshotReader reader;
+    EXPECT_TRUE(reader.Map(fd));
+}
+
+/**
+ * @tc.name: DisplayServiceDeathTest_008
+ * @tc.desc: test limits are cached without a power snapshot, the main display id is still fetched
+ * @tc.type: FUNC
+ */
+HWTEST_F (DisplayServiceDeathTest, DisplayServiceDeathTest_008, TestSize.Level0)
+{
+    auto& displayClient = DisplayPowerMgrClient::GetInstance();
+    auto proxy = displayClient.GetProxy();
+    ASSERT_NE(proxy, nullptr);
+    displayClient.OnRemoteDied(proxy->AsObject());
+    // A caller the service refuses the snapshot to, such as a non-system app
+    auto connection = displayClient.GetConnection();
+    ASSERT_NE(connection, nullptr);
+    connection->isSnapshotRequested = true;
+
+    uint32_t maxBrightness = displayClient.GetMaxBrightness();
+    EXPECT_TRUE(displayClient.isLimitsCached_);
+    EXPECT_FALSE(displayClient.isCachedGenerationKnown_);
+    EXPECT_EQ(displayClient.GetMinBrightness(), displayClient.limits_.minBrightness);
+    EXPECT_EQ(displayClient.GetMaxBrightness(), maxBrightness);
+    EXPECT_GE(displayClient.GetMainDisplayId(), 0);
+    EXPECT_TRUE(displayClient.isLimitsCached_);
+
+    displayClient.OnRemoteDied(displayClient.GetProxy()->AsObject());
+    EXPECT_FALSE(displayClient.isLimitsCached_);
 }
 }
@@ -39,6 +39,8 @@
 #include "imulti_screen_display_state_callback.h"
 #include "multi_screen_display_state_callback_manager.h"
 #include "screen_controller.h"
+#include "display_api_metrics.h"
+#include "display_trace_recorder.h"
 #endif
 #ifdef ENABLE_SCREEN_POWER_OFF_STRATEGY
 #include "miscellaneous_display_power_strategy.h"
@@ -78,6 +80,11 @@ static constexpr int32_t DEFAULT_VALUE = -1;
 static constexpr uint32_t BRIGHTNESS_OFF = 0;
 static const uint32_t TEST_DELAY_TIME_UNSET = 0;
 static constexpr uint32_t DEFAULT_WAITING_TIME = 1200000;
+constexpr uint32_t CALLBACK_WAIT_TIMEOUT_MS = 2000;
+// Past the delivery deadline of DeliveryPolicy but short of its quarantine
+constexpr int SLOW_DELIVERY_COST_MS = 300;
+// Delivery clock of the slow subscribers, only advanced by their deliveries
+std::atomic<int64_t> g_deliveryClockMs {0};
 sptr<DisplayPowerMgrService> g_service;
 OHOS::Rosen::ScreenPowerState g_powerState = OHOS::Rosen::ScreenPowerState::POWER_ON;
 bool g_isPermissionGranted = true;
@@ -112,6 +119,21 @@ std::string g_lastPubReason;
 std::atomic<int> g_concurrencyCount{0};
 std::atomic<int> g_maxConcurrencyCount{0};
 #endif
+
+DeliveryPolicy SlowDeliveryPolicy()
+{
+    DeliveryPolicy policy;
+    policy.clock = [] { return g_deliveryClockMs.load(); };
+    return policy;
+}
+
+// Time never passes for the deliveries of a fast subscriber, whatever the slow ones are doing meanwhile
+DeliveryPolicy FastDeliveryPolicy()
+{
+    DeliveryPolicy policy;
+    policy.clock = [] { return static_cast<int64_t>(0); };
+    return policy;
+}
 } // namespace
 
 namespace OHOS::PowerMgr {
@@ -139,7 +161,7 @@ void TestMultiScreenCallback::OnMultiScreenDisplayStateChanged(
     callCount_++;
     DISPLAY_HILOGI(LABEL_TEST, "TestMultiScreenCallback: screenId=%{public}" PRIu64
         " screenName=%{public}s state=%{public}u reason=%{public}u count=%{public}d",
-        screenId, screenName.c_str(), static_cast<uint32_t>(state), static_cast<uint32_t>(reason), callCount_);
+        screenId, screenName.c_str(), static_cast<uint32_t>(state), static_cast<uint32_t>(reason), callCount_.load());
 }
 #endif
 } // namespace OHOS::PowerMgr
@@ -240,6 +262,39 @@ void DisplayServiceTest::DisplayPowerMgrTestCallback::OnDisplayStateChanged(
     DISPLAY_HILOGI(LABEL_TEST, "DisplayPowerMgrTestCallback::OnDisplayStateChangedStub");
 }
 
+void DisplayServiceTest::DeliveryGate::Enter()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    isEntered_ = true;
+    cv_.notify_all();
+    // Bounded, so that a failing test does not hang the delivery task
+    cv_.wait_for(lock, std::chrono::milliseconds(CALLBACK_WAIT_TIMEOUT_MS), [this] { return isReleased_; });
+}
+
+bool DisplayServiceTest::DeliveryGate::WaitEntered(uint32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return isEntered_; });
+}
+
+void DisplayServiceTest::DeliveryGate::Release()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isReleased_ = true;
+    cv_.notify_all();
+}
+
+void DisplayServiceTest::TestDisplayPowerCallback::OnDisplayStateChanged(
+    uint32_t displayId, DisplayPowerMgr::DisplayState state, uint32_t reason)
+{
+    g_deliveryClockMs += costMs_;
+    if (gate_ != nullptr) {
+        gate_->Enter();
+    }
+    lastState_ = state;
+    callCount_++;
+}
+
 namespace OHOS::Rosen {
 bool DisplayManagerLite::SetDisplayState(DisplayState state, DisplayStateCallback callback)
 {
@@ -308,6 +363,98 @@ HWTEST_F(DisplayServiceTest, DisplayServiceInnerTest002, TestSize.Level1)
     DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceInnerTest002 function end!");
 }
 
+/**
+ * @tc.name: DisplayServiceInnerTest003
+ * @tc.desc: test every registered IDisplayPowerCallback is notified, a slow one only gets the latest state
+ *           and a dead one is removed alone
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DisplayServiceTest, DisplayServiceInnerTest003, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceInnerTest003 function start!");
+    EXPECT_TRUE(g_service != nullptr);
+    g_service->UnregisterCallbackInner();
+    DisplayServiceTest::DeliveryGate gate;
+    sptr<DisplayServiceTest::TestDisplayPowerCallback> slowCb =
+        new DisplayServiceTest::TestDisplayPowerCallback(SLOW_DELIVERY_COST_MS, &gate);
+    sptr<DisplayServiceTest::TestDisplayPowerCallback> cb = new DisplayServiceTest::TestDisplayPowerCallback();
+    g_service->stateCallbackPolicy_ = SlowDeliveryPolicy();
+    EXPECT_TRUE(g_service->RegisterCallbackInner(slowCb));
+    g_service->stateCallbackPolicy_ = FastDeliveryPolicy();
+    EXPECT_TRUE(g_service->RegisterCallbackInner(cb));
+    EXPECT_FALSE(g_service->RegisterCallbackInner(cb));
+    g_service->stateCallbackPolicy_ = DeliveryPolicy();
+
+    g_service->NotifyStateChangeCallback(DISPLAY_ID, DisplayPowerMgr::DisplayState::DISPLAY_OFF, REASON);
+    // The slow subscriber is now held past its deadline, its pending changes of the display collapse to the last one
+    EXPECT_TRUE(gate.WaitEntered(CALLBACK_WAIT_TIMEOUT_MS));
+    g_service->NotifyStateChangeCallback(DISPLAY_ID, DisplayPowerMgr::DisplayState::DISPLAY_ON, REASON);
+    g_service->NotifyStateChangeCallback(DISPLAY_ID, DisplayPowerMgr::DisplayState::DISPLAY_DIM, REASON);
+    g_service->NotifyStateChangeCallback(DISPLAY_ID, DisplayPowerMgr::DisplayState::DISPLAY_ON, REASON);
+    // The other subscriber is not delayed by the held one
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CALLBACK_WAIT_TIMEOUT_MS);
+    while (cb->callCount_ < 4 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(cb->callCount_, 4);
+    EXPECT_EQ(slowCb->callCount_, 0);
+    gate.Release();
+
+    EXPECT_TRUE(g_service->stateCallbackTracker_->Wait(CALLBACK_WAIT_TIMEOUT_MS));
+    EXPECT_EQ(cb->callCount_, 4);
+    EXPECT_EQ(slowCb->callCount_, 2);
+    EXPECT_EQ(slowCb->lastState_, DisplayPowerMgr::DisplayState::DISPLAY_ON);
+
+    EXPECT_TRUE(g_service->UnregisterCallbackInner(slowCb->AsObject()));
+    EXPECT_FALSE(g_service->UnregisterCallbackInner(slowCb->AsObject()));
+    g_service->NotifyStateChangeCallback(DISPLAY_ID, DisplayPowerMgr::DisplayState::DISPLAY_OFF, REASON);
+    EXPECT_TRUE(g_service->stateCallbackTracker_->Wait(CALLBACK_WAIT_TIMEOUT_MS));
+    EXPECT_EQ(cb->callCount_, 5);
+    EXPECT_EQ(slowCb->callCount_, 2);
+    g_service->UnregisterCallbackInner();
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceInnerTest003 function end!");
+}
+
+/**
+ * @tc.name: DisplayServiceInnerTest004
+ * @tc.desc: test an IDisplayPowerCallback missing the deadline several times in a row is quarantined and removed
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DisplayServiceTest, DisplayServiceInnerTest004, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceInnerTest004 function start!");
+    EXPECT_TRUE(g_service != nullptr);
+    g_service->UnregisterCallbackInner();
+    sptr<DisplayServiceTest::TestDisplayPowerCallback> slowCb =
+        new DisplayServiceTest::TestDisplayPowerCallback(SLOW_DELIVERY_COST_MS);
+    g_service->stateCallbackPolicy_ = SlowDeliveryPolicy();
+    EXPECT_TRUE(g_service->RegisterCallbackInner(slowCb));
+    g_service->stateCallbackPolicy_ = DeliveryPolicy();
+
+    // Changes of different displays are not coalesced, each one is delivered late
+    for (uint32_t displayId = DISPLAY_ID; displayId < DISPLAY_ID + 4; displayId++) {
+        g_service->NotifyStateChangeCallback(displayId, DisplayPowerMgr::DisplayState::DISPLAY_ON, REASON);
+    }
+    EXPECT_TRUE(g_service->stateCallbackTracker_->Wait(CALLBACK_WAIT_TIMEOUT_MS));
+    EXPECT_EQ(slowCb->callCount_, 3);
+
+    // The subscriber is removed by an FFRT task
+    auto isRemoved = [] {
+        std::string dump;
+        g_service->AppendStateCallbacksDump(dump);
+        return dump.find("Display State Callbacks: 0") != std::string::npos;
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CALLBACK_WAIT_TIMEOUT_MS);
+    while (!isRemoved() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(isRemoved());
+    EXPECT_FALSE(g_service->UnregisterCallbackInner(slowCb->AsObject()));
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceInnerTest004 function end!");
+}
+
 /**
  * @tc.name: DisplayServiceTest001
  * @tc.desc: test DisplayPowerMgrService function SetDisplayState id != DISPLAY_MAIN_ID
@@ -337,15 +484,15 @@ HWTEST_F(DisplayServiceTest, DisplayServiceTest002, TestSize.Level1)
     DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest002 function start!");
     EXPECT_TRUE(g_service != nullptr);
     bool ret = false;
-    auto controller = g_service->controllerMap_[DISPLAY_MAIN_ID];
-    g_service->controllerMap_.erase(DISPLAY_MAIN_ID);
+    auto controller = g_service->controllers_.Find(DISPLAY_MAIN_ID);
+    g_service->controllers_.Erase(DISPLAY_MAIN_ID);
     g_service->SetDisplayState(DISPLAY_MAIN_ID, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON),
         REASON, ret);
     EXPECT_FALSE(ret);
     int32_t displayState = 0;
     g_service->GetDisplayState(DISPLAY_MAIN_ID, displayState);
     EXPECT_EQ(static_cast<int32_t>(DisplayPowerMgr::DisplayState::DISPLAY_UNKNOWN), displayState);
-    g_service->controllerMap_.emplace(DISPLAY_MAIN_ID, controller);
+    g_service->controllers_.Emplace(DISPLAY_MAIN_ID, controller);
     DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest002 function end!");
 }
 
@@ -449,13 +596,13 @@ HWTEST_F(DisplayServiceTest, DisplayServiceTest008, TestSize.Level1)
     EXPECT_TRUE(g_service != nullptr);
     bool ret = false;
     g_service->OverrideDisplayOffDelay(TEST_DELAY_TIME_UNSET, ret);
-    EXPECT_FALSE(g_service->isDisplayDelayOff_);
+    EXPECT_FALSE(g_service->offDelayScheduler_.IsArmed(g_service->GetMainDisplayIdInner()));
     EXPECT_FALSE(ret);
     g_service->SetDisplayState(DISPLAY_MAIN_ID, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_OFF),
         REASON, ret);
     EXPECT_TRUE(ret);
     g_service->OverrideDisplayOffDelay(OVERRIDE_DELAY_TIME, ret);
-    EXPECT_FALSE(g_service->isDisplayDelayOff_);
+    EXPECT_FALSE(g_service->offDelayScheduler_.IsArmed(g_service->GetMainDisplayIdInner()));
     DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest008 function end!");
 }
 
@@ -616,6 +763,38 @@ HWTEST_F(DisplayServiceTest, DisplayServiceTest013, TestSize.Level0)
     DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest013 function end!");
 }
 
+/**
+ * @tc.name: DisplayServiceTest014
+ * @tc.desc: Test an overridden display off delay also defers the display off of a pre-bright authentication failure
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayServiceTest014, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest014 function start!");
+    const uint32_t authFailReason =
+        static_cast<uint32_t>(PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT_AUTH_FAIL_SCREEN_OFF);
+    bool result = false;
+    g_service->SetDisplayState(DISPLAY_MAIN_ID, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON),
+        REASON, result);
+    g_service->OverrideDisplayOffDelay(OVERRIDE_DELAY_TIME, result);
+    if (!result) {
+        DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest014 skipped, display is not on");
+        return;
+    }
+    uint32_t mainDisplayId = g_service->GetMainDisplayIdInner();
+    g_service->SetDisplayState(DISPLAY_MAIN_ID, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_OFF),
+        authFailReason, result);
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(g_service->offDelayScheduler_.IsPending(mainDisplayId));
+
+    // An on request cancels the deferred off
+    g_service->SetDisplayState(DISPLAY_MAIN_ID, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON),
+        REASON, result);
+    EXPECT_TRUE(result);
+    EXPECT_FALSE(g_service->offDelayScheduler_.IsPending(mainDisplayId));
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest014 function end!");
+}
+
 /**
  * @tc.name: DisplayServiceTest031
  * @tc.desc: test set screen diaplay state
@@ -849,19 +1028,19 @@ HWTEST_F(DisplayServiceTest, DisplayServiceTest042, TestSize.Level1)
     DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest042 function start!");
     EXPECT_TRUE(g_service != nullptr);
     bool result = false;
-    auto controllerMap = g_service->controllerMap_;
-    g_service->controllerMap_.clear();
+    auto controllers = g_service->controllers_.GetAll();
+    g_service->controllers_.Reset();
     auto ret = g_service->UpdateScreenPowerState(true, result);
     EXPECT_EQ(ret, ERR_OK);
     EXPECT_FALSE(result);
     g_isMock = true;
     constexpr int32_t mockId = 3308;
-    g_service->controllerMap_.emplace(mockId, std::make_shared<ScreenController>(mockId));
+    g_service->controllers_.Emplace(mockId, std::make_shared<ScreenController>(mockId));
     ret = g_service->UpdateScreenPowerState(true, result);
     EXPECT_EQ(ret, ERR_OK);
     EXPECT_TRUE(result);
     g_isMock = false;
-    g_service->controllerMap_ = controllerMap;
+    g_service->controllers_.Reset(controllers);
     DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceTest042 function end!");
 }
 
@@ -1195,6 +1374,7 @@ HWTEST_F(DisplayServiceTest, SetMultiScreenDisplayStateInnerTest004, TestSize.Le
     ret = g_service->SetMultiScreenDisplayStateInner(
         MAIN_SCREEN_ID, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_ON, DEFAULT_REASON);
     EXPECT_EQ(ret, DisplayErrors::ERR_OK);
+    EXPECT_TRUE(g_service->multiScreenCallbackMgr_->WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb->callCount_, 0);
     EXPECT_EQ(g_publishEventCount, 0);
 
@@ -1435,6 +1615,7 @@ HWTEST_F(DisplayServiceTest, SetMultiScreenDisplayStateInnerTest010, TestSize.Le
         EXPECT_EQ(results[i], DisplayErrors::ERR_OK);
     }
 
+    EXPECT_TRUE(g_service->multiScreenCallbackMgr_->WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb0->callCount_, SCREEN_COUNT);
     EXPECT_EQ(cb1->callCount_, SCREEN_COUNT);
     EXPECT_EQ(cb2->callCount_, SCREEN_COUNT);
@@ -1447,6 +1628,47 @@ HWTEST_F(DisplayServiceTest, SetMultiScreenDisplayStateInnerTest010, TestSize.Le
     DISPLAY_HILOGI(LABEL_TEST, "SetMultiScreenDisplayStateInnerTest010 function end!");
 }
 
+/**
+ * @tc.name: SetMultiScreenDisplayStatesInnerTest001
+ * @tc.desc: Test batched multi-screen transition: screens are powered concurrently, results follow request order,
+ *           invalid and duplicate entries fail alone.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, SetMultiScreenDisplayStatesInnerTest001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "SetMultiScreenDisplayStatesInnerTest001 function start!");
+    constexpr int SCREEN_COUNT = 5;
+    std::vector<MultiScreenStateRequest> requests;
+    for (uint64_t i = 0; i < SCREEN_COUNT; i++) {
+        g_service->SetMultiScreenDisplayStateInner(i, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_OFF,
+            DEFAULT_REASON);
+        requests.push_back({i, TEST_SCREEN_NAME, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON),
+            DEFAULT_REASON});
+    }
+    requests.push_back({MAIN_SCREEN_ID, TEST_SCREEN_NAME,
+        static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_OFF), DEFAULT_REASON});
+    requests.push_back({INVALID_SCREEN_ID, TEST_SCREEN_NAME,
+        static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_DIM), DEFAULT_REASON});
+
+    g_maxConcurrencyCount = 0;
+    std::vector<MultiScreenStateResult> results;
+    EXPECT_EQ(g_service->SetMultiScreenDisplayStatesInner(requests, results), DisplayErrors::ERR_OK);
+    ASSERT_EQ(results.size(), requests.size());
+    for (uint64_t i = 0; i < SCREEN_COUNT; i++) {
+        EXPECT_EQ(results[i].screenId, i);
+        EXPECT_EQ(results[i].retCode, static_cast<int32_t>(DisplayErrors::ERR_OK));
+        DisplayPowerMgr::DisplayState state = DisplayPowerMgr::DisplayState::DISPLAY_UNKNOWN;
+        g_service->GetMultiScreenDisplayStateInner(i, state);
+        EXPECT_EQ(state, DisplayPowerMgr::DisplayState::DISPLAY_ON);
+    }
+    EXPECT_EQ(results[SCREEN_COUNT].retCode, static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID));
+    EXPECT_EQ(results[SCREEN_COUNT + 1].retCode, static_cast<int32_t>(DisplayErrors::ERR_PARAM_INVALID));
+    EXPECT_GE(g_maxConcurrencyCount.load(), MIN_CONCURRENCY_DEPTH);
+
+    EXPECT_EQ(g_service->SetMultiScreenDisplayStatesInner({}, results), DisplayErrors::ERR_PARAM_INVALID);
+    DISPLAY_HILOGI(LABEL_TEST, "SetMultiScreenDisplayStatesInnerTest001 function end!");
+}
+
 /**
  * @tc.name: GetMultiScreenDisplayStateInnerTest001
  * @tc.desc: Test GetMultiScreenDisplayStateInner without permission
@@ -1564,6 +1786,7 @@ HWTEST_F(DisplayServiceTest, RegisterMultiScreenDisplayStateCallbackInnerTest004
 
     g_service->SetMultiScreenDisplayStateInner(MAIN_SCREEN_ID, TEST_SCREEN_NAME,
         DisplayPowerMgr::DisplayState::DISPLAY_OFF, DEFAULT_REASON);
+    EXPECT_TRUE(g_service->multiScreenCallbackMgr_->WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb->callCount_, 1);
     EXPECT_EQ(cb->lastScreenId_, MAIN_SCREEN_ID);
     EXPECT_EQ(cb->lastState_, DisplayPowerMgr::DisplayState::DISPLAY_OFF);
@@ -1578,6 +1801,7 @@ HWTEST_F(DisplayServiceTest, RegisterMultiScreenDisplayStateCallbackInnerTest004
     int callCountAfterUnregister = cb->callCount_;
     g_service->SetMultiScreenDisplayStateInner(MAIN_SCREEN_ID, TEST_SCREEN_NAME,
         DisplayPowerMgr::DisplayState::DISPLAY_ON, DEFAULT_REASON);
+    EXPECT_TRUE(g_service->multiScreenCallbackMgr_->WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb->callCount_, callCountAfterUnregister);
 
     ret = g_service->UnregisterMultiScreenDisplayStateCallbackInner(cb, MAIN_SCREEN_ID);
@@ -1653,6 +1877,7 @@ HWTEST_F(DisplayServiceTest, UnregisterMultiScreenDisplayStateCallbackInnerTest0
 
     g_service->SetMultiScreenDisplayStateInner(MAIN_SCREEN_ID, TEST_SCREEN_NAME,
         DisplayPowerMgr::DisplayState::DISPLAY_OFF, DEFAULT_REASON);
+    EXPECT_TRUE(g_service->multiScreenCallbackMgr_->WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb->callCount_, 0);
     DISPLAY_HILOGI(LABEL_TEST, "UnregisterMultiScreenDisplayStateCallbackInnerTest004 function end!");
 }
@@ -1780,25 +2005,135 @@ HWTEST_F(DisplayServiceTest, MultiScreenDisplayStateCallbackManagerTest006, Test
     sptr<IRemoteObject> obj = cb->AsObject();
     sptr<IRemoteObject> objAll = cbAll->AsObject();
 
-    mgr.callbacks_.emplace(obj, SECOND_SCREEN_ID);
-    mgr.callbacks_.emplace(obj, FOURTH_SCREEN_ID);
-    mgr.callbacks_.emplace(objAll, SCREEN_ID_ALL);
+    EXPECT_TRUE(mgr.Register(obj, SECOND_SCREEN_ID));
+    EXPECT_TRUE(mgr.Register(obj, FOURTH_SCREEN_ID));
+    EXPECT_TRUE(mgr.Register(objAll, SCREEN_ID_ALL));
 
     mgr.Notify(SECOND_SCREEN_ID, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_OFF, DEFAULT_REASON);
+    EXPECT_TRUE(mgr.WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb->callCount_, 1);
     EXPECT_EQ(cbAll->callCount_, 1);
 
     mgr.Notify(THIRD_SCREEN_ID, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_ON, DEFAULT_REASON);
+    EXPECT_TRUE(mgr.WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb->callCount_, 1);
     EXPECT_EQ(cbAll->callCount_, 2);
 
     mgr.Notify(FOURTH_SCREEN_ID, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_ON, DEFAULT_REASON);
+    EXPECT_TRUE(mgr.WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
     EXPECT_EQ(cb->callCount_, 2);
     EXPECT_EQ(cbAll->callCount_, 3);
-    mgr.callbacks_.clear();
+    mgr.RemoveAll(obj);
+    mgr.RemoveAll(objAll);
     DISPLAY_HILOGI(LABEL_TEST, "MultiScreenDisplayStateCallbackManagerTest006 function end!");
 }
 
+/**
+ * @tc.name: MultiScreenDisplayStateCallbackManagerTest007
+ * @tc.desc: Test a slow subscriber neither blocks Notify nor delays the other subscribers, and is accounted
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, MultiScreenDisplayStateCallbackManagerTest007, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "MultiScreenDisplayStateCallbackManagerTest007 function start!");
+    class SlowMultiScreenCallback : public TestMultiScreenCallback {
+    public:
+        explicit SlowMultiScreenCallback(DisplayServiceTest::DeliveryGate& gate)
+            : TestMultiScreenCallback(true), gate_(gate) {}
+        void OnMultiScreenDisplayStateChanged(uint64_t screenId, const std::string& screenName,
+            DisplayPowerMgr::DisplayState state, DisplayPowerMgr::MultiScreenStateChangeReason reason) override
+        {
+            g_deliveryClockMs += SLOW_DELIVERY_COST_MS;
+            gate_.Enter();
+            TestMultiScreenCallback::OnMultiScreenDisplayStateChanged(screenId, screenName, state, reason);
+        }
+    private:
+        DisplayServiceTest::DeliveryGate& gate_;
+    };
+    MultiScreenDisplayStateCallbackManager mgr;
+    DisplayServiceTest::DeliveryGate gate;
+    sptr<SlowMultiScreenCallback> slowCb = new SlowMultiScreenCallback(gate);
+    sptr<TestMultiScreenCallback> cb = new TestMultiScreenCallback(true);
+    mgr.deliveryPolicy_ = SlowDeliveryPolicy();
+    EXPECT_TRUE(mgr.Register(slowCb->AsObject(), SCREEN_ID_ALL));
+    mgr.deliveryPolicy_ = FastDeliveryPolicy();
+    EXPECT_TRUE(mgr.Register(cb->AsObject(), MAIN_SCREEN_ID));
+
+    mgr.Notify(MAIN_SCREEN_ID, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_OFF, DEFAULT_REASON);
+    // Notify returns and the other subscriber is served while the slow one is held inside its delivery
+    EXPECT_TRUE(gate.WaitEntered(CALLBACK_WAIT_TIMEOUT_MS));
+    mgr.Notify(MAIN_SCREEN_ID, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_ON, DEFAULT_REASON);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CALLBACK_WAIT_TIMEOUT_MS);
+    while (cb->callCount_ < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(cb->callCount_, 2);
+    EXPECT_EQ(slowCb->callCount_, 0);
+    gate.Release();
+
+    EXPECT_TRUE(mgr.WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
+    EXPECT_EQ(cb->callCount_, 2);
+    EXPECT_EQ(slowCb->callCount_, 2);
+    EXPECT_EQ(slowCb->lastState_, DisplayPowerMgr::DisplayState::DISPLAY_ON);
+    EXPECT_EQ(mgr.subscribers_[slowCb->AsObject()]->mailbox->GetStats().slow, 2U);
+    EXPECT_EQ(mgr.subscribers_[cb->AsObject()]->mailbox->GetStats().slow, 0U);
+
+    std::string dump;
+    mgr.Dump(dump);
+    EXPECT_NE(dump.find("Slow=2"), std::string::npos);
+    mgr.RemoveAll(slowCb->AsObject());
+    mgr.RemoveAll(cb->AsObject());
+    DISPLAY_HILOGI(LABEL_TEST, "MultiScreenDisplayStateCallbackManagerTest007 function end!");
+}
+
+/**
+ * @tc.name: MultiScreenDisplayStateCallbackManagerTest008
+ * @tc.desc: Test a subscriber missing the deadline several times in a row is quarantined and removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, MultiScreenDisplayStateCallbackManagerTest008, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "MultiScreenDisplayStateCallbackManagerTest008 function start!");
+    class SlowMultiScreenCallback : public TestMultiScreenCallback {
+    public:
+        SlowMultiScreenCallback() : TestMultiScreenCallback(true) {}
+        void OnMultiScreenDisplayStateChanged(uint64_t screenId, const std::string& screenName,
+            DisplayPowerMgr::DisplayState state, DisplayPowerMgr::MultiScreenStateChangeReason reason) override
+        {
+            g_deliveryClockMs += SLOW_DELIVERY_COST_MS;
+            TestMultiScreenCallback::OnMultiScreenDisplayStateChanged(screenId, screenName, state, reason);
+        }
+    };
+    auto mgr = std::make_shared<MultiScreenDisplayStateCallbackManager>();
+    sptr<SlowMultiScreenCallback> slowCb = new SlowMultiScreenCallback();
+    mgr->deliveryPolicy_ = SlowDeliveryPolicy();
+    EXPECT_TRUE(mgr->Register(slowCb->AsObject(), SCREEN_ID_ALL));
+    auto mailbox = mgr->subscribers_[slowCb->AsObject()]->mailbox;
+
+    for (uint64_t screenId : {MAIN_SCREEN_ID, SECOND_SCREEN_ID, THIRD_SCREEN_ID, FOURTH_SCREEN_ID}) {
+        mgr->Notify(screenId, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_ON, DEFAULT_REASON);
+    }
+    EXPECT_TRUE(mgr->WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
+    EXPECT_EQ(slowCb->callCount_, 3);
+    EXPECT_TRUE(mailbox->GetStats().isQuarantined);
+
+    // The subscriber is removed by an FFRT task
+    auto isRemoved = [&mgr] {
+        std::string dump;
+        mgr->Dump(dump);
+        return dump.find("Multi Screen Callbacks: 0") != std::string::npos;
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CALLBACK_WAIT_TIMEOUT_MS);
+    while (!isRemoved() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(isRemoved());
+    mgr->Notify(MAIN_SCREEN_ID, TEST_SCREEN_NAME, DisplayPowerMgr::DisplayState::DISPLAY_OFF, DEFAULT_REASON);
+    EXPECT_TRUE(mgr->WaitForDeliveries(CALLBACK_WAIT_TIMEOUT_MS));
+    EXPECT_EQ(slowCb->callCount_, 3);
+    DISPLAY_HILOGI(LABEL_TEST, "MultiScreenDisplayStateCallbackManagerTest008 function end!");
+}
+
 /**
  * @tc.name: CommonEventTest001
  * @tc.desc: Test common event published with correct parameters after SetMultiScreenDisplayState
@@ -1831,4 +2166,421 @@ HWTEST_F(DisplayServiceTest, CommonEventTest001, TestSize.Level1)
     DISPLAY_HILOGI(LABEL_TEST, "CommonEventTest001 function end!");
 }
 #endif
+
+/**
+ * @tc.name: DisplayServiceContinuousBrightnessTest001
+ * @tc.desc: test continuous brightness values are coalesced and a final value drops the pending one
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayServiceContinuousBrightnessTest001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceContinuousBrightnessTest001 function start!");
+    EXPECT_TRUE(g_service != nullptr);
+    uint64_t dropped = g_service->continuousBrightnessDropped_;
+    bool result = false;
+    int32_t displayError = 0;
+    g_service->SetBrightness(BRIGHTNESS_SETTING_VALUE, DISPLAY_ID, true, result, displayError);
+    g_service->SetBrightness(BRIGHTNESS_SETTING_VALUE + 1, DISPLAY_ID, true, result, displayError);
+    g_service->SetBrightness(BRIGHTNESS_SETTING_VALUE + 2, DISPLAY_ID, true, result, displayError);
+    EXPECT_TRUE(result);
+    EXPECT_GE(g_service->continuousBrightnessDropped_, dropped + 1);
+
+    g_service->SetBrightness(BRIGHTNESS_OVERRIDE_VALUE, DISPLAY_ID, false, result, displayError);
+    {
+        std::lock_guard lock(g_service->continuousBrightnessMutex_);
+        EXPECT_EQ(g_service->pendingContinuousBrightness_.count(DISPLAY_ID), 0U);
+    }
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceContinuousBrightnessTest001 function end!");
+}
+
+/**
+ * @tc.name: DisplayServiceContinuousBrightnessTest002
+ * @tc.desc: test the first continuous value waiting for the brightness locks is dropped by a later final value
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayServiceContinuousBrightnessTest002, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceContinuousBrightnessTest002 function start!");
+    EXPECT_TRUE(g_service != nullptr);
+    std::unique_lock batchLock(g_service->brightnessBatchMutex_);
+    {
+        std::lock_guard lock(g_service->continuousBrightnessMutex_);
+        g_service->isContinuousBrightnessScheduled_ = false;
+        g_service->pendingContinuousBrightness_.clear();
+    }
+    uint64_t applied = g_service->continuousBrightnessApplied_;
+    std::thread drag([]() { EXPECT_TRUE(g_service->SetContinuousBrightness(BRIGHTNESS_SETTING_VALUE, DISPLAY_ID)); });
+    bool isPending = false;
+    while (!isPending) {
+        std::this_thread::yield();
+        std::lock_guard lock(g_service->continuousBrightnessMutex_);
+        isPending = g_service->pendingContinuousBrightness_.count(DISPLAY_ID) != 0;
+    }
+    // The final value gets the locks first, as SetBrightnessInner does
+    EXPECT_TRUE(g_service->SetBrightnessInternal(BRIGHTNESS_OVERRIDE_VALUE, DISPLAY_ID));
+    batchLock.unlock();
+    drag.join();
+    EXPECT_EQ(g_service->continuousBrightnessApplied_, applied);
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceContinuousBrightnessTest002 function end!");
+}
+
+/**
+ * @tc.name: DisplayServiceControllerRegistryTest001
+ * @tc.desc: test controller lookups stay valid while screens are added and removed on another thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayServiceControllerRegistryTest001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceControllerRegistryTest001 function start!");
+    constexpr uint64_t hotplugId = 3309;
+    constexpr int32_t hotplugCount = 200;
+    ControllerRegistry<int32_t> registry;
+    EXPECT_TRUE(registry.Emplace(DISPLAY_MAIN_ID, std::make_shared<int32_t>(DISPLAY_MAIN_ID)));
+    EXPECT_FALSE(registry.Emplace(DISPLAY_MAIN_ID, std::make_shared<int32_t>(0)));
+
+    std::atomic<bool> stop {false};
+    std::atomic<int32_t> misses {0};
+    std::thread reader([&registry, &stop, &misses]() {
+        while (!stop.load()) {
+            auto controller = registry.Find(DISPLAY_MAIN_ID);
+            if (controller == nullptr || *controller != static_cast<int32_t>(DISPLAY_MAIN_ID)) {
+                misses++;
+            }
+        }
+    });
+    for (int32_t i = 0; i < hotplugCount; i++) {
+        registry.FindOrEmplace(hotplugId, []() { return std::make_shared<int32_t>(static_cast<int32_t>(hotplugId)); });
+        EXPECT_TRUE(registry.Erase(hotplugId));
+    }
+    stop.store(true);
+    reader.join();
+    EXPECT_EQ(misses.load(), 0);
+    EXPECT_EQ(registry.Size(), 1U);
+    EXPECT_EQ(registry.GetIds().front(), DISPLAY_MAIN_ID);
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayServiceControllerRegistryTest001 function end!");
+}
+
+/**
+ * @tc.name: DisplayStateMachineTest001
+ * @tc.desc: test transition lookups by reason class and transition metrics
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayStateMachineTest001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayStateMachineTest001 function start!");
+    const uint32_t normalReason = static_cast<uint32_t>(PowerMgr::StateChangeReason::STATE_CHANGE_REASON_TIMEOUT);
+    const uint32_t preBrightReason =
+        static_cast<uint32_t>(PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT);
+    const uint32_t authFailReason =
+        static_cast<uint32_t>(PowerMgr::StateChangeReason::STATE_CHANGE_REASON_PRE_BRIGHT_AUTH_FAIL_SCREEN_OFF);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_ON, DisplayState::DISPLAY_ON, normalReason),
+        DisplayTransitionAction::KEEP);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_ON, DisplayState::DISPLAY_OFF, normalReason),
+        DisplayTransitionAction::POWER_COMMIT);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_ON, normalReason),
+        DisplayTransitionAction::POWER_COMMIT);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_ON, DisplayState::DISPLAY_DIM, normalReason),
+        DisplayTransitionAction::COMMIT);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_ON, preBrightReason),
+        DisplayTransitionAction::POWER_ONLY);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_ON, DisplayState::DISPLAY_DIM, preBrightReason),
+        DisplayTransitionAction::INTERRUPT);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_OFF, preBrightReason),
+        DisplayTransitionAction::KEEP);
+    EXPECT_EQ(DisplayStateMachine::GetAction(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_OFF, authFailReason),
+        DisplayTransitionAction::POWER_ONLY);
+    // OFF and DOZE are deferred by an overridden display off delay whatever the current state and reason
+    EXPECT_TRUE(DisplayStateMachine::IsDeferrable(DisplayState::DISPLAY_OFF));
+    EXPECT_TRUE(DisplayStateMachine::IsDeferrable(DisplayState::DISPLAY_DOZE));
+    EXPECT_FALSE(DisplayStateMachine::IsDeferrable(DisplayState::DISPLAY_ON));
+    EXPECT_FALSE(DisplayStateMachine::IsDeferrable(DisplayState::DISPLAY_DOZE_SUSPEND));
+    // Out of range states are looked up as DISPLAY_UNKNOWN
+    EXPECT_EQ(DisplayStateMachine::GetAction(static_cast<DisplayState>(100), DisplayState::DISPLAY_UNKNOWN,
+        normalReason), DisplayTransitionAction::KEEP);
+
+    DisplayTransitionMetrics metrics;
+    metrics.Record(DisplayState::DISPLAY_ON, DisplayState::DISPLAY_OFF, 150, true);
+    metrics.Record(DisplayState::DISPLAY_ON, DisplayState::DISPLAY_OFF, 2000, true);
+    metrics.Record(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_ON, 10, false);
+    EXPECT_EQ(metrics.GetCount(DisplayState::DISPLAY_ON, DisplayState::DISPLAY_OFF), 2U);
+    EXPECT_EQ(metrics.GetCount(DisplayState::DISPLAY_OFF, DisplayState::DISPLAY_ON), 0U);
+    std::string result;
+    metrics.Dump(result);
+    EXPECT_NE(result.find("Transition 2->0 Count=2 Failed=0 AvgMs=1075 MaxMs=2000 Hist=<256ms:1,>=1024ms:1"),
+        std::string::npos);
+    EXPECT_NE(result.find("Transition 0->2 Count=0 Failed=1"), std::string::npos);
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayStateMachineTest001 function end!");
+}
+
+/**
+ * @tc.name: DisplayOffDelaySchedulerTest001
+ * @tc.desc: test delayed display off is kept per display, replaced and canceled independently
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayOffDelaySchedulerTest001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayOffDelaySchedulerTest001 function start!");
+    constexpr uint32_t secondDisplayId = DISPLAY_MAIN_ID + 1;
+    constexpr uint32_t delayMs = 20;
+    std::atomic<uint32_t> expiredCount {0};
+    std::atomic<uint32_t> expiredReason {0};
+    auto onExpired = [&expiredCount, &expiredReason](uint32_t id, DisplayState state, uint32_t reason) {
+        EXPECT_EQ(id, DISPLAY_MAIN_ID);
+        EXPECT_EQ(state, DisplayState::DISPLAY_OFF);
+        expiredReason = reason;
+        expiredCount++;
+    };
+    DisplayOffDelayScheduler scheduler;
+    EXPECT_FALSE(scheduler.Schedule(DISPLAY_MAIN_ID, DisplayState::DISPLAY_OFF, 1, onExpired));
+    scheduler.Arm(DISPLAY_MAIN_ID, delayMs);
+    scheduler.Arm(secondDisplayId, delayMs);
+    EXPECT_TRUE(scheduler.Schedule(DISPLAY_MAIN_ID, DisplayState::DISPLAY_OFF, 1, onExpired));
+    // Replaces the pending request of the main display only
+    EXPECT_TRUE(scheduler.Schedule(DISPLAY_MAIN_ID, DisplayState::DISPLAY_OFF, 2, onExpired));
+    EXPECT_TRUE(scheduler.Schedule(secondDisplayId, DisplayState::DISPLAY_OFF, 1, onExpired));
+    EXPECT_TRUE(scheduler.CancelForOn(secondDisplayId));
+    EXPECT_FALSE(scheduler.IsArmed(secondDisplayId));
+    EXPECT_TRUE(scheduler.IsPending(DISPLAY_MAIN_ID));
+    std::string result;
+    scheduler.Dump(result);
+    EXPECT_NE(result.find("Scheduled=3 Replaced=1 Canceled=1 Expired=0"), std::string::npos);
+    EXPECT_NE(result.find("Display Id=0 Armed=1 DelayMs=20 PendingState=0 Reason=2"), std::string::npos);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(delayMs * 5));
+    EXPECT_EQ(expiredCount.load(), 1U);
+    EXPECT_EQ(expiredReason.load(), 2U);
+    // The expiry uses up the arm, as the baseline cleared its single delay in ScreenOffDelay
+    EXPECT_FALSE(scheduler.IsArmed(DISPLAY_MAIN_ID));
+    EXPECT_FALSE(scheduler.Schedule(DISPLAY_MAIN_ID, DisplayState::DISPLAY_OFF, 1, onExpired));
+    EXPECT_FALSE(scheduler.IsPending(DISPLAY_MAIN_ID));
+    EXPECT_FALSE(scheduler.CancelForOn(DISPLAY_MAIN_ID));
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayOffDelaySchedulerTest001 function end!");
+}
+
+/**
+ * @tc.name: DisplayOffDelaySchedulerTest002
+ * @tc.desc: test the display off delay armed for the main display follows it to another display id
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayOffDelaySchedulerTest002, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayOffDelaySchedulerTest002 function start!");
+    constexpr uint32_t secondDisplayId = DISPLAY_MAIN_ID + 1;
+    constexpr uint32_t delayMs = 20;
+    DisplayOffDelayScheduler scheduler;
+    EXPECT_FALSE(scheduler.MoveArm(DISPLAY_MAIN_ID, secondDisplayId));
+    scheduler.Arm(DISPLAY_MAIN_ID, delayMs);
+    EXPECT_TRUE(scheduler.MoveArm(DISPLAY_MAIN_ID, secondDisplayId));
+    EXPECT_FALSE(scheduler.IsArmed(DISPLAY_MAIN_ID));
+    EXPECT_TRUE(scheduler.IsArmed(secondDisplayId));
+    // A pending request stays on the display it was made for
+    EXPECT_TRUE(scheduler.Schedule(secondDisplayId, DisplayState::DISPLAY_OFF, 1, nullptr));
+    EXPECT_FALSE(scheduler.MoveArm(secondDisplayId, DISPLAY_MAIN_ID));
+    scheduler.CancelAll();
+
+    // Act: Nothing is armed, the state change of another display leaves the off delay alone
+    uint32_t mainDisplayId = g_service->GetMainDisplayIdInner();
+    uint32_t previousId = mainDisplayId + 1;
+    g_service->offDelayMainDisplayId_ = previousId;
+    g_service->FollowMainDisplayOffDelay(mainDisplayId);
+    EXPECT_FALSE(g_service->offDelayScheduler_.IsArmed(mainDisplayId));
+    EXPECT_EQ(g_service->offDelayMainDisplayId_.load(), previousId);
+
+    // Act: The service armed the main display before a fold changed the main display id
+    g_service->offDelayScheduler_.Arm(previousId, delayMs);
+    g_service->FollowMainDisplayOffDelay(mainDisplayId);
+
+    // Assert: The off request of the new main display is deferred
+    EXPECT_FALSE(g_service->offDelayScheduler_.IsArmed(previousId));
+    EXPECT_TRUE(g_service->offDelayScheduler_.IsArmed(mainDisplayId));
+    EXPECT_EQ(g_service->offDelayMainDisplayId_.load(), mainDisplayId);
+    g_service->offDelayScheduler_.CancelAll();
+
+    // Act: The fold is reported by the display mode listener before any state change of the new main display
+    g_service->offDelayScheduler_.Arm(previousId, delayMs);
+    g_service->offDelayMainDisplayId_ = previousId;
+    sptr<DisplayPowerMgrService::MainDisplayListener> listener = new DisplayPowerMgrService::MainDisplayListener();
+    listener->OnDisplayModeChanged(Rosen::FoldDisplayMode::UNKNOWN);
+
+    // Assert: The arm has already moved
+    EXPECT_FALSE(g_service->offDelayScheduler_.IsArmed(previousId));
+    EXPECT_TRUE(g_service->offDelayScheduler_.IsArmed(mainDisplayId));
+    EXPECT_EQ(g_service->offDelayMainDisplayId_.load(), mainDisplayId);
+    g_service->offDelayScheduler_.CancelAll();
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayOffDelaySchedulerTest002 function end!");
+}
+
+/**
+ * @tc.name: DisplayTraceRecorderTest001
+ * @tc.desc: test SetDisplayState is traced as one transaction and the trace is dumped as text and binary
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayTraceRecorderTest001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayTraceRecorderTest001 function start!");
+    ASSERT_TRUE(g_service != nullptr);
+    bool result = false;
+    g_service->SetDisplayState(DISPLAY_MAIN_ID, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON),
+        REASON, result);
+    auto records = DisplayTraceRecorder::Get().GetRecords();
+    ASSERT_FALSE(records.empty());
+    const DisplayTraceRecord& last = records.back();
+    EXPECT_EQ(last.event, static_cast<uint16_t>(DisplayTraceEvent::SET_DISPLAY_STATE_RETURN));
+    EXPECT_EQ(last.arg0, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON));
+    auto begin = std::find_if(records.begin(), records.end(), [&last](const DisplayTraceRecord& record) {
+        return record.transactionId == last.transactionId;
+    });
+    ASSERT_NE(begin, records.end());
+    EXPECT_EQ(begin->event, static_cast<uint16_t>(DisplayTraceEvent::SET_DISPLAY_STATE));
+    EXPECT_EQ(begin->arg1, REASON);
+    EXPECT_LE(begin->timeNs, last.timeNs);
+
+    std::string text;
+    DisplayTraceRecorder::Get().DumpText(text);
+    EXPECT_NE(text.find("Transaction " + std::to_string(last.transactionId)), std::string::npos);
+    EXPECT_NE(text.find("SetDisplayStateReturn"), std::string::npos);
+    std::string binary;
+    DisplayTraceRecorder::Get().DumpBinary(binary);
+    ASSERT_GE(binary.size(), sizeof(DisplayTraceHeader));
+    DisplayTraceHeader header;
+    std::copy(binary.begin(), binary.begin() + sizeof(header), reinterpret_cast<char*>(&header));
+    EXPECT_EQ(header.magic, DisplayTraceHeader::MAGIC);
+    EXPECT_EQ(binary.size(), sizeof(header) + header.recordCount * sizeof(DisplayTraceRecord));
+
+    int fd = 1;
+    std::vector<std::u16string> args {u"--trace"};
+    g_service->isBootCompleted_ = true;
+    EXPECT_EQ(g_service->Dump(fd, args), ERR_OK);
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayTraceRecorderTest001 function end!");
+}
+
+/**
+ * @tc.name: DisplayTraceRecorderTest002
+ * @tc.desc: test the transactions of different displays do not take each other's events
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayTraceRecorderTest002, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayTraceRecorderTest002 function start!");
+    constexpr uint32_t firstDisplayId = 100;
+    constexpr uint32_t secondDisplayId = 101;
+    constexpr uint32_t brightness = 50;
+    DisplayTraceRecorder& recorder = DisplayTraceRecorder::Get();
+    auto lastRecord = [&recorder] { return recorder.GetRecords().back(); };
+
+    // Act: The second display begins a transaction while the first one is still in its own
+    uint32_t firstId = recorder.BeginTransaction(firstDisplayId, DisplayTraceEvent::SET_DISPLAY_STATE);
+    recorder.RecordOnce(firstDisplayId, DisplayTraceEvent::SET_SCREEN_BRIGHTNESS, brightness);
+    uint32_t secondId = recorder.BeginTransaction(secondDisplayId, DisplayTraceEvent::SET_DISPLAY_STATE);
+    EXPECT_NE(firstId, secondId);
+
+    // Assert: Each display keeps its transaction and its events recorded once
+    recorder.Record(firstDisplayId, DisplayTraceEvent::SET_DISPLAY_STATE_RETURN);
+    EXPECT_EQ(lastRecord().transactionId, firstId);
+    recorder.RecordOnce(secondDisplayId, DisplayTraceEvent::SET_SCREEN_BRIGHTNESS, brightness);
+    EXPECT_EQ(lastRecord().transactionId, secondId);
+    EXPECT_EQ(lastRecord().event, static_cast<uint16_t>(DisplayTraceEvent::SET_SCREEN_BRIGHTNESS));
+    recorder.RecordOnce(firstDisplayId, DisplayTraceEvent::SET_SCREEN_BRIGHTNESS, brightness);
+    EXPECT_EQ(lastRecord().displayId, secondDisplayId);
+
+    // Assert: An asynchronous completion stays in the transaction it was started under
+    uint32_t thirdId = recorder.BeginTransaction(firstDisplayId, DisplayTraceEvent::SET_DISPLAY_STATE);
+    recorder.RecordIn(firstId, firstDisplayId, DisplayTraceEvent::SCREEN_DISPLAY_STATE_CALLBACK);
+    EXPECT_EQ(lastRecord().transactionId, firstId);
+    EXPECT_EQ(recorder.GetTransaction(firstDisplayId), thirdId);
+
+    // Assert: A display joining a transaction records in it
+    recorder.JoinTransaction(secondDisplayId, thirdId);
+    recorder.Record(secondDisplayId, DisplayTraceEvent::BRIGHTNESS_SET_DISPLAY_STATE);
+    EXPECT_EQ(lastRecord().transactionId, thirdId);
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayTraceRecorderTest002 function end!");
+}
+
+/**
+ * @tc.name: DisplayApiMetricsTest001
+ * @tc.desc: test calls and errors are counted per api, queried and reset through RunJsonCommand
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayApiMetricsTest001, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayApiMetricsTest001 function start!");
+    ASSERT_TRUE(g_service != nullptr);
+    std::string result;
+    EXPECT_EQ(g_service->RunJsonCommand(R"({"domain":"display_service","handler":"ResetApiMetrics"})", result),
+        ERR_OK);
+    EXPECT_EQ(result, R"({"ret": 0})");
+    uint32_t id = 0;
+    g_service->GetMainDisplayId(id);
+    g_service->GetMainDisplayId(id);
+    {
+        DisplayApiScope scope(DisplayApi::SET_BRIGHTNESS);
+        DisplayApiScope::ReportError(DisplayErrors::ERR_PARAM_INVALID);
+        EXPECT_EQ(DisplayApiMetrics::Get().GetSummary(DisplayApi::SET_BRIGHTNESS).inFlight, 1);
+    }
+    DisplayApiScope::ReportError(DisplayErrors::ERR_PARAM_INVALID);
+    auto summary = DisplayApiMetrics::Get().GetSummary(DisplayApi::GET_MAIN_DISPLAY_ID);
+    EXPECT_EQ(summary.calls, 2U);
+    EXPECT_EQ(summary.inFlight, 0);
+    EXPECT_LE(summary.p50Us, summary.p99Us);
+    EXPECT_LE(summary.p99Us, summary.maxUs);
+    EXPECT_EQ(DisplayApiMetrics::Get().GetErrorCount(DisplayApi::SET_BRIGHTNESS, DisplayErrors::ERR_PARAM_INVALID), 1U);
+    EXPECT_EQ(DisplayApiMetrics::Get().GetSummary(DisplayApi::SET_BRIGHTNESS).peakInFlight, 1);
+
+    EXPECT_EQ(g_service->RunJsonCommand(R"({"domain":"display_service","handler":"QueryApiMetrics"})", result),
+        ERR_OK);
+    EXPECT_NE(result.find(R"("name":"GetMainDisplayId","calls":2)"), std::string::npos);
+    EXPECT_NE(result.find(R"("errors":{"401":1})"), std::string::npos);
+    std::string dump;
+    DisplayApiMetrics::Get().Dump(dump);
+    EXPECT_NE(dump.find("GetMainDisplayId Calls=2"), std::string::npos);
+    EXPECT_NE(dump.find("Errors=1(401:1)"), std::string::npos);
+    EXPECT_EQ(g_service->RunJsonCommand(R"({"domain":"display_service","handler":"Unknown"})", result), ERR_OK);
+    EXPECT_NE(result.find(R"("ret": -1)"), std::string::npos);
+    DisplayApiMetrics::Get().Reset();
+    EXPECT_EQ(DisplayApiMetrics::Get().GetSummary(DisplayApi::GET_MAIN_DISPLAY_ID).calls, 0U);
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayApiMetricsTest001 function end!");
+}
+
+/**
+ * @tc.name: DisplayApiMetricsTest002
+ * @tc.desc: test the errors of handlers rejecting a caller or a parameter are counted for their api
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayServiceTest, DisplayApiMetricsTest002, TestSize.Level1)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayApiMetricsTest002 function start!");
+    ASSERT_TRUE(g_service != nullptr);
+    DisplayApiMetrics::Get().Reset();
+    auto errorCount = [](DisplayApi api, DisplayErrors error) {
+        return DisplayApiMetrics::Get().GetErrorCount(api, error);
+    };
+
+    // Act: A caller that is not a system application
+    g_isPermissionGranted = false;
+    bool result = true;
+    g_service->SetDisplayState(DISPLAY_MAIN_ID, static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON),
+        REASON, result);
+    EXPECT_FALSE(result);
+    g_service->OverrideDisplayOffDelay(OVERRIDE_DELAY_TIME, result);
+    EXPECT_FALSE(result);
+    EXPECT_NE(g_service->SetScreenDisplayState(DISPLAY_MAIN_ID,
+        static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_ON), REASON), ERR_OK);
+    g_isPermissionGranted = true;
+
+    // Act: A parameter out of range
+    EXPECT_NE(g_service->SetScreenDisplayState(DISPLAY_MAIN_ID,
+        static_cast<uint32_t>(DisplayPowerMgr::DisplayState::DISPLAY_DIM), REASON), ERR_OK);
+    g_service->DiscountBrightness(DISCOUNT_VALUE + 1.0, DISPLAY_MAIN_ID, result);
+    EXPECT_FALSE(result);
+
+    // Assert
+    EXPECT_EQ(errorCount(DisplayApi::SET_DISPLAY_STATE, DisplayErrors::ERR_SYSTEM_API_DENIED), 1U);
+    EXPECT_EQ(errorCount(DisplayApi::OVERRIDE_DISPLAY_OFF_DELAY, DisplayErrors::ERR_SYSTEM_API_DENIED), 1U);
+    EXPECT_EQ(errorCount(DisplayApi::SET_SCREEN_DISPLAY_STATE, DisplayErrors::ERR_SYSTEM_API_DENIED), 1U);
+    EXPECT_EQ(errorCount(DisplayApi::SET_SCREEN_DISPLAY_STATE, DisplayErrors::ERR_PARAM_INVALID), 1U);
+    EXPECT_EQ(errorCount(DisplayApi::DISCOUNT_BRIGHTNESS, DisplayErrors::ERR_PARAM_INVALID), 1U);
+    g_service->GetError();
+    DisplayApiMetrics::Get().Reset();
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayApiMetricsTest002 function end!");
+}
 } // namespace
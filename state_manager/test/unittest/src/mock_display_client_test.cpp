@@ -18,6 +18,8 @@
 #endif
 #include "mock_display_client_test.h"
 
+#include <chrono>
+#include <future>
 #include <iservice_registry.h>
 #include <system_ability_definition.h>
 #include <vector>
@@ -38,15 +40,19 @@ void DisplayPowerMgrClientMockTest::SetUp()
 {
     DisplayPowerMgrClient::GetInstance().SetDisplayState(DisplayState::DISPLAY_ON);
     g_testRemoteObj = sptr<PowerMgr::MockDisplayRemoteObject>::MakeSptr(u"DisplayPowerMgrClientMockTest");
-    mProxyBack = mClient.proxy_;
-    mClient.proxy_ = sptr<MockDisplayPowerMgrProxy>::MakeSptr(g_testRemoteObj);
+    std::lock_guard lock(mClient.mutex_);
+    mConnectionBack = mClient.connection_;
+    // The mock has no power snapshot, so every read goes to it by IPC
+    mClient.PublishConnection(std::make_shared<DisplayPowerMgrClient::Connection>(
+        sptr<MockDisplayPowerMgrProxy>::MakeSptr(g_testRemoteObj)));
 }
 
 void DisplayPowerMgrClientMockTest::TearDown()
 {
     DisplayPowerMgrClient::GetInstance().SetDisplayState(DisplayState::DISPLAY_OFF);
     g_testRemoteObj = nullptr;
-    mClient.proxy_ = mProxyBack;
+    std::lock_guard lock(mClient.mutex_);
+    mClient.PublishConnection(mConnectionBack);
 }
 
 void DisplayPowerMgrClientMockTest::DisplayPowerMgrTestCallback::OnDisplayStateChanged(
@@ -524,4 +530,33 @@ HWTEST_F(DisplayPowerMgrClientMockTest, DisplayPowerMgrClient031, TestSize.Level
     EXPECT_TRUE(ret);
     DISPLAY_HILOGI(LABEL_TEST, "DisplayPowerMgrClient031 function end!");
 }
+
+/**
+ * @tc.name: DisplayPowerMgrClient032
+ * @tc.desc: test asynchronous requests complete with the failure when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DisplayPowerMgrClientMockTest, DisplayPowerMgrClient032, TestSize.Level0)
+{
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayPowerMgrClient032 function start!");
+    constexpr auto ASYNC_TIMEOUT = std::chrono::seconds(1);
+    const uint32_t SET_BRIGHTNESS = 150;
+    EXPECT_FALSE(mClient.SetBrightnessAsync(SET_BRIGHTNESS, 0, true));
+
+    auto future = mClient.SetDisplayStateAsync(DisplayState::DISPLAY_ON);
+    ASSERT_EQ(future.wait_for(ASYNC_TIMEOUT), std::future_status::ready);
+    EXPECT_FALSE(future.get());
+
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto callbackFuture = promise->get_future();
+    std::vector<BrightnessCommand> commands = { {BrightnessCommandType::GET_BRIGHTNESS, 0, 0, 0} };
+    mClient.ExecuteBrightnessCommandsAsync(commands,
+        [promise](bool result, const std::vector<BrightnessCommandResult>& results) {
+            promise->set_value(result);
+        });
+    ASSERT_EQ(callbackFuture.wait_for(ASYNC_TIMEOUT), std::future_status::ready);
+    EXPECT_FALSE(callbackFuture.get());
+    DISPLAY_HILOGI(LABEL_TEST, "DisplayPowerMgrClient032 function end!");
+}
 } // namespace
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISPLAY_POWER_SNAPSHOT_H
+#define DISPLAY_POWER_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef F_SEAL_FUTURE_WRITE
+#define F_SEAL_FUTURE_WRITE 0x0010
+#endif
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+enum DisplayPowerSnapshotFlag : uint32_t {
+    SNAPSHOT_STATE_VALID = 1U << 0,
+    SNAPSHOT_BRIGHTNESS_VALID = 1U << 1,
+    SNAPSHOT_DEVICE_BRIGHTNESS_VALID = 1U << 2,
+    SNAPSHOT_AUTO_ADJUST_VALID = 1U << 3,
+    SNAPSHOT_AUTO_ADJUST = 1U << 4,
+    SNAPSHOT_OVERRIDDEN = 1U << 5,
+    SNAPSHOT_BOOSTED = 1U << 6,
+    SNAPSHOT_LUX_VALID = 1U << 7,
+};
+
+// Per-display values published by DisplayPowerMgrService and read by clients without IPC
+struct DisplayPowerSnapshotData {
+    uint32_t displayId {0};
+    int32_t state {0};
+    uint32_t brightness {0};
+    uint32_t deviceBrightness {0};
+    uint32_t deviceBrightnessHbm {0};
+    double discount {1.0};
+    uint32_t flags {0};
+    uint32_t generation {0};
+};
+
+// Ambient light estimates of the brightness service, valid only while its light sensor is active.
+// Another service reading them does not need to subscribe to the light sensor itself.
+struct DisplayLuxSnapshotData {
+    float lux {0.0f};  // Last sensor sample
+    float filteredLux {0.0f};  // Smoothed over the recent samples
+    float smoothedLux {0.0f};  // Stable value the brightness follows, changes only past the thresholds
+    uint32_t flags {0};
+    uint32_t generation {0};
+};
+
+// Shared memory layout. Every slot is a seqlock: the sequence is odd while the single writer updates
+// the slot, and a reader retries until it sees the same even sequence before and after copying.
+// Only 32-bit atomics are used so that reads stay plain loads on a read-only mapping.
+struct DisplayPowerSnapshotSlot {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> displayId;
+    std::atomic<int32_t> state;
+    std::atomic<uint32_t> brightness;
+    std::atomic<uint32_t> deviceBrightness;
+    std::atomic<uint32_t> deviceBrightnessHbm;
+    std::atomic<uint32_t> discountLow;
+    std::atomic<uint32_t> discountHigh;
+    std::atomic<uint32_t> flags;
+};
+
+// Lux values are stored as their bit patterns
+struct DisplayLuxSnapshotSlot {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> lux;
+    std::atomic<uint32_t> filteredLux;
+    std::atomic<uint32_t> smoothedLux;
+    std::atomic<uint32_t> flags;
+};
+
+struct DisplayPowerSnapshotRegion {
+    static constexpr uint32_t MAGIC = 0x44505353; // "DPSS"
+    static constexpr uint32_t VERSION = 3;
+    static constexpr uint32_t MAX_SLOTS = 8;
+
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> slotCount;
+    // Bumped whenever the brightness limits or the main display may have changed, such as on boot
+    // completion or a fold display mode switch. Clients refetch their cached limits when it moves.
+    std::atomic<uint32_t> limitsGeneration;
+    DisplayPowerSnapshotSlot slots[MAX_SLOTS];
+    DisplayLuxSnapshotSlot luxSlot;
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "snapshot atomics must be address free");
+
+class DisplayPowerSnapshotWriter {
+public:
+    DisplayPowerSnapshotWriter() = default;
+    DisplayPowerSnapshotWriter(const DisplayPowerSnapshotWriter&) = delete;
+    DisplayPowerSnapshotWriter& operator=(const DisplayPowerSnapshotWriter&) = delete;
+    ~DisplayPowerSnapshotWriter()
+    {
+        if (region_ != nullptr) {
+            munmap(region_, sizeof(DisplayPowerSnapshotRegion));
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    bool Create()
+    {
+        std::lock_guard lock(mutex_);
+        if (region_ != nullptr) {
+            return true;
+        }
+        int fd = memfd_create("display_power_snapshot", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, sizeof(DisplayPowerSnapshotRegion)) != 0) {
+            close(fd);
+            return false;
+        }
+        void* addr = mmap(nullptr, sizeof(DisplayPowerSnapshotRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        // Readers can neither resize the region nor map it writable. Only this mapping, made before the
+        // seals, stays writable. A kernel that cannot seal gets no snapshot, clients then fall back to IPC.
+        if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_FUTURE_WRITE | F_SEAL_SEAL) != 0) {
+            munmap(addr, sizeof(DisplayPowerSnapshotRegion));
+            close(fd);
+            return false;
+        }
+        region_ = new (addr) DisplayPowerSnapshotRegion {};
+        region_->magic = DisplayPowerSnapshotRegion::MAGIC;
+        region_->version = DisplayPowerSnapshotRegion::VERSION;
+        fd_ = fd;
+        return true;
+    }
+
+    // Returns a new read-only descriptor owned by the caller, or -1 if the region does not exist.
+    // It is opened afresh rather than duplicated, so it does not share the writable file description.
+    int DupFd() const
+    {
+        if (fd_ < 0) {
+            return -1;
+        }
+        char path[PROC_FD_PATH_SIZE] = {0};
+        if (snprintf(path, sizeof(path), "/proc/self/fd/%d", fd_) <= 0) {
+            return -1;
+        }
+        return open(path, O_RDONLY | O_CLOEXEC);
+    }
+
+    bool Publish(const DisplayPowerSnapshotData& data)
+    {
+        std::lock_guard lock(mutex_);
+        if (region_ == nullptr) {
+            return false;
+        }
+        DisplayPowerSnapshotSlot* slot = FindOrAddSlot(data.displayId);
+        if (slot == nullptr) {
+            return false;
+        }
+        uint64_t discountBits = 0;
+        static_assert(sizeof(discountBits) == sizeof(data.discount));
+        std::memcpy(&discountBits, &data.discount, sizeof(discountBits));
+        uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot->state.store(data.state, std::memory_order_relaxed);
+        slot->brightness.store(data.brightness, std::memory_order_relaxed);
+        slot->deviceBrightness.store(data.deviceBrightness, std::memory_order_relaxed);
+        slot->deviceBrightnessHbm.store(data.deviceBrightnessHbm, std::memory_order_relaxed);
+        slot->discountLow.store(static_cast<uint32_t>(discountBits), std::memory_order_relaxed);
+        slot->discountHigh.store(static_cast<uint32_t>(discountBits >> 32), std::memory_order_relaxed);
+        slot->flags.store(data.flags, std::memory_order_relaxed);
+        slot->sequence.store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+
+    bool InvalidateLimits()
+    {
+        std::lock_guard lock(mutex_);
+        if (region_ == nullptr) {
+            return false;
+        }
+        region_->limitsGeneration.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    bool PublishLux(const DisplayLuxSnapshotData& data)
+    {
+        std::lock_guard lock(mutex_);
+        if (region_ == nullptr) {
+            return false;
+        }
+        DisplayLuxSnapshotSlot& slot = region_->luxSlot;
+        uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.lux.store(ToBits(data.lux), std::memory_order_relaxed);
+        slot.filteredLux.store(ToBits(data.filteredLux), std::memory_order_relaxed);
+        slot.smoothedLux.store(ToBits(data.smoothedLux), std::memory_order_relaxed);
+        slot.flags.store(data.flags, std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t PROC_FD_PATH_SIZE = 32;
+
+    static uint32_t ToBits(float value)
+    {
+        uint32_t bits = 0;
+        static_assert(sizeof(bits) == sizeof(value));
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    DisplayPowerSnapshotSlot* FindOrAddSlot(uint32_t displayId)
+    {
+        uint32_t count = region_->slotCount.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < count; i++) {
+            if (region_->slots[i].displayId.load(std::memory_order_relaxed) == displayId) {
+                return &region_->slots[i];
+            }
+        }
+        if (count >= DisplayPowerSnapshotRegion::MAX_SLOTS) {
+            return nullptr;
+        }
+        // A new slot has no valid flags until its first Publish completes, so readers fall back to IPC
+        region_->slots[count].displayId.store(displayId, std::memory_order_relaxed);
+        region_->slotCount.store(count + 1, std::memory_order_release);
+        return &region_->slots[count];
+    }
+
+    std::mutex mutex_;
+    int fd_ {-1};
+    DisplayPowerSnapshotRegion* region_ {nullptr};
+};
+
+class DisplayPowerSnapshotReader {
+public:
+    DisplayPowerSnapshotReader() = default;
+    DisplayPowerSnapshotReader(const DisplayPowerSnapshotReader&) = delete;
+    DisplayPowerSnapshotReader& operator=(const DisplayPowerSnapshotReader&) = delete;
+    ~DisplayPowerSnapshotReader()
+    {
+        if (region_ != nullptr) {
+            munmap(const_cast<DisplayPowerSnapshotRegion*>(region_), sizeof(DisplayPowerSnapshotRegion));
+        }
+    }
+
+    // Maps the region read-only. The descriptor is closed in all cases.
+    bool Map(int fd)
+    {
+        if (fd < 0) {
+            return false;
+        }
+        void* addr = mmap(nullptr, sizeof(DisplayPowerSnapshotRegion), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        auto region = static_cast<const DisplayPowerSnapshotRegion*>(addr);
+        if (region->magic != DisplayPowerSnapshotRegion::MAGIC ||
+            region->version != DisplayPowerSnapshotRegion::VERSION) {
+            munmap(addr, sizeof(DisplayPowerSnapshotRegion));
+            return false;
+        }
+        region_ = region;
+        return true;
+    }
+
+    bool Read(uint32_t displayId, DisplayPowerSnapshotData& data) const
+    {
+        if (region_ == nullptr) {
+            return false;
+        }
+        uint32_t count = region_->slotCount.load(std::memory_order_acquire);
+        if (count > DisplayPowerSnapshotRegion::MAX_SLOTS) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            const DisplayPowerSnapshotSlot& slot = region_->slots[i];
+            if (slot.displayId.load(std::memory_order_relaxed) == displayId) {
+                return ReadSlot(slot, data);
+            }
+        }
+        return false;
+    }
+
+    bool ReadLimitsGeneration(uint32_t& generation) const
+    {
+        if (region_ == nullptr) {
+            return false;
+        }
+        generation = region_->limitsGeneration.load(std::memory_order_acquire);
+        return true;
+    }
+
+    bool ReadLux(DisplayLuxSnapshotData& data) const
+    {
+        if (region_ == nullptr) {
+            return false;
+        }
+        const DisplayLuxSnapshotSlot& slot = region_->luxSlot;
+        for (int32_t retry = 0; retry < MAX_READ_RETRY; retry++) {
+            uint32_t begin = slot.sequence.load(std::memory_order_acquire);
+            if ((begin & 1U) != 0) {
+                continue;
+            }
+            uint32_t lux = slot.lux.load(std::memory_order_relaxed);
+            uint32_t filteredLux = slot.filteredLux.load(std::memory_order_relaxed);
+            uint32_t smoothedLux = slot.smoothedLux.load(std::memory_order_relaxed);
+            uint32_t flags = slot.flags.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != begin) {
+                continue;
+            }
+            DisplayLuxSnapshotData copy;
+            std::memcpy(&copy.lux, &lux, sizeof(copy.lux));
+            std::memcpy(&copy.filteredLux, &filteredLux, sizeof(copy.filteredLux));
+            std::memcpy(&copy.smoothedLux, &smoothedLux, sizeof(copy.smoothedLux));
+            copy.flags = flags;
+            copy.generation = begin / 2;
+            data = copy;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    static constexpr int32_t MAX_READ_RETRY = 16;
+
+    static bool ReadSlot(const DisplayPowerSnapshotSlot& slot, DisplayPowerSnapshotData& data)
+    {
+        for (int32_t retry = 0; retry < MAX_READ_RETRY; retry++) {
+            uint32_t begin = slot.sequence.load(std::memory_order_acquire);
+            if ((begin & 1U) != 0) {
+                continue;
+            }
+            DisplayPowerSnapshotData copy;
+            copy.displayId = slot.displayId.load(std::memory_order_relaxed);
+            copy.state = slot.state.load(std::memory_order_relaxed);
+            copy.brightness = slot.brightness.load(std::memory_order_relaxed);
+            copy.deviceBrightness = slot.deviceBrightness.load(std::memory_order_relaxed);
+            copy.deviceBrightnessHbm = slot.deviceBrightnessHbm.load(std::memory_order_relaxed);
+            uint64_t discountBits = slot.discountLow.load(std::memory_order_relaxed) |
+                (static_cast<uint64_t>(slot.discountHigh.load(std::memory_order_relaxed)) << 32);
+            copy.flags = slot.flags.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != begin) {
+                continue;
+            }
+            std::memcpy(&copy.discount, &discountBits, sizeof(copy.discount));
+            copy.generation = begin / 2;
+            data = copy;
+            return true;
+        }
+        return false;
+    }
+
+    const DisplayPowerSnapshotRegion* region_ {nullptr};
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // DISPLAY_POWER_SNAPSHOT_H
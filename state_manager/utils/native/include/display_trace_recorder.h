@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISPLAY_TRACE_RECORDER_H
+#define DISPLAY_TRACE_RECORDER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace DisplayPowerMgr {
+// Points of a display state change, in the order they are usually reached when the screen turns on
+enum class DisplayTraceEvent : uint16_t {
+    NONE = 0,
+    SET_DISPLAY_STATE,              // IPC arrived in SetDisplayState, arg0 state, arg1 reason
+    SET_DISPLAY_STATE_RETURN,       // SetDisplayState returns, arg0 state, arg1 result
+    BRIGHTNESS_SET_DISPLAY_STATE,   // BrightnessManager::SetDisplayState, arg0 state, arg1 reason
+    SCREEN_SET_DISPLAY_STATE,       // ScreenAction::SetDisplayState calls the display manager, arg0 state
+    SCREEN_SET_DISPLAY_STATE_RETURN, // The display manager returned, arg0 state, arg1 result
+    SCREEN_DISPLAY_STATE_CALLBACK,  // The display manager reports the state is reached, arg0 state
+    SET_SCREEN_ON_BRIGHTNESS,       // BrightnessManager::SetScreenOnBrightness
+    FIRST_LUX_WAIT,                 // The screen on brightness waits for the first lux, arg0 brightness, arg1 max wait
+    FIRST_LUX,                      // The first lux ended the wait, arg0 lux, arg1 brightness
+    FIRST_LUX_TIMEOUT,              // No lux came in time, arg0 brightness
+    SET_SCREEN_BRIGHTNESS,          // First brightness written after the change began, arg0 brightness
+    COUNT,
+};
+
+// Record layout of the binary dump, in host byte order
+struct DisplayTraceRecord {
+    uint64_t timeNs {0};  // CLOCK_MONOTONIC
+    uint32_t sequence {0};  // Low bits of the record index, a gap means records were lost
+    uint32_t transactionId {0};
+    uint32_t displayId {0};
+    uint16_t event {0};
+    uint16_t reserved {0};
+    uint32_t arg0 {0};
+    uint32_t arg1 {0};
+};
+static_assert(sizeof(DisplayTraceRecord) == 32, "binary trace records are 32 bytes");
+
+// Header of the binary dump, followed by recordCount records of recordSize bytes in record order
+struct DisplayTraceHeader {
+    static constexpr uint32_t MAGIC = 0x44545243; // "DTRC"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic {MAGIC};
+    uint32_t version {VERSION};
+    uint32_t recordSize {sizeof(DisplayTraceRecord)};
+    uint32_t recordCount {0};
+    uint64_t recorded {0};
+    uint64_t dropped {0};
+};
+static_assert(sizeof(DisplayTraceHeader) == 32, "binary trace header is 32 bytes");
+
+// Flight recorder of display state changes. Every SetDisplayState request begins a transaction of its display,
+// the events of that display recorded until its next one carry its id, so that requests of different displays do
+// not steal each other's events. Work finishing asynchronously records with the id it was started under.
+// Records go to a fixed ring without locks: a writer takes the next index and owns its slot while the slot
+// sequence is odd, a reader keeps a slot only if the sequence shows the expected index before and after copying
+// it. A writer that cannot take its slot drops its event.
+class DisplayTraceRecorder {
+public:
+    static constexpr size_t CAPACITY = 512;
+
+    static DisplayTraceRecorder& Get()
+    {
+        static DisplayTraceRecorder instance;
+        return instance;
+    }
+
+    uint32_t BeginTransaction(uint32_t displayId, DisplayTraceEvent event, uint32_t arg0 = 0, uint32_t arg1 = 0)
+    {
+        uint32_t transactionId = nextTransaction_.fetch_add(1, std::memory_order_relaxed) + 1;
+        JoinTransaction(displayId, transactionId);
+        Write(transactionId, displayId, event, arg0, arg1);
+        return transactionId;
+    }
+
+    // Makes the events of displayId carry transactionId, e.g. once a request of the default display id is found
+    // to be for another display
+    void JoinTransaction(uint32_t displayId, uint32_t transactionId)
+    {
+        Lane& lane = GetLane(displayId, true);
+        lane.recordedOnce.store(0, std::memory_order_relaxed);
+        lane.transactionId.store(transactionId, std::memory_order_relaxed);
+    }
+
+    // The current transaction of the display, 0 if it has none
+    uint32_t GetTransaction(uint32_t displayId)
+    {
+        return GetLane(displayId, false).transactionId.load(std::memory_order_relaxed);
+    }
+
+    void Record(uint32_t displayId, DisplayTraceEvent event, uint32_t arg0 = 0, uint32_t arg1 = 0)
+    {
+        Write(GetTransaction(displayId), displayId, event, arg0, arg1);
+    }
+
+    // Records in the given transaction rather than the current one of the display, for asynchronous completions
+    void RecordIn(uint32_t transactionId, uint32_t displayId, DisplayTraceEvent event, uint32_t arg0 = 0,
+        uint32_t arg1 = 0)
+    {
+        Write(transactionId, displayId, event, arg0, arg1);
+    }
+
+    // Records only the first event of its kind in the current transaction of the display, for points reached
+    // repeatedly
+    void RecordOnce(uint32_t displayId, DisplayTraceEvent event, uint32_t arg0 = 0, uint32_t arg1 = 0)
+    {
+        Lane& lane = GetLane(displayId, false);
+        uint32_t bit = 1U << static_cast<uint32_t>(event);
+        if ((lane.recordedOnce.load(std::memory_order_relaxed) & bit) != 0 ||
+            (lane.recordedOnce.fetch_or(bit, std::memory_order_relaxed) & bit) != 0) {
+            return;
+        }
+        Write(lane.transactionId.load(std::memory_order_relaxed), displayId, event, arg0, arg1);
+    }
+
+    // Records still in the ring, oldest first
+    std::vector<DisplayTraceRecord> GetRecords() const
+    {
+        std::vector<DisplayTraceRecord> records;
+        uint64_t head = head_.load(std::memory_order_acquire);
+        uint64_t first = head > CAPACITY ? head - CAPACITY : 0;
+        records.reserve(head - first);
+        for (uint64_t index = first; index < head; index++) {
+            DisplayTraceRecord record;
+            if (ReadSlot(index, record)) {
+                records.push_back(record);
+            }
+        }
+        return records;
+    }
+
+    void DumpText(std::string& result) const
+    {
+        std::vector<DisplayTraceRecord> records = GetRecords();
+        AppendSummary(result);
+        // Transactions in the order they began, with the time of each event since the first one
+        std::vector<uint32_t> transactions;
+        for (const auto& record : records) {
+            if (std::find(transactions.begin(), transactions.end(), record.transactionId) == transactions.end()) {
+                transactions.push_back(record.transactionId);
+            }
+        }
+        char line[LINE_SIZE];
+        for (uint32_t transactionId : transactions) {
+            uint64_t beginNs = 0;
+            bool isFirst = true;
+            for (const auto& record : records) {
+                if (record.transactionId != transactionId) {
+                    continue;
+                }
+                if (isFirst) {
+                    beginNs = record.timeNs;
+                    result.append("  Transaction ").append(std::to_string(transactionId)).append("\n");
+                    isFirst = false;
+                }
+                uint64_t offsetUs = (record.timeNs - beginNs) / NS_PER_US;
+                int size = snprintf(line, sizeof(line), "    +%" PRIu64 ".%03" PRIu64 "ms Display=%u %s Args=%u,%u\n",
+                    offsetUs / US_PER_MS, offsetUs % US_PER_MS, record.displayId, GetEventName(record.event),
+                    record.arg0, record.arg1);
+                if (size > 0) {
+                    result.append(line, std::min(static_cast<size_t>(size), sizeof(line) - 1));
+                }
+            }
+        }
+    }
+
+    // DisplayTraceHeader followed by the records, see DisplayTraceRecord
+    void DumpBinary(std::string& result) const
+    {
+        std::vector<DisplayTraceRecord> records = GetRecords();
+        DisplayTraceHeader header;
+        header.recordCount = static_cast<uint32_t>(records.size());
+        header.recorded = head_.load(std::memory_order_relaxed);
+        header.dropped = dropped_.load(std::memory_order_relaxed);
+        result.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!records.empty()) {
+            result.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(DisplayTraceRecord));
+        }
+    }
+
+    void AppendSummary(std::string& result) const
+    {
+        result.append("Display Trace: Transactions=")
+            .append(std::to_string(nextTransaction_.load(std::memory_order_relaxed)));
+        result.append(" Recorded=").append(std::to_string(head_.load(std::memory_order_relaxed)));
+        result.append(" Dropped=").append(std::to_string(dropped_.load(std::memory_order_relaxed)));
+        result.append(" Capacity=").append(std::to_string(CAPACITY)).append("\n");
+    }
+
+    static const char* GetEventName(uint16_t event)
+    {
+        static constexpr std::array<const char*, static_cast<size_t>(DisplayTraceEvent::COUNT)> NAMES {
+            "None",
+            "SetDisplayState",
+            "SetDisplayStateReturn",
+            "BrightnessSetDisplayState",
+            "ScreenSetDisplayState",
+            "ScreenSetDisplayStateReturn",
+            "ScreenDisplayStateCallback",
+            "SetScreenOnBrightness",
+            "FirstLuxWait",
+            "FirstLux",
+            "FirstLuxTimeout",
+            "SetScreenBrightness",
+        };
+        return event < NAMES.size() ? NAMES[event] : "Unknown";
+    }
+
+private:
+    static constexpr uint64_t NS_PER_US = 1000;
+    static constexpr uint64_t US_PER_MS = 1000;
+    static constexpr size_t LINE_SIZE = 128;
+    static constexpr size_t MAX_LANES = 8;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity is a power of two");
+    static_assert(static_cast<size_t>(DisplayTraceEvent::COUNT) <= 32, "event bits fit RecordOnce");
+
+    // The sequence is 2 * index + 1 while the record of index is written and 2 * index + 2 once it is complete
+    struct Slot {
+        std::atomic<uint64_t> sequence {0};
+        std::atomic<uint64_t> timeNs {0};
+        std::atomic<uint32_t> transactionId {0};
+        std::atomic<uint32_t> displayId {0};
+        std::atomic<uint32_t> event {0};
+        std::atomic<uint32_t> arg0 {0};
+        std::atomic<uint32_t> arg1 {0};
+    };
+
+    // Transaction state of one display. A lane is taken for good by the first transaction of its display, the
+    // displays beyond MAX_LANES share the overflow lane as all of them shared one state before.
+    struct Lane {
+        std::atomic<uint64_t> key {0};  // Display id + 1 once taken
+        std::atomic<uint32_t> transactionId {0};
+        std::atomic<uint32_t> recordedOnce {0};  // Bit per event recorded by RecordOnce in the transaction
+    };
+
+    DisplayTraceRecorder() = default;
+
+    Lane& GetLane(uint32_t displayId, bool isTaken)
+    {
+        uint64_t key = static_cast<uint64_t>(displayId) + 1;
+        for (Lane& lane : lanes_) {
+            uint64_t laneKey = lane.key.load(std::memory_order_acquire);
+            // Lanes are taken in order, the first free one ends the search. A failed exchange leaves the key of
+            // the display that took the lane meanwhile in laneKey.
+            if (laneKey == 0 && (!isTaken || lane.key.compare_exchange_strong(laneKey, key))) {
+                return isTaken ? lane : overflowLane_;
+            }
+            if (laneKey == key) {
+                return lane;
+            }
+        }
+        return overflowLane_;
+    }
+
+    static uint64_t GetNowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void Write(uint32_t transactionId, uint32_t displayId, DisplayTraceEvent event, uint32_t arg0, uint32_t arg1)
+    {
+        uint64_t timeNs = GetNowNs();
+        uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots_[index & (CAPACITY - 1)];
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        // The slot is being written, or a writer that took a later index was faster
+        if ((sequence & 1U) != 0 || sequence > index * 2 ||
+            !slot.sequence.compare_exchange_strong(sequence, index * 2 + 1, std::memory_order_relaxed)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.timeNs.store(timeNs, std::memory_order_relaxed);
+        slot.transactionId.store(transactionId, std::memory_order_relaxed);
+        slot.displayId.store(displayId, std::memory_order_relaxed);
+        slot.event.store(static_cast<uint32_t>(event), std::memory_order_relaxed);
+        slot.arg0.store(arg0, std::memory_order_relaxed);
+        slot.arg1.store(arg1, std::memory_order_relaxed);
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+    }
+
+    bool ReadSlot(uint64_t index, DisplayTraceRecord& record) const
+    {
+        const Slot& slot = slots_[index & (CAPACITY - 1)];
+        uint64_t expected = index * 2 + 2;
+        if (slot.sequence.load(std::memory_order_acquire) != expected) {
+            return false;
+        }
+        record.timeNs = slot.timeNs.load(std::memory_order_relaxed);
+        record.sequence = static_cast<uint32_t>(index);
+        record.transactionId = slot.transactionId.load(std::memory_order_relaxed);
+        record.displayId = slot.displayId.load(std::memory_order_relaxed);
+        record.event = static_cast<uint16_t>(slot.event.load(std::memory_order_relaxed));
+        record.arg0 = slot.arg0.load(std::memory_order_relaxed);
+        record.arg1 = slot.arg1.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == expected;
+    }
+
+    std::array<Slot, CAPACITY> slots_;
+    std::atomic<uint64_t> head_ {0};
+    std::atomic<uint64_t> dropped_ {0};
+    std::atomic<uint32_t> nextTransaction_ {0};
+    std::array<Lane, MAX_LANES> lanes_;
+    Lane overflowLane_;
+};
+} // namespace DisplayPowerMgr
+} // namespace OHOS
+#endif // DISPLAY_TRACE_RECORDER_H